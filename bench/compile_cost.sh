@@ -0,0 +1,65 @@
+#!/bin/bash
+# Compile-time benchmark for dimension arithmetic. Generates a corpus of functions, each a chain
+# of products and quotients of random quantities, and reports
+#   - the time to compile it, with and without code generation,
+#   - the number of distinct template specializations in its debug info, which counts the
+#     dimension and quantity types the chains instantiated, and
+#   - the size of its debug info.
+# Usage: bench/compile_cost.sh [functions=2000] [terms per chain=6]
+# Run from the repository root. CXX defaults to g++.
+
+CXX=${CXX:-g++}
+functions=${1:-2000}
+terms=${2:-6}
+cd "$(dirname "$0")/.."
+work=$(mktemp -d)
+trap 'rm -rf "${work}"' EXIT
+
+# A fixed seed keeps the corpus identical between runs and commits.
+RANDOM=1
+units=(uniTypes::kilogram uniTypes::meter uniTypes::meter2 uniTypes::liter uniTypes::second
+       uniTypes::newton uniTypes::joule)
+corpus="${work}/corpus.cpp"
+{
+  echo "#include <uniTypes.h>"
+  # Dividing by a quantity of the same dimension gives a plain number.
+  echo "template<typename Q> double valueOf(Q quantity) { return quantity.getValue(); }"
+  echo "inline double valueOf(double value) { return value; }"
+  for (( f = 0; f < functions; ++f ))
+  do
+    expression="(${f}.5 * ${units[RANDOM % ${#units[@]}]})"
+    for (( t = 1; t < terms; ++t ))
+    do
+      if (( RANDOM % 2 ))
+      then
+        expression="${expression} * ${units[RANDOM % ${#units[@]}]}"
+      else
+        expression="${expression} / ${units[RANDOM % ${#units[@]}]}"
+      fi
+    done
+    echo "double chain${f}() { return valueOf(${expression}); }"
+  done
+} > "${corpus}"
+
+# Front end only (parsing, overload resolution and template instantiation), then a full debug
+# build.
+start=$(date +%s%N)
+if ! ${CXX} -std=c++17 -fsyntax-only -Iinclude "${corpus}"; then
+  echo "Failed to compile the corpus"
+  exit 1
+fi
+middle=$(date +%s%N)
+${CXX} -std=c++17 -O0 -g -Iinclude -c "${corpus}" -o "${work}/corpus.o" || exit 1
+end=$(date +%s%N)
+
+# Names of the specializations, without the string table offsets readelf prints before them.
+readelf --debug-dump=info "${work}/corpus.o" 2>/dev/null |
+  grep -o 'DW_AT_name *: .*<.*' | sed 's/.*: //' | sort -u > "${work}/names.txt"
+debug_info=$(readelf -S -W "${work}/corpus.o" | awk '$2 == ".debug_info" { print $6 }')
+
+echo "Corpus: ${functions} chains of ${terms} quantities"
+printf "  %-34s %d\n" "Front end (-fsyntax-only, ms)" $(( (middle - start) / 1000000 ))
+printf "  %-34s %d\n" "Debug build (-O0 -g, ms)" $(( (end - middle) / 1000000 ))
+printf "  %-34s %d\n" "Template specializations" "$(wc -l < "${work}/names.txt")"
+printf "  %-34s %d\n" "  of which quantity types" "$(grep -c '^RatioQuantity<' "${work}/names.txt")"
+printf "  %-34s %d\n" "Debug info (bytes)" "$(printf "%d" "0x${debug_info}")"
@@ -0,0 +1,46 @@
+#include <uniTypes/atomicQuantity.h>
+#include "benchmark/benchmark.h"
+
+#include <mutex>
+
+// Every thread adds to one shared Energy total: behind a mutex, through an AtomicQuantity, and
+// through a ShardedAccumulator. The mutex and the single atomic serialize on one cache line as
+// threads are added; the sharded total should scale with the thread count.
+
+static void BM_AccumulateMutex(benchmark::State& state) {
+  static std::mutex mutex;
+  static uniTypes::Energy total;
+  for (auto _ : state) {
+    std::lock_guard<std::mutex> lock(mutex);
+    total += uniTypes::joule;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AccumulateMutex)->ThreadRange(1, 16)->UseRealTime();
+
+static void BM_AccumulateAtomic(benchmark::State& state) {
+  static uniTypes::AtomicQuantity<uniTypes::Energy> total;
+  for (auto _ : state) {
+    total.fetch_add(uniTypes::joule, std::memory_order_relaxed);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AccumulateAtomic)->ThreadRange(1, 16)->UseRealTime();
+
+static void BM_AccumulateSharded(benchmark::State& state) {
+  static uniTypes::ShardedAccumulator<uniTypes::Energy> total(16);
+  for (auto _ : state) {
+    total.add(uniTypes::joule);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AccumulateSharded)->ThreadRange(1, 16)->UseRealTime();
+
+static void BM_AccumulateShardedTotal(benchmark::State& state) {
+  static uniTypes::ShardedAccumulator<uniTypes::Energy> total(16);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(total.total());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AccumulateShardedTotal);
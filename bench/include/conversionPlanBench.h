@@ -0,0 +1,65 @@
+#include <uniTypes/conversionPlan.h>
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Cost of one (value, from, to) conversion request: the map lookups and division the caller has
+// to write by hand today, a shared cached plan, and a plan that was compiled up front.
+
+static const std::vector<std::string>& conversionBenchUnits() {
+  static const std::vector<std::string> units{"lb", "kg", "oz", "g", "ton", "mg", "pound", "gram"};
+  return units;
+}
+
+static void BM_ConversionMapLookup(benchmark::State& state) {
+  const std::vector<std::string>& units = conversionBenchUnits();
+  const std::size_t n = units.size();
+  double total = 0.0;
+  std::size_t i = 0;
+  for (auto _ : state) {
+    const uniTypes::Mass from = uniTypes::string_to_mass_unit.at(units[i % n]);
+    const uniTypes::Mass to = uniTypes::string_to_mass_unit.at(units[(i + 3) % n]);
+    total += (2.5 * from).convertTo(to);
+    ++i;
+  }
+  benchmark::DoNotOptimize(total);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ConversionMapLookup);
+
+static void BM_ConversionCachedPlan(benchmark::State& state) {
+  const std::vector<std::string>& units = conversionBenchUnits();
+  const std::size_t n = units.size();
+  uniTypes::ConversionPlanCache& cache = uniTypes::sharedPlanCache();
+  double total = 0.0;
+  std::size_t i = 0;
+  for (auto _ : state) {
+    total += cache.get(units[i % n], units[(i + 3) % n])(2.5);
+    ++i;
+  }
+  benchmark::DoNotOptimize(total);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ConversionCachedPlan)->ThreadRange(1, 4)->UseRealTime();
+
+static void BM_ConversionCompiledPlan(benchmark::State& state) {
+  const uniTypes::ConversionPlan plan = uniTypes::ConversionPlan::compile("lb", "kg");
+  double value = 2.5;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(value = plan(value));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ConversionCompiledPlan);
+
+static void BM_ConversionRawMultiply(benchmark::State& state) {
+  const double factor = 0.45359237;
+  double value = 2.5;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(value = value * factor);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ConversionRawMultiply);
@@ -0,0 +1,46 @@
+#include <uniTypes/convert.h>
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <vector>
+
+// Converting a column from pounds to kilograms one element at a time versus in bulk.
+
+static void BM_PerElementConvertTo(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  std::vector<uniTypes::Mass> in(n, uniTypes::pound);
+  std::vector<double> out(n);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < n; ++i) {
+      out[i] = in[i].convertTo(uniTypes::kilogram);
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_PerElementConvertTo)->Range(1 << 10, 1 << 24);
+
+static void BM_BatchConvert(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  std::vector<double> in(n, 1.0), out(n);
+  for (auto _ : state) {
+    uniTypes::convert(in.data(), n, uniTypes::pound, uniTypes::kilogram, out.data());
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_BatchConvert)->Range(1 << 10, 1 << 24);
+
+static void BM_BatchConvertAllCores(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  std::vector<double> in(n, 1.0), out(n);
+  for (auto _ : state) {
+    uniTypes::convert(in.data(), n, uniTypes::pound, uniTypes::kilogram, out.data(), 0);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_BatchConvertAllCores)->Range(1 << 10, 1 << 24)->UseRealTime();
@@ -0,0 +1,229 @@
+#include <uniTypes.h>
+#include <uniTypes/dynQuantity.h>
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+// The scalar building blocks of uniTypes, each paired with the same work on raw doubles. Every
+// benchmark applies its operation to kCoreOpsSize elements per iteration so that the loop, not
+// the timer, dominates; a BM_CoreQuantity* result should match its BM_CoreRaw* baseline.
+
+constexpr std::size_t kCoreOpsSize = 1024;
+
+template<typename T>
+std::vector<T> coreOpsInput(double first) {
+  std::vector<T> values;
+  values.reserve(kCoreOpsSize);
+  for (std::size_t i = 0; i < kCoreOpsSize; ++i) {
+    values.push_back(T(first + 0.001 * static_cast<double>(i)));
+  }
+  return values;
+}
+
+// out[i] = op(lhs[i], rhs[i]) over kCoreOpsSize elements.
+template<typename Lhs, typename Rhs, typename Op>
+void runCoreBinary(benchmark::State& state, Op op) {
+  const std::vector<Lhs> lhs = coreOpsInput<Lhs>(1.5);
+  const std::vector<Rhs> rhs = coreOpsInput<Rhs>(2.5);
+  std::vector<decltype(op(lhs[0], rhs[0]))> out(kCoreOpsSize);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < kCoreOpsSize; ++i) {
+      out[i] = op(lhs[i], rhs[i]);
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * kCoreOpsSize);
+}
+
+// Counts the elements for which pred(lhs[i], rhs[i]) holds.
+template<typename T, typename Pred>
+void runCoreCompare(benchmark::State& state, Pred pred) {
+  const std::vector<T> lhs = coreOpsInput<T>(1.5);
+  const std::vector<T> rhs = coreOpsInput<T>(1.5 + 0.001 * kCoreOpsSize / 2);
+  for (auto _ : state) {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < kCoreOpsSize; ++i) {
+      count += pred(lhs[i], rhs[kCoreOpsSize - 1 - i]) ? 1 : 0;
+    }
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetItemsProcessed(state.iterations() * kCoreOpsSize);
+}
+
+// ------------------------------------------
+// Literal construction
+// ------------------------------------------
+static void BM_CoreRawLiteral(benchmark::State& state) {
+  runCoreBinary<double, double>(state, [](double x, double) { return x * 0.45359237; });
+}
+BENCHMARK(BM_CoreRawLiteral);
+
+static void BM_CoreQuantityLiteral(benchmark::State& state) {
+  runCoreBinary<double, double>(state, [](double x, double) {
+    return uniTypes::string_literals::operator""_lb(static_cast<long double>(x));
+  });
+}
+BENCHMARK(BM_CoreQuantityLiteral);
+
+// ------------------------------------------
+// Arithmetic operators
+// ------------------------------------------
+static void BM_CoreRawAdd(benchmark::State& state) {
+  runCoreBinary<double, double>(state, [](double a, double b) { return a + b; });
+}
+BENCHMARK(BM_CoreRawAdd);
+
+static void BM_CoreQuantityAdd(benchmark::State& state) {
+  using uniTypes::Mass;
+  runCoreBinary<Mass, Mass>(state, [](Mass a, Mass b) { return a + b; });
+}
+BENCHMARK(BM_CoreQuantityAdd);
+
+static void BM_CoreRawSubtract(benchmark::State& state) {
+  runCoreBinary<double, double>(state, [](double a, double b) { return a - b; });
+}
+BENCHMARK(BM_CoreRawSubtract);
+
+static void BM_CoreQuantitySubtract(benchmark::State& state) {
+  using uniTypes::Mass;
+  runCoreBinary<Mass, Mass>(state, [](Mass a, Mass b) { return a - b; });
+}
+BENCHMARK(BM_CoreQuantitySubtract);
+
+static void BM_CoreRawMultiply(benchmark::State& state) {
+  runCoreBinary<double, double>(state, [](double a, double b) { return a * b; });
+}
+BENCHMARK(BM_CoreRawMultiply);
+
+static void BM_CoreQuantityMultiply(benchmark::State& state) {
+  using uniTypes::Force;
+  using uniTypes::Length;
+  runCoreBinary<Force, Length>(state, [](Force a, Length b) { return a * b; });
+}
+BENCHMARK(BM_CoreQuantityMultiply);
+
+static void BM_CoreRawDivide(benchmark::State& state) {
+  runCoreBinary<double, double>(state, [](double a, double b) { return a / b; });
+}
+BENCHMARK(BM_CoreRawDivide);
+
+static void BM_CoreQuantityDivide(benchmark::State& state) {
+  using uniTypes::Length;
+  using uniTypes::Time;
+  runCoreBinary<Length, Time>(state, [](Length a, Time b) { return a / b; });
+}
+BENCHMARK(BM_CoreQuantityDivide);
+
+static void BM_CoreRawScalarMultiply(benchmark::State& state) {
+  runCoreBinary<double, double>(state, [](double a, double b) { return b * a; });
+}
+BENCHMARK(BM_CoreRawScalarMultiply);
+
+static void BM_CoreQuantityScalarMultiply(benchmark::State& state) {
+  using uniTypes::Mass;
+  runCoreBinary<Mass, double>(state, [](Mass a, double b) { return b * a; });
+}
+BENCHMARK(BM_CoreQuantityScalarMultiply);
+
+// ------------------------------------------
+// convertTo
+// ------------------------------------------
+static void BM_CoreRawConvertTo(benchmark::State& state) {
+  runCoreBinary<double, double>(state, [](double a, double) { return a / 0.45359237; });
+}
+BENCHMARK(BM_CoreRawConvertTo);
+
+static void BM_CoreQuantityConvertTo(benchmark::State& state) {
+  using uniTypes::Mass;
+  runCoreBinary<Mass, double>(state, [](Mass a, double) { return a.convertTo(uniTypes::pound); });
+}
+BENCHMARK(BM_CoreQuantityConvertTo);
+
+// ------------------------------------------
+// createRatio
+// ------------------------------------------
+// A runtime-typed quantity carries its dimension alongside the value, so the baseline is a raw
+// {value, tag} pair.
+struct RawTagged {
+  double value;
+  int tag;
+};
+
+static void BM_CoreRawCreateRatio(benchmark::State& state) {
+  runCoreBinary<double, double>(state, [](double a, double) { return RawTagged{a, 3}; });
+}
+BENCHMARK(BM_CoreRawCreateRatio);
+
+static void BM_CoreQuantityCreateRatio(benchmark::State& state) {
+  runCoreBinary<double, double>(state, [](double a, double) {
+    return uniTypes::DynQuantity::createRatio(uniTypes::QuantityKind::Mass, a);
+  });
+}
+BENCHMARK(BM_CoreQuantityCreateRatio);
+
+// ------------------------------------------
+// Unit-map lookups
+// ------------------------------------------
+static const std::vector<std::string>& coreOpsUnitNames() {
+  static const std::vector<std::string> names{"kg", "gram", "mg", "ton", "oz", "pound", "lb", "g"};
+  return names;
+}
+
+static void BM_CoreRawUnitMapLookup(benchmark::State& state) {
+  std::map<std::string, double> factors;
+  for (const auto& entry : uniTypes::string_to_mass_unit) {
+    factors.emplace(entry.first, entry.second.getValue());
+  }
+  const std::vector<std::string>& names = coreOpsUnitNames();
+  for (auto _ : state) {
+    double total = 0.0;
+    for (const std::string& name : names) {
+      total += factors.at(name);
+    }
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * names.size());
+}
+BENCHMARK(BM_CoreRawUnitMapLookup);
+
+static void BM_CoreQuantityUnitMapLookup(benchmark::State& state) {
+  const std::vector<std::string>& names = coreOpsUnitNames();
+  for (auto _ : state) {
+    uniTypes::Mass total;
+    for (const std::string& name : names) {
+      total += uniTypes::string_to_mass_unit.at(name);
+    }
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * names.size());
+}
+BENCHMARK(BM_CoreQuantityUnitMapLookup);
+
+// ------------------------------------------
+// Comparisons
+// ------------------------------------------
+static void BM_CoreRawLess(benchmark::State& state) {
+  runCoreCompare<double>(state, [](double a, double b) { return a < b; });
+}
+BENCHMARK(BM_CoreRawLess);
+
+static void BM_CoreQuantityLess(benchmark::State& state) {
+  using uniTypes::Mass;
+  runCoreCompare<Mass>(state, [](Mass a, Mass b) { return a < b; });
+}
+BENCHMARK(BM_CoreQuantityLess);
+
+static void BM_CoreRawEqual(benchmark::State& state) {
+  runCoreCompare<double>(state, [](double a, double b) { return a == b; });
+}
+BENCHMARK(BM_CoreRawEqual);
+
+static void BM_CoreQuantityEqual(benchmark::State& state) {
+  using uniTypes::Mass;
+  runCoreCompare<Mass>(state, [](Mass a, Mass b) { return a == b; });
+}
+BENCHMARK(BM_CoreQuantityEqual);
@@ -0,0 +1,125 @@
+#include <uniTypes/density.h>
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Recipe lines such as "1.5 cup flour" as (ingredient id, volume) columns, converted to mass
+// with a DensityTable versus per-row lookups in a std::unordered_map and in a sorted vector.
+// Rows are Zipf-distributed over 2000 ingredients, so popular ingredients repeat as in real
+// recipe data. The first argument picks the ids: 0 for consecutive database keys, 1 for sparse
+// 48-bit ids.
+
+static constexpr std::size_t kDensityBenchIngredients = 2000;
+static constexpr std::size_t kDensityBenchRows = 1 << 22;
+
+static std::uint64_t densityBenchId(std::size_t ingredient, bool sparse) {
+  if (!sparse) {
+    return 100000 + static_cast<std::uint64_t>(ingredient);
+  }
+  std::uint64_t x = static_cast<std::uint64_t>(ingredient) * 0x9e3779b97f4a7c15ull;
+  x ^= x >> 29;
+  return (x * 0xbf58476d1ce4e5b9ull) >> 16;
+}
+
+static double densityBenchDensity(std::size_t ingredient) {
+  return 300.0 + static_cast<double>(ingredient % 1500);
+}
+
+struct DensityBenchRows {
+  std::vector<std::uint64_t> ids[2];
+  uniTypes::QuantityVector<uniTypes::Volume> volumes;
+};
+
+static const DensityBenchRows& densityBenchRows() {
+  static const DensityBenchRows rows = [] {
+    std::vector<double> weights;
+    for (std::size_t i = 0; i < kDensityBenchIngredients; ++i) {
+      weights.push_back(1.0 / static_cast<double>(i + 1));
+    }
+    std::mt19937 generator(23);
+    std::discrete_distribution<std::size_t> ingredient(weights.begin(), weights.end());
+    std::uniform_real_distribution<double> cups(0.25, 3.0);
+    DensityBenchRows out;
+    for (std::size_t i = 0; i < kDensityBenchRows; ++i) {
+      const std::size_t k = ingredient(generator);
+      out.ids[0].push_back(densityBenchId(k, false));
+      out.ids[1].push_back(densityBenchId(k, true));
+      out.volumes.push_back(cups(generator) * uniTypes::cup);
+    }
+    return out;
+  }();
+  return rows;
+}
+
+static uniTypes::DensityTable densityBenchTable(bool sparse) {
+  uniTypes::DensityTable table;
+  for (std::size_t i = 0; i < kDensityBenchIngredients; ++i) {
+    table.set(densityBenchId(i, sparse), uniTypes::Density(densityBenchDensity(i)));
+  }
+  return table;
+}
+
+static void BM_DensityTableMultiply(benchmark::State& state) {
+  const DensityBenchRows& rows = densityBenchRows();
+  const bool sparse = state.range(0) != 0;
+  const std::vector<std::uint64_t>& ids = rows.ids[sparse];
+  const uniTypes::DensityTable table = densityBenchTable(sparse);
+  uniTypes::QuantityVector<uniTypes::Mass> masses(rows.volumes.size());
+  for (auto _ : state) {
+    table.multiply(ids.data(), rows.volumes, masses, static_cast<unsigned>(state.range(1)));
+    benchmark::DoNotOptimize(masses.data());
+  }
+  state.SetItemsProcessed(state.iterations() * rows.volumes.size());
+}
+BENCHMARK(BM_DensityTableMultiply)->ArgsProduct({{0, 1}, {1, 0}})->UseRealTime();
+
+static void BM_DensityUnorderedMap(benchmark::State& state) {
+  const DensityBenchRows& rows = densityBenchRows();
+  const bool sparse = state.range(0) != 0;
+  const std::vector<std::uint64_t>& ids = rows.ids[sparse];
+  std::unordered_map<std::uint64_t, double> table;
+  for (std::size_t i = 0; i < kDensityBenchIngredients; ++i) {
+    table[densityBenchId(i, sparse)] = densityBenchDensity(i);
+  }
+  std::vector<double> masses(rows.volumes.size());
+  const double* volumes = rows.volumes.data();
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < masses.size(); ++i) {
+      masses[i] = volumes[i] * table.at(ids[i]);
+    }
+    benchmark::DoNotOptimize(masses.data());
+  }
+  state.SetItemsProcessed(state.iterations() * rows.volumes.size());
+}
+BENCHMARK(BM_DensityUnorderedMap)->Arg(0)->Arg(1);
+
+static void BM_DensitySortedVector(benchmark::State& state) {
+  const DensityBenchRows& rows = densityBenchRows();
+  const bool sparse = state.range(0) != 0;
+  const std::vector<std::uint64_t>& ids = rows.ids[sparse];
+  std::vector<std::pair<std::uint64_t, double>> table;
+  for (std::size_t i = 0; i < kDensityBenchIngredients; ++i) {
+    table.emplace_back(densityBenchId(i, sparse), densityBenchDensity(i));
+  }
+  std::sort(table.begin(), table.end());
+  std::vector<double> masses(rows.volumes.size());
+  const double* volumes = rows.volumes.data();
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < masses.size(); ++i) {
+      const auto entry = std::lower_bound(
+        table.begin(), table.end(), ids[i],
+        [](const std::pair<std::uint64_t, double>& e, std::uint64_t id) { return e.first < id; });
+      masses[i] = volumes[i] * entry->second;
+    }
+    benchmark::DoNotOptimize(masses.data());
+  }
+  state.SetItemsProcessed(state.iterations() * rows.volumes.size());
+}
+BENCHMARK(BM_DensitySortedVector)->Arg(0)->Arg(1);
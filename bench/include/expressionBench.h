@@ -0,0 +1,65 @@
+#include <uniTypes/expression.h>
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <vector>
+
+// gross = density * volume + tare over whole columns, computed eagerly with a full-size temporary
+// per operator, fused through an expression, and with a hand-written loop over raw doubles.
+// "bytes_per_element" is the memory traffic each variant needs: the eager version writes and
+// re-reads the density * volume temporary, the fused one only reads the three inputs and writes
+// the output.
+
+using BenchDensity = uniTypes::quantity_quotient_t<uniTypes::Mass, uniTypes::Volume>;
+
+static void BM_ExpressionEager(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  uniTypes::QuantityVector<BenchDensity> density(n, BenchDensity(997.0));
+  uniTypes::QuantityVector<uniTypes::Volume> volume(n, uniTypes::liter);
+  uniTypes::QuantityVector<uniTypes::Mass> tare(n, uniTypes::gram);
+  uniTypes::QuantityVector<uniTypes::Mass> gross(n);
+  for (auto _ : state) {
+    uniTypes::QuantityVector<uniTypes::Mass> net(n);
+    uniTypes::multiply(density, volume, net);
+    uniTypes::add(net, tare, gross);
+    benchmark::DoNotOptimize(gross.data());
+    benchmark::ClobberMemory();
+  }
+  const std::size_t bytes_per_element = 6 * sizeof(double);
+  state.counters["bytes_per_element"] = static_cast<double>(bytes_per_element);
+  state.SetBytesProcessed(state.iterations() * n * bytes_per_element);
+}
+BENCHMARK(BM_ExpressionEager)->Range(1 << 10, 1 << 22);
+
+static void BM_ExpressionFused(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  uniTypes::QuantityVector<BenchDensity> density(n, BenchDensity(997.0));
+  uniTypes::QuantityVector<uniTypes::Volume> volume(n, uniTypes::liter);
+  uniTypes::QuantityVector<uniTypes::Mass> tare(n, uniTypes::gram);
+  uniTypes::QuantityVector<uniTypes::Mass> gross(n);
+  for (auto _ : state) {
+    gross = density * volume + tare;
+    benchmark::DoNotOptimize(gross.data());
+    benchmark::ClobberMemory();
+  }
+  const std::size_t bytes_per_element = 4 * sizeof(double);
+  state.counters["bytes_per_element"] = static_cast<double>(bytes_per_element);
+  state.SetBytesProcessed(state.iterations() * n * bytes_per_element);
+}
+BENCHMARK(BM_ExpressionFused)->Range(1 << 10, 1 << 22);
+
+static void BM_ExpressionRawLoop(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  std::vector<double> density(n, 997.0), volume(n, 0.001), tare(n, 0.001), gross(n);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < n; ++i) {
+      gross[i] = density[i] * volume[i] + tare[i];
+    }
+    benchmark::DoNotOptimize(gross.data());
+    benchmark::ClobberMemory();
+  }
+  const std::size_t bytes_per_element = 4 * sizeof(double);
+  state.counters["bytes_per_element"] = static_cast<double>(bytes_per_element);
+  state.SetBytesProcessed(state.iterations() * n * bytes_per_element);
+}
+BENCHMARK(BM_ExpressionRawLoop)->Range(1 << 10, 1 << 22);
@@ -0,0 +1,60 @@
+#include <uniTypes/format.h>
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <sstream>
+#include <vector>
+
+// Writing a column of masses as text with the to_chars formatter versus an std::ostringstream
+// printing the value in kilograms.
+
+static uniTypes::QuantityVector<uniTypes::Mass> formatBenchMasses(std::size_t n) {
+  uniTypes::QuantityVector<uniTypes::Mass> masses(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    masses[i] = static_cast<double>(i % 997) * 0.125 * uniTypes::pound;
+  }
+  return masses;
+}
+
+static void BM_FormatQuantityBestUnit(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const auto masses = formatBenchMasses(n);
+  std::vector<char> buffer(n * 32);
+  for (auto _ : state) {
+    char* out = buffer.data();
+    char* last = buffer.data() + buffer.size();
+    for (std::size_t i = 0; i < n; ++i) {
+      out = uniTypes::formatQuantity(out, last, masses[i]).ptr;
+      *out++ = '\n';
+    }
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_FormatQuantityBestUnit)->Range(1 << 10, 1 << 16);
+
+static void BM_FormatColumn(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const auto masses = formatBenchMasses(n);
+  std::vector<char> buffer(n * 32);
+  for (auto _ : state) {
+    auto result = uniTypes::formatColumn(buffer.data(), buffer.data() + buffer.size(), masses);
+    benchmark::DoNotOptimize(result.ptr);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_FormatColumn)->Range(1 << 10, 1 << 16);
+
+static void BM_FormatOstream(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const auto masses = formatBenchMasses(n);
+  for (auto _ : state) {
+    std::ostringstream os;
+    for (std::size_t i = 0; i < n; ++i) {
+      os << masses[i].getValue() << " kg\n";
+    }
+    benchmark::DoNotOptimize(os.str().data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_FormatOstream)->Range(1 << 10, 1 << 16);
@@ -0,0 +1,38 @@
+#include <uniTypes/ingest.h>
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <string>
+
+// Ingestion throughput of a generated three-column CSV, single-threaded versus all cores.
+
+static const std::string& ingestBenchCsv() {
+  static const std::string csv = [] {
+    const char* masses[4] = {"250 g", "0.5 lb", "1.25 kg", "12 oz"};
+    const char* volumes[4] = {"1.5 cup", "2 tbsp", "500 ml", "1 qt"};
+    std::string text = "ingredient,mass,volume\n";
+    for (std::size_t i = 0; i < (std::size_t(1) << 20); ++i) {
+      text += "item";
+      text += std::to_string(i & 1023);
+      text += ',';
+      text += masses[i & 3];
+      text += ',';
+      text += volumes[(i >> 2) & 3];
+      text += '\n';
+    }
+    return text;
+  }();
+  return csv;
+}
+
+static void BM_IngestText(benchmark::State& state) {
+  const std::string& csv = ingestBenchCsv();
+  uniTypes::IngestOptions options;
+  options.threads = static_cast<unsigned>(state.range(0));
+  for (auto _ : state) {
+    uniTypes::IngestResult result = uniTypes::ingestText(csv, options);
+    benchmark::DoNotOptimize(result.columns.data());
+  }
+  state.SetBytesProcessed(state.iterations() * csv.size());
+}
+BENCHMARK(BM_IngestText)->Arg(1)->Arg(0)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,59 @@
+#include <uniTypes/instrument.h>
+#include "benchmark/benchmark.h"
+
+#include <chrono>
+#include <cstddef>
+
+// Cost of one instrumentation sample, including its share of draining the ring into the
+// histogram: each benchmark drains every half ring, so no sample is dropped. BM_InstrumentRecord
+// should stay within a few nanoseconds; BM_InstrumentSteadyClock, the two clock reads a
+// ScopedTimer needs, is the floor for BM_InstrumentScopedTimer.
+
+namespace {
+  constexpr std::size_t kInstrumentBenchDrainEvery = uniTypes::kInstrumentRingSize / 2;
+}
+
+static void BM_InstrumentSteadyClock(benchmark::State& state) {
+  for (auto _ : state) {
+    const auto start = std::chrono::steady_clock::now();
+    benchmark::DoNotOptimize(std::chrono::steady_clock::now() - start);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_InstrumentSteadyClock);
+
+static void BM_InstrumentRecord(benchmark::State& state) {
+  uniTypes::Instrumentation instrumentation;
+  const auto metric = instrumentation.metric<uniTypes::Energy>("bench.energy");
+  uniTypes::Energy sample = uniTypes::joule;
+  std::size_t pending = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(sample);
+    metric.record(sample);
+    if (++pending == kInstrumentBenchDrainEvery) {
+      instrumentation.drain();
+      pending = 0;
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.counters["dropped"] = static_cast<double>(instrumentation.dropped());
+}
+BENCHMARK(BM_InstrumentRecord);
+
+static void BM_InstrumentScopedTimer(benchmark::State& state) {
+  uniTypes::Instrumentation instrumentation;
+  const auto metric = instrumentation.metric<uniTypes::Time>("bench.scope");
+  std::size_t pending = 0;
+  for (auto _ : state) {
+    {
+      uniTypes::ScopedTimer timer(metric);
+    }
+    if (++pending == kInstrumentBenchDrainEvery) {
+      instrumentation.drain();
+      pending = 0;
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.counters["dropped"] = static_cast<double>(instrumentation.dropped());
+}
+BENCHMARK(BM_InstrumentScopedTimer);
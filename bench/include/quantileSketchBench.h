@@ -0,0 +1,141 @@
+#include <uniTypes/quantileSketch.h>
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+// p50/p99/p99.9 of a stream of latencies: a QuantileSketch<Time> filled one value at a time or
+// from spans, against keeping the raw values and selecting the exact quantiles. The accuracy
+// benchmark reports the worst relative error of the sketch as a counter.
+
+static const uniTypes::QuantityVector<uniTypes::Time>& sketchBenchLatencies() {
+  static const uniTypes::QuantityVector<uniTypes::Time> values = [] {
+    std::mt19937 generator(3);
+    std::lognormal_distribution<double> latency(std::log(2e-3), 1.0);
+    uniTypes::QuantityVector<uniTypes::Time> out;
+    for (std::size_t i = 0; i < (1 << 22); ++i) {
+      out.push_back(uniTypes::Time(latency(generator)));
+    }
+    return out;
+  }();
+  return values;
+}
+
+static constexpr double kSketchBenchQuantiles[] = {0.5, 0.99, 0.999};
+
+static void BM_QuantileSketchAdd(benchmark::State& state) {
+  const auto values = sketchBenchLatencies().span().subspan(0, state.range(0));
+  for (auto _ : state) {
+    uniTypes::QuantileSketch<uniTypes::Time> sketch;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      sketch.add(values[i]);
+    }
+    for (double q : kSketchBenchQuantiles) {
+      benchmark::DoNotOptimize(sketch.quantile(q));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_QuantileSketchAdd)->Arg(1 << 12)->Arg(1 << 16)->Arg(1 << 22);
+
+static void BM_QuantileSketchAddSpan(benchmark::State& state) {
+  const auto values = sketchBenchLatencies().span().subspan(0, state.range(0));
+  for (auto _ : state) {
+    uniTypes::QuantileSketch<uniTypes::Time> sketch;
+    sketch.add(values);
+    for (double q : kSketchBenchQuantiles) {
+      benchmark::DoNotOptimize(sketch.quantile(q));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_QuantileSketchAddSpan)->Arg(1 << 12)->Arg(1 << 16)->Arg(1 << 22);
+
+static void BM_QuantileSketchAddSpanAllCores(benchmark::State& state) {
+  const auto values = sketchBenchLatencies().span().subspan(0, state.range(0));
+  for (auto _ : state) {
+    uniTypes::QuantileSketch<uniTypes::Time> sketch;
+    sketch.add(values, 0);
+    for (double q : kSketchBenchQuantiles) {
+      benchmark::DoNotOptimize(sketch.quantile(q));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_QuantileSketchAddSpanAllCores)->Arg(1 << 22)->UseRealTime();
+
+static void BM_ExactQuantilesSort(benchmark::State& state) {
+  const auto values = sketchBenchLatencies().span().subspan(0, state.range(0));
+  std::vector<double> copy;
+  for (auto _ : state) {
+    copy.assign(values.data(), values.data() + values.size());
+    std::sort(copy.begin(), copy.end());
+    for (double q : kSketchBenchQuantiles) {
+      benchmark::DoNotOptimize(copy[static_cast<std::size_t>(q * (copy.size() - 1))]);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ExactQuantilesSort)->Arg(1 << 12)->Arg(1 << 16)->Arg(1 << 22);
+
+static void BM_ExactQuantilesSelect(benchmark::State& state) {
+  const auto values = sketchBenchLatencies().span().subspan(0, state.range(0));
+  std::vector<double> copy;
+  for (auto _ : state) {
+    copy.assign(values.data(), values.data() + values.size());
+    for (double q : kSketchBenchQuantiles) {
+      const auto rank = copy.begin() + static_cast<std::ptrdiff_t>(q * (copy.size() - 1));
+      std::nth_element(copy.begin(), rank, copy.end());
+      benchmark::DoNotOptimize(*rank);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ExactQuantilesSelect)->Arg(1 << 12)->Arg(1 << 16)->Arg(1 << 22);
+
+static void BM_QuantileSketchMerge(benchmark::State& state) {
+  const auto values = sketchBenchLatencies().span();
+  uniTypes::QuantileSketch<uniTypes::Time> partial;
+  partial.add(values);
+  for (auto _ : state) {
+    uniTypes::QuantileSketch<uniTypes::Time> total;
+    total.merge(partial);
+    benchmark::DoNotOptimize(total.count());
+  }
+}
+BENCHMARK(BM_QuantileSketchMerge);
+
+static void BM_QuantileSketchSnapshotRoundTrip(benchmark::State& state) {
+  uniTypes::QuantileSketch<uniTypes::Time> sketch;
+  sketch.add(sketchBenchLatencies().span());
+  for (auto _ : state) {
+    const std::string bytes = sketch.serialize();
+    benchmark::DoNotOptimize(uniTypes::QuantileSketch<uniTypes::Time>::deserialize(bytes).count());
+  }
+  state.counters["bytes"] = static_cast<double>(sketch.serializedSize());
+}
+BENCHMARK(BM_QuantileSketchSnapshotRoundTrip);
+
+// Worst relative error over p50, p99 and p99.9, for the accuracy given as a percentage.
+static void BM_QuantileSketchAccuracy(benchmark::State& state) {
+  const auto values = sketchBenchLatencies().span();
+  const double accuracy = static_cast<double>(state.range(0)) / 100.0;
+  std::vector<double> sorted(values.data(), values.data() + values.size());
+  std::sort(sorted.begin(), sorted.end());
+  double worst = 0.0;
+  for (auto _ : state) {
+    uniTypes::QuantileSketch<uniTypes::Time> sketch(accuracy);
+    sketch.add(values);
+    for (double q : kSketchBenchQuantiles) {
+      const double exact = sorted[static_cast<std::size_t>(q * (sorted.size() - 1))];
+      worst = std::max(worst, std::fabs(sketch.quantile(q).getValue() - exact) / exact);
+    }
+  }
+  state.counters["max_rel_error"] = worst;
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_QuantileSketchAccuracy)->Arg(1)->Arg(5)->Unit(benchmark::kMillisecond);
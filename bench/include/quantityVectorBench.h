@@ -0,0 +1,114 @@
+#include <uniTypes/quantityVector.h>
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <vector>
+
+// Each QuantityVector kernel is paired with the equivalent hand-written loop over
+// std::vector<double>; the two should report the same throughput.
+
+static void BM_RawVectorAdd(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  std::vector<double> lhs(n, 1.5), rhs(n, 2.5), out(n);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < n; ++i) {
+      out[i] = lhs[i] + rhs[i];
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * n * 3 * sizeof(double));
+}
+BENCHMARK(BM_RawVectorAdd)->Range(1 << 10, 1 << 22);
+
+static void BM_QuantityVectorAdd(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  uniTypes::QuantityVector<uniTypes::Mass> lhs(n, 1.5), rhs(n, 2.5), out(n);
+  for (auto _ : state) {
+    uniTypes::add(lhs, rhs, out);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * n * 3 * sizeof(double));
+}
+BENCHMARK(BM_QuantityVectorAdd)->Range(1 << 10, 1 << 22);
+
+static void BM_RawVectorScale(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  std::vector<double> in(n, 1.5), out(n);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < n; ++i) {
+      out[i] = in[i] * 0.45359237;
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * n * 2 * sizeof(double));
+}
+BENCHMARK(BM_RawVectorScale)->Range(1 << 10, 1 << 22);
+
+static void BM_QuantityVectorScale(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  uniTypes::QuantityVector<uniTypes::Mass> in(n, 1.5), out(n);
+  for (auto _ : state) {
+    uniTypes::scale(in, 0.45359237, out);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * n * 2 * sizeof(double));
+}
+BENCHMARK(BM_QuantityVectorScale)->Range(1 << 10, 1 << 22);
+
+static void BM_RawVectorMultiply(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  std::vector<double> lhs(n, 1.5), rhs(n, 2.5), out(n);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < n; ++i) {
+      out[i] = lhs[i] * rhs[i];
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * n * 3 * sizeof(double));
+}
+BENCHMARK(BM_RawVectorMultiply)->Range(1 << 10, 1 << 22);
+
+static void BM_QuantityVectorMultiply(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  uniTypes::QuantityVector<uniTypes::Length> lhs(n, 1.5), rhs(n, 2.5);
+  uniTypes::QuantityVector<uniTypes::Area> out(n);
+  for (auto _ : state) {
+    uniTypes::multiply(lhs, rhs, out);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * n * 3 * sizeof(double));
+}
+BENCHMARK(BM_QuantityVectorMultiply)->Range(1 << 10, 1 << 22);
+
+static void BM_RawVectorDivide(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  std::vector<double> lhs(n, 1.5), rhs(n, 2.5), out(n);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < n; ++i) {
+      out[i] = lhs[i] / rhs[i];
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * n * 3 * sizeof(double));
+}
+BENCHMARK(BM_RawVectorDivide)->Range(1 << 10, 1 << 22);
+
+static void BM_QuantityVectorDivide(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  uniTypes::QuantityVector<uniTypes::Area> lhs(n, 1.5);
+  uniTypes::QuantityVector<uniTypes::Length> rhs(n, 2.5), out(n);
+  for (auto _ : state) {
+    uniTypes::divide(lhs, rhs, out);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * n * 3 * sizeof(double));
+}
+BENCHMARK(BM_QuantityVectorDivide)->Range(1 << 10, 1 << 22);
@@ -0,0 +1,79 @@
+#include <uniTypes/reduce.h>
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <vector>
+
+// Reductions over a column of energies: a naive loop over raw doubles as the baseline, then the
+// compensated reductions on one thread and on all cores.
+
+static uniTypes::QuantityVector<uniTypes::Energy> reduceBenchEnergies(std::size_t n) {
+  uniTypes::QuantityVector<uniTypes::Energy> energies(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    energies[i] = static_cast<double>(i % 1000) * uniTypes::kilocalorie;
+  }
+  return energies;
+}
+
+static void BM_ReduceNaiveSum(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const auto energies = reduceBenchEnergies(n);
+  for (auto _ : state) {
+    double total = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+      total += energies.data()[i];
+    }
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetBytesProcessed(state.iterations() * n * sizeof(double));
+}
+BENCHMARK(BM_ReduceNaiveSum)->Range(1 << 12, 1 << 24);
+
+static void BM_ReduceSum(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const unsigned threads = static_cast<unsigned>(state.range(1));
+  const auto energies = reduceBenchEnergies(n);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(uniTypes::sum(energies, threads));
+  }
+  state.SetBytesProcessed(state.iterations() * n * sizeof(double));
+}
+BENCHMARK(BM_ReduceSum)->Ranges({{1 << 12, 1 << 24}, {1, 1}})->UseRealTime();
+BENCHMARK(BM_ReduceSum)->Ranges({{1 << 12, 1 << 24}, {0, 0}})->UseRealTime();
+
+static void BM_ReduceVariance(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const unsigned threads = static_cast<unsigned>(state.range(1));
+  const auto energies = reduceBenchEnergies(n);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(uniTypes::variance(energies, false, threads));
+  }
+  state.SetBytesProcessed(state.iterations() * n * sizeof(double));
+}
+BENCHMARK(BM_ReduceVariance)->Ranges({{1 << 12, 1 << 24}, {1, 1}})->UseRealTime();
+BENCHMARK(BM_ReduceVariance)->Ranges({{1 << 12, 1 << 24}, {0, 0}})->UseRealTime();
+
+static void BM_ReduceMinMax(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const unsigned threads = static_cast<unsigned>(state.range(1));
+  const auto energies = reduceBenchEnergies(n);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(uniTypes::minMax(energies, threads));
+  }
+  state.SetBytesProcessed(state.iterations() * n * sizeof(double));
+}
+BENCHMARK(BM_ReduceMinMax)->Ranges({{1 << 12, 1 << 24}, {1, 1}})->UseRealTime();
+BENCHMARK(BM_ReduceMinMax)->Ranges({{1 << 12, 1 << 24}, {0, 0}})->UseRealTime();
+
+static void BM_ReduceDot(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const unsigned threads = static_cast<unsigned>(state.range(1));
+  uniTypes::QuantityVector<uniTypes::Force> forces(n, uniTypes::newton);
+  uniTypes::QuantityVector<uniTypes::Length> distances(n, uniTypes::meter);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(uniTypes::dot(forces, distances, threads));
+  }
+  state.SetBytesProcessed(state.iterations() * n * 2 * sizeof(double));
+}
+BENCHMARK(BM_ReduceDot)->Ranges({{1 << 12, 1 << 24}, {1, 1}})->UseRealTime();
+BENCHMARK(BM_ReduceDot)->Ranges({{1 << 12, 1 << 24}, {0, 0}})->UseRealTime();
@@ -0,0 +1,58 @@
+#include <uniTypes/convert.h>
+#include <uniTypes/expression.h>
+#include <uniTypes/reduce.h>
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <vector>
+
+// The same bulk operations on float and double quantities. Float halves the bytes moved per
+// element and doubles the elements per SIMD register, so memory-bound kernels should approach
+// twice the element throughput once the data no longer fits in cache.
+
+template<typename Rep>
+static void BM_RepFusedScaleAdd(benchmark::State& state) {
+  using Q = uniTypes::with_rep_t<uniTypes::Mass, Rep>;
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  uniTypes::QuantityVector<Q> a(n, Q(Rep(1.5))), b(n, Q(Rep(0.25))), out(n);
+  for (auto _ : state) {
+    out = a * 2.0 + b;
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+  state.SetBytesProcessed(state.iterations() * n * 3 * sizeof(Rep));
+}
+BENCHMARK_TEMPLATE(BM_RepFusedScaleAdd, float)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(BM_RepFusedScaleAdd, double)->Range(1 << 10, 1 << 22);
+
+template<typename Rep>
+static void BM_RepConvert(benchmark::State& state) {
+  using Q = uniTypes::with_rep_t<uniTypes::Mass, Rep>;
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  uniTypes::QuantityVector<Q> masses(n, Q(Rep(1.5)));
+  std::vector<Rep> pounds(n);
+  for (auto _ : state) {
+    uniTypes::convertTo(masses, uniTypes::pound, pounds.data());
+    benchmark::DoNotOptimize(pounds.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+  state.SetBytesProcessed(state.iterations() * n * 2 * sizeof(Rep));
+}
+BENCHMARK_TEMPLATE(BM_RepConvert, float)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(BM_RepConvert, double)->Range(1 << 10, 1 << 22);
+
+template<typename Rep>
+static void BM_RepSum(benchmark::State& state) {
+  using Q = uniTypes::with_rep_t<uniTypes::Mass, Rep>;
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  uniTypes::QuantityVector<Q> masses(n, Q(Rep(1.5)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(uniTypes::sum(masses));
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+  state.SetBytesProcessed(state.iterations() * n * sizeof(Rep));
+}
+BENCHMARK_TEMPLATE(BM_RepSum, float)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(BM_RepSum, double)->Range(1 << 10, 1 << 22);
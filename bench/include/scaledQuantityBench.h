@@ -0,0 +1,76 @@
+#include <uniTypes/scaledQuantity.h>
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Converting pounds to ounces and totalling milligrams, with compile-time scales on int64 counts
+// versus RatioQuantity doubles converted through the runtime unit values.
+
+using BenchPounds = uniTypes::ScaledQuantity<uniTypes::Mass, uniTypes::scales::pound, std::int64_t>;
+using BenchOunces = uniTypes::ScaledQuantity<uniTypes::Mass, uniTypes::scales::ounce, std::int64_t>;
+
+static void BM_ScaledPoundsToOunces(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  std::vector<BenchPounds> in(n, BenchPounds(3));
+  std::vector<BenchOunces> out(n);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < n; ++i) {
+      out[i] = in[i];
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_ScaledPoundsToOunces)->Range(1 << 10, 1 << 20);
+
+static void BM_RatioPoundsToOunces(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  std::vector<uniTypes::Mass> in(n, 3.0 * uniTypes::pound);
+  std::vector<double> out(n);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < n; ++i) {
+      out[i] = in[i].convertTo(uniTypes::ounce);
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_RatioPoundsToOunces)->Range(1 << 10, 1 << 20);
+
+static void BM_ScaledSumMilligrams(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  std::vector<uniTypes::Milligrams> in(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    in[i] = uniTypes::Milligrams(static_cast<std::int64_t>(i % 1000));
+  }
+  for (auto _ : state) {
+    uniTypes::Milligrams total;
+    for (std::size_t i = 0; i < n; ++i) {
+      total += in[i];
+    }
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_ScaledSumMilligrams)->Range(1 << 10, 1 << 20);
+
+static void BM_RatioSumMilligrams(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  std::vector<uniTypes::Mass> in(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    in[i] = static_cast<double>(i % 1000) * uniTypes::milligram;
+  }
+  for (auto _ : state) {
+    uniTypes::Mass total;
+    for (std::size_t i = 0; i < n; ++i) {
+      total += in[i];
+    }
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_RatioSumMilligrams)->Range(1 << 10, 1 << 20);
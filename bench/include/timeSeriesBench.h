@@ -0,0 +1,160 @@
+#include <uniTypes/timeSeries.h>
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Scale readings about a second apart, up to 10^8 samples: TimeSeries interpolation against an
+// array of {time, value} structs searched with std::upper_bound per query, plus appends,
+// resampling, range lookups and a trailing window following a growing series. Interpolation
+// takes a batch of 2^20 queries, either sorted or in random order.
+
+static constexpr std::size_t kTimeSeriesBenchQueries = 1 << 20;
+
+// The series of the given size, rebuilt only when the size changes so at most one of the large
+// series is in memory.
+static const uniTypes::TimeSeries<uniTypes::Mass>& timeSeriesBenchSeries(std::size_t n) {
+  static std::unique_ptr<uniTypes::TimeSeries<uniTypes::Mass>> series;
+  if (!series || series->size() != n) {
+    series.reset();
+    series = std::make_unique<uniTypes::TimeSeries<uniTypes::Mass>>();
+    series->reserve(n);
+    std::mt19937 generator(13);
+    std::exponential_distribution<double> gap(1.0);
+    std::normal_distribution<double> step(0.0, 0.01);
+    double time = 0.0;
+    double mass = 70.0;
+    for (std::size_t i = 0; i < n; ++i) {
+      time += gap(generator);
+      mass += step(generator);
+      series->append(uniTypes::Time(time), uniTypes::Mass(mass));
+    }
+  }
+  return *series;
+}
+
+static uniTypes::QuantityVector<uniTypes::Time> timeSeriesBenchQueries(
+  const uniTypes::TimeSeries<uniTypes::Mass>& series, bool sorted) {
+  std::mt19937 generator(17);
+  std::uniform_real_distribution<double> when(series.time(0).getValue(),
+                                              series.time(series.size() - 1).getValue());
+  std::vector<double> raw(kTimeSeriesBenchQueries);
+  for (double& query : raw) {
+    query = when(generator);
+  }
+  if (sorted) {
+    std::sort(raw.begin(), raw.end());
+  }
+  uniTypes::QuantityVector<uniTypes::Time> queries;
+  for (double query : raw) {
+    queries.push_back(uniTypes::Time(query));
+  }
+  return queries;
+}
+
+static void BM_TimeSeriesAppend(benchmark::State& state) {
+  const auto& source = timeSeriesBenchSeries(1 << 20);
+  for (auto _ : state) {
+    uniTypes::TimeSeries<uniTypes::Mass> series;
+    for (std::size_t i = 0; i < source.size(); ++i) {
+      series.append(source.time(i), source.value(i));
+    }
+    benchmark::DoNotOptimize(series.size());
+  }
+  state.SetItemsProcessed(state.iterations() * (1 << 20));
+}
+BENCHMARK(BM_TimeSeriesAppend);
+
+// Arguments: series size, whether the queries are sorted.
+static void BM_TimeSeriesInterpolate(benchmark::State& state) {
+  const auto& series = timeSeriesBenchSeries(state.range(0));
+  const auto queries = timeSeriesBenchQueries(series, state.range(1) != 0);
+  uniTypes::QuantityVector<uniTypes::Mass> out(queries.size());
+  for (auto _ : state) {
+    series.interpolate(queries, out);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_TimeSeriesInterpolate)
+  ->Args({1 << 20, 1})->Args({1 << 20, 0})->Args({100000000, 1})->Args({100000000, 0});
+
+struct TimeSeriesBenchSample {
+  double time;
+  double value;
+};
+
+static void BM_AosInterpolate(benchmark::State& state) {
+  const auto& series = timeSeriesBenchSeries(state.range(0));
+  const auto queries = timeSeriesBenchQueries(series, state.range(1) != 0);
+  std::vector<TimeSeriesBenchSample> samples(series.size());
+  for (std::size_t i = 0; i < series.size(); ++i) {
+    samples[i] = {series.time(i).getValue(), series.value(i).getValue()};
+  }
+  std::vector<double> out(queries.size());
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < queries.size(); ++i) {
+      const double query = queries[i].getValue();
+      const auto next = std::upper_bound(
+        samples.begin(), samples.end(), query,
+        [](double value, const TimeSeriesBenchSample& sample) { return value < sample.time; });
+      if (next == samples.begin()) {
+        out[i] = next->value;
+      } else if (next == samples.end()) {
+        out[i] = samples.back().value;
+      } else {
+        const auto& before = *(next - 1);
+        out[i] = before.value + (next->value - before.value) * (query - before.time) /
+                                  (next->time - before.time);
+      }
+    }
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_AosInterpolate)
+  ->Args({1 << 20, 1})->Args({1 << 20, 0})->Args({100000000, 1})->Args({100000000, 0});
+
+static void BM_TimeSeriesResample(benchmark::State& state) {
+  const auto& series = timeSeriesBenchSeries(100000000);
+  const auto aggregation = static_cast<uniTypes::Aggregation>(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(series.resample(uniTypes::Time(60.0), aggregation).size());
+  }
+  state.SetItemsProcessed(state.iterations() * series.size());
+}
+BENCHMARK(BM_TimeSeriesResample)
+  ->Arg(static_cast<int>(uniTypes::Aggregation::Sum))
+  ->Arg(static_cast<int>(uniTypes::Aggregation::Last))
+  ->Unit(benchmark::kMillisecond);
+
+static void BM_TimeSeriesSlice(benchmark::State& state) {
+  const auto& series = timeSeriesBenchSeries(100000000);
+  const auto starts = timeSeriesBenchQueries(series, false);
+  std::size_t i = 0;
+  for (auto _ : state) {
+    const uniTypes::Time start = starts[i++ & (kTimeSeriesBenchQueries - 1)];
+    benchmark::DoNotOptimize(series.slice(start, start + uniTypes::Time(3600.0)).size());
+  }
+}
+BENCHMARK(BM_TimeSeriesSlice);
+
+// Appending a sample and updating a one-hour window, per sample.
+static void BM_TimeWindowUpdate(benchmark::State& state) {
+  const auto& source = timeSeriesBenchSeries(1 << 20);
+  for (auto _ : state) {
+    uniTypes::TimeSeries<uniTypes::Mass> series;
+    series.reserve(source.size());
+    uniTypes::TimeWindow<uniTypes::Mass> window(series, uniTypes::Time(3600.0));
+    for (std::size_t i = 0; i < source.size(); ++i) {
+      series.append(source.time(i), source.value(i));
+      window.update();
+      benchmark::DoNotOptimize(window.max());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * (1 << 20));
+}
+BENCHMARK(BM_TimeWindowUpdate);
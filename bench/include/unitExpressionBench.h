@@ -0,0 +1,89 @@
+#include <uniTypes/unitExpression.h>
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+// Resolving the unit of each record of a mixed upstream feed: compiling every expression, looking
+// it up in the shared cache, and the checked parseUnit<Q> path, against a single-token lookup in
+// the unit table as the floor.
+
+// A feed of 4096 unit strings in which a few expressions dominate, as in real feeds: expression k
+// of the vocabulary appears with weight 1/(k + 1). Built from a fixed seed.
+static std::vector<std::string> unitFeed(const std::vector<std::string>& vocabulary) {
+  std::vector<double> weights;
+  for (std::size_t k = 0; k < vocabulary.size(); ++k) {
+    weights.push_back(1.0 / static_cast<double>(k + 1));
+  }
+  std::mt19937 generator(7);
+  std::discrete_distribution<std::size_t> pick(weights.begin(), weights.end());
+  std::vector<std::string> feed;
+  for (std::size_t i = 0; i < 4096; ++i) {
+    feed.push_back(vocabulary[pick(generator)]);
+  }
+  return feed;
+}
+
+static const std::vector<std::string>& mixedUnitFeed() {
+  static const std::vector<std::string> feed = unitFeed({
+    "mg/dL", "kcal/day", "mg/ml", "mmol/L", "kg*m/s^2", "km/h", "g", "mIU/mL", "ug/L", "kg/m^2",
+    "J/(kg*K)", "lb/in2", "m/s2", "ml/min", "N*m", "kJ/mol", "g/cm^3", "IU/kg", "mg/kg/day",
+    "kJ/h", "kcal/kg", "mcg/dL", "L/min", "kg*m^2"});
+  return feed;
+}
+
+static void BM_UnitExpressionCompile(benchmark::State& state) {
+  const std::vector<std::string>& feed = mixedUnitFeed();
+  double total = 0.0;
+  std::size_t i = 0;
+  for (auto _ : state) {
+    total += uniTypes::compileUnit(feed[i++ & 4095]).getValue();
+  }
+  benchmark::DoNotOptimize(total);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_UnitExpressionCompile);
+
+static void BM_UnitExpressionCached(benchmark::State& state) {
+  const std::vector<std::string>& feed = mixedUnitFeed();
+  uniTypes::UnitExpressionCache& cache = uniTypes::sharedUnitCache();
+  double total = 0.0;
+  std::size_t i = 0;
+  for (auto _ : state) {
+    total += cache.get(feed[i++ & 4095]).getValue();
+  }
+  benchmark::DoNotOptimize(total);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_UnitExpressionCached)->ThreadRange(1, 4)->UseRealTime();
+
+static void BM_UnitExpressionParseUnit(benchmark::State& state) {
+  using Density = uniTypes::quantity_quotient_t<uniTypes::Mass, uniTypes::Volume>;
+  static const std::vector<std::string> feed = unitFeed({
+    "mg/dL", "mg/ml", "ug/L", "g/cm^3", "kg/m3", "mcg/dL", "g/L", "lb/ft3"});
+  Density total(0.0);
+  std::size_t i = 0;
+  for (auto _ : state) {
+    total += 1.5 * uniTypes::parseUnit<Density>(feed[i++ & 4095]);
+  }
+  benchmark::DoNotOptimize(total);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_UnitExpressionParseUnit);
+
+static void BM_UnitTokenLookup(benchmark::State& state) {
+  static const std::vector<std::string> feed = unitFeed({
+    "mg", "kcal", "ml", "mol", "kg", "km", "g", "IU", "L", "m2", "J", "lb", "s", "min", "N", "kJ",
+    "cm3", "day", "h", "oz", "Cal", "dm", "in2", "ft"});
+  double total = 0.0;
+  std::size_t i = 0;
+  for (auto _ : state) {
+    const uniTypes::UnitEntry* entry = uniTypes::lookupUnit(feed[i++ & 4095]);
+    total += entry != nullptr ? entry->factor : 0.0;
+  }
+  benchmark::DoNotOptimize(total);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_UnitTokenLookup);
@@ -0,0 +1,70 @@
+#include <uniTypes/unitParser.h>
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Parsing mixed quantity strings with parseQuantity versus splitting them by hand and resolving
+// the unit through the string_to_*_unit tables in uniTypes/unitMaps.h.
+
+static const std::vector<std::string>& parserBenchInputs() {
+  static const std::vector<std::string> inputs{
+    "12.5 lb", "3 tbsp", "250 g", "1.5 cup", "0.75 kg", "2 tsp", "16 oz", "1 gal",
+    "500 ml", "4 qt", "10 mg", "3.25 liter", "8 fl", "100 kg", "2.2 lb", "6 cup"
+  };
+  return inputs;
+}
+
+static void BM_ParseQuantityPerfectHash(benchmark::State& state) {
+  const auto& inputs = parserBenchInputs();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    uniTypes::ParseResult result = uniTypes::parseQuantity(inputs[i++ & 15]);
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ParseQuantityPerfectHash);
+
+static void BM_ParseQuantityUnitMap(benchmark::State& state) {
+  const auto& inputs = parserBenchInputs();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    const std::string& input = inputs[i++ & 15];
+    const std::size_t space = input.find(' ');
+    const double number = std::stod(input.substr(0, space));
+    const std::string unit = input.substr(space + 1);
+    double value = 0.0;
+    auto mass = uniTypes::string_to_mass_unit.find(unit);
+    if (mass != uniTypes::string_to_mass_unit.end()) {
+      value = number * mass->second.getValue();
+    } else {
+      value = number * uniTypes::string_to_volume_unit.at(unit).getValue();
+    }
+    benchmark::DoNotOptimize(value);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ParseQuantityUnitMap);
+
+static void BM_LookupUnitPerfectHash(benchmark::State& state) {
+  const char* names[4] = {"tablespoon", "lb", "kcal", "cup"};
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(uniTypes::lookupUnit(std::string_view(names[i++ & 3])));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LookupUnitPerfectHash);
+
+static void BM_LookupUnitUnitMap(benchmark::State& state) {
+  const char* names[4] = {"tablespoon", "tbsp", "cup", "quart"};
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(uniTypes::string_to_volume_unit.at(names[i++ & 3]));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LookupUnitUnitMap);
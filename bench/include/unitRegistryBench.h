@@ -0,0 +1,101 @@
+#include <uniTypes/unitRegistry.h>
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Looking up a mix of built-in and runtime-defined unit names in a UnitRegistry versus a
+// std::map of defined units behind a std::shared_mutex, from one or more threads. The argument
+// is the number of defined units.
+
+static std::string registryBenchName(std::size_t i) {
+  std::string name;
+  do {
+    name.insert(name.begin(), static_cast<char>('a' + i % 26));
+    i /= 26;
+  } while (i != 0);
+  return "pack" + name;
+}
+
+// Names to look up: every other one built-in, the rest spread over the defined units.
+static std::vector<std::string> registryBenchQueries(std::size_t defined) {
+  const char* builtin[4] = {"tablespoon", "lb", "kcal", "cup"};
+  std::vector<std::string> queries;
+  for (std::size_t i = 0; i < 64; ++i) {
+    queries.push_back(i % 2 == 0 ? std::string(builtin[i / 2 % 4])
+                                 : registryBenchName(i * 7919 % defined));
+  }
+  return queries;
+}
+
+static void BM_UnitRegistryFind(benchmark::State& state) {
+  static uniTypes::UnitRegistry* registry = nullptr;
+  const std::size_t defined = static_cast<std::size_t>(state.range(0));
+  if (state.thread_index() == 0) {
+    registry = new uniTypes::UnitRegistry;
+    for (std::size_t i = 0; i < defined; ++i) {
+      registry->define(registryBenchName(i), uniTypes::DynQuantity(i + 1.0, {}));
+    }
+  }
+  const std::vector<std::string> queries = registryBenchQueries(defined);
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(registry->find(queries[i++ & 63]));
+  }
+  state.SetItemsProcessed(state.iterations());
+  if (state.thread_index() == 0) {
+    delete registry;
+  }
+}
+BENCHMARK(BM_UnitRegistryFind)->Arg(16)->Arg(1024)->ThreadRange(1, 4);
+
+static void BM_SharedMutexMapFind(benchmark::State& state) {
+  static std::map<std::string, uniTypes::UnitEntry, std::less<>>* defined_units = nullptr;
+  static std::shared_mutex mutex;
+  const std::size_t defined = static_cast<std::size_t>(state.range(0));
+  if (state.thread_index() == 0) {
+    defined_units = new std::map<std::string, uniTypes::UnitEntry, std::less<>>;
+    for (std::size_t i = 0; i < defined; ++i) {
+      (*defined_units)[registryBenchName(i)] = uniTypes::UnitEntry{"", i + 1.0, {}};
+    }
+  }
+  const std::vector<std::string> queries = registryBenchQueries(defined);
+  std::size_t i = 0;
+  for (auto _ : state) {
+    const std::string_view name = queries[i++ & 63];
+    const uniTypes::UnitEntry* entry = uniTypes::lookupUnit(name);
+    if (entry == nullptr) {
+      std::shared_lock<std::shared_mutex> lock(mutex);
+      const auto found = defined_units->find(name);
+      entry = found == defined_units->end() ? nullptr : &found->second;
+    }
+    benchmark::DoNotOptimize(entry);
+  }
+  state.SetItemsProcessed(state.iterations());
+  if (state.thread_index() == 0) {
+    delete defined_units;
+  }
+}
+BENCHMARK(BM_SharedMutexMapFind)->Arg(16)->Arg(1024)->ThreadRange(1, 4);
+
+// Defining units one at a time into an empty registry, including the table growth.
+static void BM_UnitRegistryDefine(benchmark::State& state) {
+  std::vector<std::string> names;
+  for (std::size_t i = 0; i < 1024; ++i) {
+    names.push_back(registryBenchName(i));
+  }
+  for (auto _ : state) {
+    uniTypes::UnitRegistry registry;
+    for (std::size_t i = 0; i < names.size(); ++i) {
+      registry.define(names[i], uniTypes::DynQuantity(i + 1.0, {}));
+    }
+    benchmark::DoNotOptimize(registry.size());
+  }
+  state.SetItemsProcessed(state.iterations() * 1024);
+}
+BENCHMARK(BM_UnitRegistryDefine);
@@ -0,0 +1,143 @@
+#include <uniTypes/vec3.h>
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <vector>
+
+// Vec3 and Mat3 against the same work on raw double triples. Each BM_Vec3* result should match
+// its BM_RawVec3* baseline: per-vector operations on an array of Vec3s (array of structures), and
+// the Vec3Array kernels against hand-written loops over three double columns (structure of
+// arrays).
+
+namespace {
+  struct RawVec3 {
+    double x, y, z;
+  };
+
+  uniTypes::Vec3Array<uniTypes::Length> benchVec3Array(std::size_t n) {
+    uniTypes::Vec3Array<uniTypes::Length> array(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      const double t = static_cast<double>(i % 1024);
+      array.set(i, uniTypes::Vec3<uniTypes::Length>(t * uniTypes::meter, 1.0 * uniTypes::meter,
+                                                    -t * uniTypes::meter));
+    }
+    return array;
+  }
+
+  const uniTypes::Mat3<> kBenchRotation(uniTypes::Vec3<uniTypes::Number>(0.6, -0.8, 0.0),
+                                        uniTypes::Vec3<uniTypes::Number>(0.8, 0.6, 0.0),
+                                        uniTypes::Vec3<uniTypes::Number>(0.0, 0.0, 1.0));
+}
+
+static void BM_RawVec3CrossAoS(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  std::vector<RawVec3> a(n, RawVec3{1.0, 2.0, 3.0}), b(n, RawVec3{-2.0, 0.5, 4.0}), out(n);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < n; ++i) {
+      out[i] = RawVec3{a[i].y * b[i].z - a[i].z * b[i].y, a[i].z * b[i].x - a[i].x * b[i].z,
+                       a[i].x * b[i].y - a[i].y * b[i].x};
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_RawVec3CrossAoS)->Range(1 << 10, 1 << 20);
+
+static void BM_Vec3CrossAoS(benchmark::State& state) {
+  using Torque = uniTypes::quantity_product_t<uniTypes::Length, uniTypes::Force>;
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  std::vector<uniTypes::Vec3<uniTypes::Length>> a(
+    n, uniTypes::Vec3<uniTypes::Length>(1.0 * uniTypes::meter, 2.0 * uniTypes::meter,
+                                        3.0 * uniTypes::meter));
+  std::vector<uniTypes::Vec3<uniTypes::Force>> b(
+    n, uniTypes::Vec3<uniTypes::Force>(-2.0 * uniTypes::newton, 0.5 * uniTypes::newton,
+                                       4.0 * uniTypes::newton));
+  std::vector<uniTypes::Vec3<Torque>> out(n);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < n; ++i) {
+      out[i] = uniTypes::cross(a[i], b[i]);
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_Vec3CrossAoS)->Range(1 << 10, 1 << 20);
+
+static void BM_RawVec3DotSoA(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const uniTypes::Vec3Array<uniTypes::Length> a = benchVec3Array(n), b = benchVec3Array(n);
+  const double *ax = a.x().data(), *ay = a.y().data(), *az = a.z().data();
+  const double *bx = b.x().data(), *by = b.y().data(), *bz = b.z().data();
+  std::vector<double> out(n);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < n; ++i) {
+      out[i] = ax[i] * bx[i] + ay[i] * by[i] + az[i] * bz[i];
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_RawVec3DotSoA)->Range(1 << 10, 1 << 20);
+
+static void BM_Vec3DotSoA(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const uniTypes::Vec3Array<uniTypes::Length> a = benchVec3Array(n), b = benchVec3Array(n);
+  uniTypes::QuantityVector<uniTypes::Area> out(n);
+  for (auto _ : state) {
+    uniTypes::dot(a, b, out);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_Vec3DotSoA)->Range(1 << 10, 1 << 20);
+
+static void BM_RawVec3TransformSoA(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const uniTypes::Vec3Array<uniTypes::Length> in = benchVec3Array(n);
+  const double *ix = in.x().data(), *iy = in.y().data(), *iz = in.z().data();
+  std::vector<double> ox(n), oy(n), oz(n);
+  const double* k = kBenchRotation.data();
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < n; ++i) {
+      ox[i] = k[0] * ix[i] + k[1] * iy[i] + k[2] * iz[i];
+      oy[i] = k[3] * ix[i] + k[4] * iy[i] + k[5] * iz[i];
+      oz[i] = k[6] * ix[i] + k[7] * iy[i] + k[8] * iz[i];
+    }
+    benchmark::DoNotOptimize(ox.data());
+    benchmark::DoNotOptimize(oy.data());
+    benchmark::DoNotOptimize(oz.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_RawVec3TransformSoA)->Range(1 << 10, 1 << 20);
+
+static void BM_Vec3TransformSoA(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const uniTypes::Vec3Array<uniTypes::Length> in = benchVec3Array(n);
+  uniTypes::Vec3Array<uniTypes::Length> out(n);
+  for (auto _ : state) {
+    uniTypes::transform(kBenchRotation, in, out);
+    benchmark::DoNotOptimize(out.x().data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_Vec3TransformSoA)->Range(1 << 10, 1 << 20);
+
+static void BM_Vec3TransformSoAAllCores(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const uniTypes::Vec3Array<uniTypes::Length> in = benchVec3Array(n);
+  uniTypes::Vec3Array<uniTypes::Length> out(n);
+  for (auto _ : state) {
+    uniTypes::transform(kBenchRotation, in, out, 0);
+    benchmark::DoNotOptimize(out.x().data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_Vec3TransformSoAAllCores)->Range(1 << 10, 1 << 20);
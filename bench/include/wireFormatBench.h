@@ -0,0 +1,73 @@
+#include <uniTypes/reduce.h>
+#include <uniTypes/wireFormat.h>
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Round trips of 4M masses through a temp file: writing a batch against fwrite of bare doubles,
+// and summing a mapped batch in place against reading it into a vector first. The batch adds
+// only its 64-byte header, and the in-place view skips the copy entirely.
+
+constexpr std::size_t kWireBenchSize = std::size_t(1) << 22;
+
+static std::string wireBenchPath() {
+  return (std::filesystem::temp_directory_path() / "uniTypes_wireFormatBench.utqb").string();
+}
+
+static const uniTypes::QuantityVector<uniTypes::Mass>& wireBenchMasses() {
+  static const uniTypes::QuantityVector<uniTypes::Mass> masses(kWireBenchSize,
+                                                               uniTypes::Mass(1.5));
+  return masses;
+}
+
+static void BM_WireRawWrite(benchmark::State& state) {
+  const std::vector<double> values(kWireBenchSize, 1.5);
+  const std::string path = wireBenchPath();
+  for (auto _ : state) {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    std::fwrite(values.data(), sizeof(double), values.size(), file);
+    std::fclose(file);
+  }
+  std::filesystem::remove(path);
+  state.SetBytesProcessed(state.iterations() * kWireBenchSize * sizeof(double));
+}
+BENCHMARK(BM_WireRawWrite)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_WireWrite(benchmark::State& state) {
+  const std::string path = wireBenchPath();
+  for (auto _ : state) {
+    uniTypes::writeQuantityFile(path, wireBenchMasses());
+  }
+  std::filesystem::remove(path);
+  state.SetBytesProcessed(state.iterations() * kWireBenchSize * sizeof(double));
+}
+BENCHMARK(BM_WireWrite)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_WireReadCopy(benchmark::State& state) {
+  const std::string path = wireBenchPath();
+  uniTypes::writeQuantityFile(path, wireBenchMasses());
+  for (auto _ : state) {
+    uniTypes::QuantityFile file(path);
+    uniTypes::QuantityVector<uniTypes::Mass> masses = file.read<uniTypes::Mass>();
+    benchmark::DoNotOptimize(uniTypes::sum(masses));
+  }
+  std::filesystem::remove(path);
+  state.SetBytesProcessed(state.iterations() * kWireBenchSize * sizeof(double));
+}
+BENCHMARK(BM_WireReadCopy)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_WireViewInPlace(benchmark::State& state) {
+  const std::string path = wireBenchPath();
+  uniTypes::writeQuantityFile(path, wireBenchMasses());
+  for (auto _ : state) {
+    uniTypes::QuantityFile file(path);
+    benchmark::DoNotOptimize(uniTypes::sum(file.as<uniTypes::Mass>()));
+  }
+  std::filesystem::remove(path);
+  state.SetBytesProcessed(state.iterations() * kWireBenchSize * sizeof(double));
+}
+BENCHMARK(BM_WireViewInPlace)->Unit(benchmark::kMillisecond)->UseRealTime();
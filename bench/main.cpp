@@ -0,0 +1,25 @@
+#include "benchmark/benchmark.h"
+
+// Include all of the benchmark files we want to run.
+#include <coreOpsBench.h>
+#include <quantityVectorBench.h>
+#include <convertBench.h>
+#include <unitParserBench.h>
+#include <ingestBench.h>
+#include <formatBench.h>
+#include <expressionBench.h>
+#include <reduceBench.h>
+#include <scaledQuantityBench.h>
+#include <repBench.h>
+#include <wireFormatBench.h>
+#include <conversionPlanBench.h>
+#include <atomicQuantityBench.h>
+#include <instrumentBench.h>
+#include <vec3Bench.h>
+#include <unitExpressionBench.h>
+#include <quantileSketchBench.h>
+#include <timeSeriesBench.h>
+#include <unitRegistryBench.h>
+#include <densityBench.h>
+
+BENCHMARK_MAIN();
\ No newline at end of file
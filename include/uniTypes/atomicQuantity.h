@@ -0,0 +1,163 @@
+#pragma once
+#include <uniTypes.h>
+#include <uniTypes/parallel.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+// Quantities that many threads can update at once.
+//
+// AtomicQuantity<Q> is std::atomic for a single quantity: its operations take and return Q, so
+// adding a Length to an AtomicQuantity<Mass> still fails to compile. When many threads update the
+// same total, ShardedAccumulator<Q> spreads the updates over one cache line per thread and only
+// combines them when the total is read.
+namespace uniTypes {
+  // Assumed size of a cache line, used to keep shards that different threads write apart.
+  constexpr std::size_t kCacheLineSize = 64;
+
+  namespace detail {
+    // fetch_add for any arithmetic rep. std::atomic only has it for integers before C++20, so
+    // floating-point reps use a compare-and-swap loop.
+    template<typename Rep>
+    Rep atomicFetchAdd(std::atomic<Rep>& value, Rep delta, std::memory_order order) {
+      if constexpr (std::is_integral<Rep>::value) {
+        return value.fetch_add(delta, order);
+      } else {
+        Rep expected = value.load(std::memory_order_relaxed);
+        while (!value.compare_exchange_weak(expected, expected + delta, order,
+                                            std::memory_order_relaxed)) {
+        }
+        return expected;
+      }
+    }
+
+    // Small per-thread index, handed out in the order threads first ask for one.
+    inline std::size_t threadShardIndex() {
+      static std::atomic<std::size_t> next_index(0);
+      thread_local const std::size_t index = next_index.fetch_add(1, std::memory_order_relaxed);
+      return index;
+    }
+  }
+
+  template<typename Q>
+  class AtomicQuantity {
+  public:
+    using quantity_type = Q;
+    using rep = typename Q::rep;
+
+    AtomicQuantity() noexcept : value_(rep()) {}
+    AtomicQuantity(Q initial) noexcept : value_(initial.getValue()) {}
+
+    AtomicQuantity(const AtomicQuantity&) = delete;
+    AtomicQuantity& operator=(const AtomicQuantity&) = delete;
+
+    bool is_lock_free() const noexcept { return value_.is_lock_free(); }
+
+    Q load(std::memory_order order = std::memory_order_seq_cst) const noexcept {
+      return Q(value_.load(order));
+    }
+
+    void store(Q desired, std::memory_order order = std::memory_order_seq_cst) noexcept {
+      value_.store(desired.getValue(), order);
+    }
+
+    Q exchange(Q desired, std::memory_order order = std::memory_order_seq_cst) noexcept {
+      return Q(value_.exchange(desired.getValue(), order));
+    }
+
+    // Replaces the value with desired if it equals expected; otherwise loads it into expected.
+    bool compare_exchange_weak(Q& expected, Q desired,
+                               std::memory_order order = std::memory_order_seq_cst) noexcept {
+      rep current = expected.getValue();
+      const bool exchanged = value_.compare_exchange_weak(current, desired.getValue(), order);
+      expected = Q(current);
+      return exchanged;
+    }
+
+    bool compare_exchange_strong(Q& expected, Q desired,
+                                 std::memory_order order = std::memory_order_seq_cst) noexcept {
+      rep current = expected.getValue();
+      const bool exchanged = value_.compare_exchange_strong(current, desired.getValue(), order);
+      expected = Q(current);
+      return exchanged;
+    }
+
+    // Adds delta and returns the previous value.
+    Q fetch_add(Q delta, std::memory_order order = std::memory_order_seq_cst) noexcept {
+      return Q(detail::atomicFetchAdd(value_, delta.getValue(), order));
+    }
+
+    Q fetch_sub(Q delta, std::memory_order order = std::memory_order_seq_cst) noexcept {
+      return Q(detail::atomicFetchAdd(value_, static_cast<rep>(-delta.getValue()), order));
+    }
+
+    // Like std::atomic, the compound operators return the new value rather than a reference.
+    Q operator+=(Q delta) noexcept { return fetch_add(delta) + delta; }
+    Q operator-=(Q delta) noexcept { return fetch_sub(delta) - delta; }
+
+    Q operator=(Q desired) noexcept {
+      store(desired);
+      return desired;
+    }
+
+    operator Q() const noexcept { return load(); }
+
+  private:
+    std::atomic<rep> value_;
+  };
+
+  template<typename Q>
+  class ShardedAccumulator {
+  public:
+    using quantity_type = Q;
+    using rep = typename Q::rep;
+
+    // std::size_t shards = hardwareThreads(), Number of cache lines to spread updates over.
+    // Threads beyond that share shards, which stays correct but contends again.
+    explicit ShardedAccumulator(std::size_t shards = hardwareThreads())
+      : num_shards_(shards < 1 ? 1 : shards), shards_(new Shard[num_shards_]) {}
+
+    ShardedAccumulator(const ShardedAccumulator&) = delete;
+    ShardedAccumulator& operator=(const ShardedAccumulator&) = delete;
+
+    // Adds delta to the calling thread's shard. Relaxed: a concurrent total() may or may not
+    // include it.
+    void add(Q delta) noexcept {
+      Shard& shard = shards_[detail::threadShardIndex() % num_shards_];
+      detail::atomicFetchAdd(shard.value, delta.getValue(), std::memory_order_relaxed);
+    }
+
+    ShardedAccumulator& operator+=(Q delta) noexcept {
+      add(delta);
+      return *this;
+    }
+
+    // Sum of all shards, in shard order.
+    Q total() const noexcept {
+      rep sum = rep();
+      for (std::size_t i = 0; i < num_shards_; ++i) {
+        sum += shards_[i].value.load(std::memory_order_relaxed);
+      }
+      return Q(sum);
+    }
+
+    // Sets every shard back to zero. Adds that race with reset may be lost.
+    void reset() noexcept {
+      for (std::size_t i = 0; i < num_shards_; ++i) {
+        shards_[i].value.store(rep(), std::memory_order_relaxed);
+      }
+    }
+
+    std::size_t shards() const noexcept { return num_shards_; }
+
+  private:
+    struct alignas(kCacheLineSize) Shard {
+      std::atomic<rep> value{rep()};
+    };
+
+    std::size_t num_shards_;
+    std::unique_ptr<Shard[]> shards_;
+  };
+}
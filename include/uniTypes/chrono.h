@@ -0,0 +1,40 @@
+#pragma once
+#include <uniTypes/quantity.h>
+
+#include <chrono>
+#include <ratio>
+
+// Conversions between Time quantities and std::chrono durations.
+//
+// Both directions are a single multiply by a factor folded at compile time from the period of the
+// duration, so timing code can measure with std::chrono clocks and report Time quantities at no
+// extra cost.
+namespace uniTypes {
+  namespace detail {
+    // Seconds in one tick of Period.
+    template<typename Period>
+    constexpr double kSecondsPerTick = static_cast<double>(Period::num) /
+                                       static_cast<double>(Period::den);
+  }
+
+  // ------------------------------------------
+  // fromDuration
+  // ------------------------------------------
+  // Time quantity of a std::chrono duration, e.g. fromDuration(steady_clock::now() - start).
+  template<typename Rep, typename Period>
+  constexpr Time fromDuration(std::chrono::duration<Rep, Period> duration) {
+    return Time(static_cast<double>(duration.count()) * detail::kSecondsPerTick<Period>);
+  }
+
+  // ------------------------------------------
+  // toDuration
+  // ------------------------------------------
+  // std::chrono duration of a Time quantity. Integer durations truncate toward zero, as
+  // std::chrono::duration_cast does.
+  template<typename Duration = std::chrono::duration<double>, typename Rep>
+  constexpr Duration toDuration(with_rep_t<Time, Rep> time) {
+    using TickRep = typename Duration::rep;
+    return Duration(static_cast<TickRep>(
+      static_cast<double>(time.getValue()) / detail::kSecondsPerTick<typename Duration::period>));
+  }
+}
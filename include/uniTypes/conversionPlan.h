@@ -0,0 +1,176 @@
+#pragma once
+#include <uniTypes/convert.h>
+#include <uniTypes/dimension.h>
+#include <uniTypes/dynQuantity.h>
+#include <uniTypes/perfectHash.h>
+#include <uniTypes/unitRegistry.h>
+#include <uniTypes/unitTable.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+// Precompiled conversions between two units named at runtime.
+//
+// A ConversionPlan resolves a (from, to) pair of unit names once, checks that the units have the
+// same dimension and folds the two unit values into a single factor, so each conversion
+// afterwards is one multiply. ConversionPlanCache shares plans between threads: lookups are a
+// hash and a few atomic loads, and never take a lock.
+namespace uniTypes {
+  class ConversionPlan {
+  public:
+    // Identity conversion of dimensionless numbers.
+    constexpr ConversionPlan() : factor_(1.0), dimension_() {}
+
+    // Plan for converting values in multiples of from_unit to multiples of to_unit. Throws
+    // DimensionMismatch if the units have different dimensions.
+    ConversionPlan(DynQuantity from_unit, DynQuantity to_unit)
+      : factor_(from_unit.getValue() / to_unit.getValue()),
+        dimension_(from_unit.getDimension()) {
+      from_unit.checkSameDimension(to_unit);
+    }
+
+    // Plan between two units, by built-in name or abbreviation (see unitTable.h) or by a name
+    // defined in sharedUnitRegistry(). Throws std::out_of_range for an unknown name and
+    // DimensionMismatch if the units have different dimensions.
+    static ConversionPlan compile(std::string_view from, std::string_view to) {
+      const UnitEntry& from_unit = checkedUnit(from);
+      const UnitEntry& to_unit = checkedUnit(to);
+      return ConversionPlan(DynQuantity(from_unit.factor, from_unit.dimension),
+                            DynQuantity(to_unit.factor, to_unit.dimension));
+    }
+
+    // Value of one from-unit in to-units.
+    constexpr double factor() const { return factor_; }
+    constexpr Dimension dimension() const { return dimension_; }
+
+    // Converts a single value. May differ from RatioQuantity::convertTo in the last bit, as the
+    // two unit values are combined before rather than after scaling.
+    constexpr double operator()(double value) const { return value * factor_; }
+
+    // Converts in[0, n) into out[0, n), which may be the same array.
+    void apply(const double* in, std::size_t n, double* out, unsigned threads = 1) const {
+      detail::scaleValues(in, n, factor_, out, threads);
+    }
+
+  private:
+    static const UnitEntry& checkedUnit(std::string_view name) {
+      const UnitEntry* unit = findUnit(name);
+      if (unit == nullptr) {
+        throw std::out_of_range("uniTypes: unknown unit " + std::string(name));
+      }
+      return *unit;
+    }
+
+    double factor_;
+    Dimension dimension_;
+  };
+
+  // Thread-safe cache of ConversionPlans keyed by unit names.
+  //
+  // The cache is a fixed-size open-addressing table of atomic pointers to immutable entries.
+  // Entries are only ever added, with a compare-and-swap into an empty slot, and are freed with
+  // the cache, so readers never wait and never see a partly built entry. Once the table is full,
+  // further pairs are compiled on every call instead of cached.
+  class ConversionPlanCache {
+  public:
+    // std::size_t capacity = 1024, Maximum number of cached pairs. Rounded up to a power of two.
+    explicit ConversionPlanCache(std::size_t capacity = 1024)
+      : mask_(detail::nextPowerOfTwo(capacity < 1 ? 1 : capacity) - 1),
+        slots_(new std::atomic<const Entry*>[mask_ + 1]) {
+      for (std::size_t i = 0; i <= mask_; ++i) {
+        slots_[i].store(nullptr, std::memory_order_relaxed);
+      }
+    }
+
+    ~ConversionPlanCache() {
+      for (std::size_t i = 0; i <= mask_; ++i) {
+        delete slots_[i].load(std::memory_order_relaxed);
+      }
+    }
+
+    ConversionPlanCache(const ConversionPlanCache&) = delete;
+    ConversionPlanCache& operator=(const ConversionPlanCache&) = delete;
+
+    // Plan from from to to, compiled on first use. Throws like ConversionPlan::compile; failed
+    // pairs are not cached.
+    ConversionPlan get(std::string_view from, std::string_view to) {
+      const std::size_t start = static_cast<std::size_t>(hashKey(from, to));
+      for (std::size_t probe = 0; probe <= mask_; ++probe) {
+        std::atomic<const Entry*>& slot = slots_[(start + probe) & mask_];
+        const Entry* entry = slot.load(std::memory_order_acquire);
+        if (entry == nullptr) {
+          return insert(slot, from, to);
+        }
+        if (entry->from == from && entry->to == to) {
+          return entry->plan;
+        }
+      }
+      return ConversionPlan::compile(from, to);
+    }
+
+    // Number of cached pairs.
+    std::size_t size() const {
+      std::size_t count = 0;
+      for (std::size_t i = 0; i <= mask_; ++i) {
+        count += slots_[i].load(std::memory_order_acquire) != nullptr ? 1 : 0;
+      }
+      return count;
+    }
+
+    std::size_t capacity() const { return mask_ + 1; }
+
+  private:
+    struct Entry {
+      std::string from;
+      std::string to;
+      ConversionPlan plan;
+    };
+
+    static std::uint64_t hashKey(std::string_view from, std::string_view to) {
+      return detail::hashString(to, detail::hashString(from, 0));
+    }
+
+    // Compiles the pair and publishes it in slot, or in a later free slot if another thread fills
+    // slot first with a different pair.
+    ConversionPlan insert(std::atomic<const Entry*>& slot, std::string_view from,
+                          std::string_view to) {
+      std::unique_ptr<Entry> entry(
+        new Entry{std::string(from), std::string(to), ConversionPlan::compile(from, to)});
+      const ConversionPlan plan = entry->plan;
+
+      std::atomic<const Entry*>* target = &slot;
+      std::size_t index = static_cast<std::size_t>(target - slots_.get());
+      for (std::size_t probe = 0; probe <= mask_; ++probe) {
+        const Entry* expected = nullptr;
+        if (target->compare_exchange_strong(expected, entry.get(), std::memory_order_acq_rel,
+                                            std::memory_order_acquire)) {
+          entry.release();
+          return plan;
+        }
+        if (expected->from == from && expected->to == to) {
+          return expected->plan;
+        }
+        index = (index + 1) & mask_;
+        target = &slots_[index];
+      }
+      return plan;
+    }
+
+    const std::size_t mask_;
+    std::unique_ptr<std::atomic<const Entry*>[]> slots_;
+  };
+
+  // ------------------------------------------
+  // sharedPlanCache
+  // ------------------------------------------
+  // Process-wide plan cache, for callers that do not need their own.
+  inline ConversionPlanCache& sharedPlanCache() {
+    static ConversionPlanCache cache;
+    return cache;
+  }
+}
@@ -0,0 +1,102 @@
+#pragma once
+#include <uniTypes.h>
+#include <uniTypes/parallel.h>
+#include <uniTypes/quantityVector.h>
+
+#include <cstddef>
+#include <type_traits>
+
+// Batched unit conversion.
+//
+// Converting a column of values from one unit to another is a single multiply by a factor that is
+// computed once per call. Both units must be the same quantity type, so mixing dimensions is a
+// compile error. That includes Number and UOBA: International Units have a base dimension of
+// their own.
+namespace uniTypes {
+  // Elements handled per task when a conversion is split across threads.
+  constexpr std::size_t kConvertGrain = std::size_t(1) << 16;
+
+  // Factor that turns a value expressed in from_unit into one expressed in to_unit.
+  template<typename D, typename R1, typename R2>
+  constexpr double conversionFactor(RatioQuantity<D, R1> from_unit,
+                                    RatioQuantity<D, R2> to_unit)
+  {
+    return static_cast<double>(from_unit.getValue()) / static_cast<double>(to_unit.getValue());
+  }
+
+  namespace detail {
+    // Floating-point reps are scaled in their own precision. Integer reps are scaled in double and
+    // truncated toward zero, as quantityCast does.
+    template<typename Rep>
+    void scaleValues(const Rep* in, std::size_t n, double factor, Rep* out, unsigned threads) {
+      using Scalar = std::conditional_t<std::is_floating_point<Rep>::value, Rep, double>;
+      const Scalar f = static_cast<Scalar>(factor);
+      auto kernel = [f](Rep a) { return static_cast<Rep>(static_cast<Scalar>(a) * f); };
+      if (threads == 1 || n <= kConvertGrain) {
+        transformKernel(in, out, n, kernel);
+        return;
+      }
+      parallelFor(n, kConvertGrain, threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+        transformKernel(in + begin, out + begin, end - begin, kernel);
+      });
+    }
+  }
+
+  // ------------------------------------------
+  // convert
+  // ------------------------------------------
+  // Converts n raw values expressed in from_unit into to_unit, writing them to out. out may be the
+  // same array as in. Works on any arithmetic Rep; float arrays are processed twice as many values
+  // per SIMD instruction as double ones.
+  // unsigned threads = 1, Number of threads to split large inputs across. 0 means all cores.
+  template<typename Rep, typename D, typename R1, typename R2>
+  void convert(const Rep* in, std::size_t n, RatioQuantity<D, R1> from_unit,
+               RatioQuantity<D, R2> to_unit, Rep* out, unsigned threads = 1)
+  {
+    detail::scaleValues(in, n, conversionFactor(from_unit, to_unit), out, threads);
+  }
+
+  // In-place variant of convert.
+  template<typename Rep, typename D, typename R1, typename R2>
+  void convert(Rep* values, std::size_t n, RatioQuantity<D, R1> from_unit,
+               RatioQuantity<D, R2> to_unit, unsigned threads = 1)
+  {
+    detail::scaleValues(values, n, conversionFactor(from_unit, to_unit), values, threads);
+  }
+
+  // ------------------------------------------
+  // convertTo
+  // ------------------------------------------
+  // Writes each quantity of in expressed in multiples of unit to out, the bulk equivalent of
+  // RatioQuantity::convertTo. out must hold in.size() values of the rep of in.
+  template<typename In, typename D, typename R>
+  void convertTo(const In& in, RatioQuantity<D, R> unit,
+                 typename range_quantity_t<In>::rep* out, unsigned threads = 1)
+  {
+    static_assert(std::is_same<range_quantity_t<In>,
+                               with_rep_t<RatioQuantity<D>,
+                                          typename range_quantity_t<In>::rep>>::value,
+                  "Can only convert to a unit of the same dimension");
+    auto values = constSpan(in);
+    detail::scaleValues(values.data(), values.size(), 1.0 / static_cast<double>(unit.getValue()),
+                        out, threads);
+  }
+
+  // ------------------------------------------
+  // convertFrom
+  // ------------------------------------------
+  // Fills out with quantities from raw values expressed in multiples of unit. in must hold
+  // out.size() values of the rep of out.
+  template<typename Out, typename D, typename R>
+  void convertFrom(const typename range_quantity_t<Out>::rep* in, RatioQuantity<D, R> unit,
+                   Out&& out, unsigned threads = 1)
+  {
+    static_assert(std::is_same<range_quantity_t<Out>,
+                               with_rep_t<RatioQuantity<D>,
+                                          typename range_quantity_t<Out>::rep>>::value,
+                  "Can only convert from a unit of the same dimension");
+    auto values = mutableSpan(out);
+    detail::scaleValues(in, values.size(), static_cast<double>(unit.getValue()), values.data(),
+                        threads);
+  }
+}
@@ -0,0 +1,298 @@
+#pragma once
+#include <uniTypes.h>
+#include <uniTypes/parallel.h>
+#include <uniTypes/perfectHash.h>
+#include <uniTypes/quantityVector.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Conversions that depend on what is measured, such as cups of flour to grams or IU of
+// vitamin D to micrograms.
+//
+// Volume and Mass have different dimensions, so turning one into the other takes a density for
+// each ingredient; likewise IU and Mass take a factor for each nutrient. A FactorTable<Q> maps
+// integer ids to such per-item factors, in an array indexed by id for compact ids and a flat hash
+// table otherwise, so a lookup is usually one cache line. multiply and divide convert
+// whole columns of (id, quantity) pairs: they look up a block of factors, then scale the block
+// in a loop the compiler vectorizes. The result types follow from operator* and operator/, so
+// volumes times a DensityTable are Mass and masses divided by it are Volume.
+namespace uniTypes {
+  using Density = quantity_quotient_t<Mass, Volume>;
+  using MassPerIU = quantity_quotient_t<Mass, UOBA>;
+
+  inline constexpr Density gram_per_milliliter = gram / milliliter;
+  inline constexpr Density kilogram_per_liter = kilogram / liter;
+  inline constexpr MassPerIU milligram_per_IU = milligram / IU;
+
+  // Elements handled per task when a FactorTable conversion is split across threads.
+  constexpr std::size_t kFactorGrain = std::size_t(1) << 16;
+
+  // Ids whose factors are looked up before a block is scaled.
+  constexpr std::size_t kFactorBlock = 256;
+
+  // A FactorTable keeps its factors in an array indexed by id while the ids span at most this
+  // many times as many values as there are ids, plus kFactorDenseSlack.
+  constexpr std::size_t kFactorDenseSpread = 4;
+  constexpr std::size_t kFactorDenseSlack = 64;
+
+  // Per-item conversion factors of type Q keyed by integer id, e.g. densities by ingredient.
+  //
+  // Ids that cover a compact range, as database keys usually do, index a plain array of
+  // factors, so a lookup is a subtraction and one load. Once the ids spread out further the
+  // table switches to open addressing with linear probing, at most half full, over slots that
+  // hold each id next to its factor.
+  template<typename Q>
+  class FactorTable {
+  public:
+    using key_type = std::uint64_t;
+    using factor_type = Q;
+    using rep = typename Q::rep;
+
+    // Reserved as the marker of empty slots; cannot be used as an id.
+    static constexpr key_type kEmptyKey = std::numeric_limits<key_type>::max();
+
+    FactorTable() : base_(0), size_(0) {}
+
+    FactorTable(std::initializer_list<std::pair<key_type, Q>> entries) : FactorTable() {
+      for (const auto& entry : entries) {
+        set(entry.first, entry.second);
+      }
+    }
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    // Sets the factor of id, replacing any previous one. Throws std::invalid_argument if id is
+    // kEmptyKey or the factor is not positive and finite.
+    void set(key_type id, Q factor) {
+      if (id == kEmptyKey) {
+        throw std::invalid_argument("uniTypes: factor table id is reserved");
+      }
+      if (!(factor.getValue() > 0) || !std::isfinite(static_cast<double>(factor.getValue()))) {
+        throw std::invalid_argument("uniTypes: factor of id " + std::to_string(id) +
+                                    " must be positive and finite");
+      }
+      if (slots_.empty() && placeDense(id)) {
+        rep& slot = dense_[id - base_];
+        size_ += slot > rep() ? 0 : 1;
+        slot = factor.getValue();
+        return;
+      }
+      if (2 * (size_ + 1) > slots_.size()) {
+        rehash(std::max<std::size_t>(16, 2 * slots_.size()));
+      }
+      Slot& slot = slotFor(id);
+      size_ += slot.id == kEmptyKey ? 1 : 0;
+      slot.id = id;
+      slot.factor = factor.getValue();
+    }
+
+    bool contains(key_type id) const {
+      return findFactor(id) > rep();
+    }
+
+    // Factor of id. Throws std::out_of_range if id has none.
+    Q at(key_type id) const {
+      return Q(checkedFactor(id));
+    }
+
+    // out[i] = in[i] * at(ids[i]), e.g. masses from volumes and ingredient densities. ids must
+    // hold in.size() ids and out must hold in.size() quantities. Throws std::out_of_range for an
+    // id without a factor, in which case out may be partly written.
+    // unsigned threads = 1, Number of threads to split large inputs across. 0 means all cores.
+    template<typename In, typename Out>
+    void multiply(const key_type* ids, const In& in, Out&& out, unsigned threads = 1) const {
+      using Product = quantity_product_t<range_quantity_t<In>, Q>;
+      static_assert(std::is_same<typename range_quantity_t<Out>::dims,
+                                 typename Product::dims>::value,
+                    "Output must have the dimension of input times factor");
+      apply<false>(ids, constSpan(in), mutableSpan(out), threads);
+    }
+
+    // out[i] = in[i] / at(ids[i]), e.g. volumes from masses and ingredient densities. Same
+    // requirements as multiply.
+    template<typename In, typename Out>
+    void divide(const key_type* ids, const In& in, Out&& out, unsigned threads = 1) const {
+      using Quotient = quantity_quotient_t<range_quantity_t<In>, Q>;
+      static_assert(std::is_same<typename range_quantity_t<Out>::dims,
+                                 typename Quotient::dims>::value,
+                    "Output must have the dimension of input divided by factor");
+      apply<true>(ids, constSpan(in), mutableSpan(out), threads);
+    }
+
+  private:
+    struct Slot {
+      key_type id = kEmptyKey;
+      rep factor = rep();
+    };
+
+    // Full 64-bit finalizer. Ids often come in arithmetic sequences, which a single multiply
+    // can map into clusters.
+    static std::uint64_t mixId(std::uint64_t x) {
+      x ^= x >> 33;
+      x *= 0xff51afd7ed558ccdull;
+      x ^= x >> 33;
+      x *= 0xc4ceb9fe1a85ec53ull;
+      x ^= x >> 33;
+      return x;
+    }
+
+    // Widens the dense array to cover id if the ids stay compact enough, and returns whether
+    // id now has a place in it.
+    bool placeDense(key_type id) {
+      if (dense_.empty()) {
+        base_ = id;
+        dense_.assign(1, rep());
+        return true;
+      }
+      const key_type first = std::min(base_, id);
+      const key_type last = std::max<key_type>(base_ + (dense_.size() - 1), id);
+      if (last - first >= kFactorDenseSpread * (size_ + 1) + kFactorDenseSlack) {
+        // Too spread out: move everything to hashed slots with room for id as well.
+        std::vector<rep> dense;
+        dense.swap(dense_);
+        rehash(std::max<std::size_t>(16, detail::nextPowerOfTwo(2 * (size_ + 1))));
+        for (std::size_t i = 0; i < dense.size(); ++i) {
+          if (dense[i] > rep()) {
+            slotFor(base_ + i) = Slot{base_ + i, dense[i]};
+          }
+        }
+        return false;
+      }
+      if (first < base_) {
+        dense_.insert(dense_.begin(), static_cast<std::size_t>(base_ - first), rep());
+        base_ = first;
+      }
+      dense_.resize(static_cast<std::size_t>(last - base_) + 1, rep());
+      return true;
+    }
+
+    // Slot holding id, or the empty slot where it would go. Hashed mode only.
+    Slot& slotFor(key_type id) {
+      const std::size_t mask = slots_.size() - 1;
+      std::size_t index = static_cast<std::size_t>(mixId(id)) & mask;
+      while (slots_[index].id != id && slots_[index].id != kEmptyKey) {
+        index = (index + 1) & mask;
+      }
+      return slots_[index];
+    }
+
+    // Factor of id, or zero if it has none.
+    rep findFactor(key_type id) const {
+      if (!dense_.empty()) {
+        const key_type offset = id - base_;
+        return offset < dense_.size() ? dense_[static_cast<std::size_t>(offset)] : rep();
+      }
+      if (slots_.empty()) {
+        return rep();
+      }
+      const std::size_t mask = slots_.size() - 1;
+      for (std::size_t index = static_cast<std::size_t>(mixId(id)) & mask;;
+           index = (index + 1) & mask) {
+        if (slots_[index].id == id) {
+          return slots_[index].factor;
+        }
+        if (slots_[index].id == kEmptyKey) {
+          return rep();
+        }
+      }
+    }
+
+    rep checkedFactor(key_type id) const {
+      const rep factor = findFactor(id);
+      if (!(factor > rep())) {
+        throw std::out_of_range("uniTypes: no factor for id " + std::to_string(id));
+      }
+      return factor;
+    }
+
+    // Grows the hashed slots to at least capacity, a power of two, keeping their entries.
+    void rehash(std::size_t capacity) {
+      std::vector<Slot> old(capacity);
+      old.swap(slots_);
+      for (const Slot& slot : old) {
+        if (slot.id != kEmptyKey) {
+          slotFor(slot.id) = slot;
+        }
+      }
+    }
+
+    template<bool Divide, typename InQ, typename OutQ>
+    void apply(const key_type* ids, QuantitySpan<const InQ> in, QuantitySpan<OutQ> out,
+               unsigned threads) const {
+      if (out.size() != in.size()) {
+        throw std::invalid_argument("uniTypes: factor table output size differs");
+      }
+      using InRep = typename InQ::rep;
+      using OutRep = typename OutQ::rep;
+      using Scalar = std::common_type_t<InRep, rep, double>;
+      auto kernel = [&](std::size_t, std::size_t begin, std::size_t end) {
+        Scalar factors[kFactorBlock];
+        for (std::size_t block = begin; block < end; block += kFactorBlock) {
+          const std::size_t count = std::min(kFactorBlock, end - block);
+          // Lookups first: plain loads in dense mode, otherwise probes that reuse the factor of
+          // the previous id for runs of one item.
+          if (!dense_.empty()) {
+            const rep* dense = dense_.data();
+            bool missing = false;
+            for (std::size_t i = 0; i < count; ++i) {
+              const key_type offset = ids[block + i] - base_;
+              const bool inside = offset < dense_.size();
+              const rep factor = dense[inside ? offset : 0];
+              missing |= !inside || !(factor > rep());
+              factors[i] = static_cast<Scalar>(factor);
+            }
+            if (missing) {
+              for (std::size_t i = 0; i < count; ++i) {
+                checkedFactor(ids[block + i]);
+              }
+            }
+          } else {
+            key_type previous = kEmptyKey;
+            Scalar factor = Scalar();
+            for (std::size_t i = 0; i < count; ++i) {
+              if (ids[block + i] != previous) {
+                previous = ids[block + i];
+                factor = static_cast<Scalar>(checkedFactor(previous));
+              }
+              factors[i] = factor;
+            }
+          }
+          // Then one multiply or divide per element, which vectorizes.
+          const InRep* x = in.data() + block;
+          OutRep* y = out.data() + block;
+          for (std::size_t i = 0; i < count; ++i) {
+            y[i] = static_cast<OutRep>(Divide ? static_cast<Scalar>(x[i]) / factors[i]
+                                              : static_cast<Scalar>(x[i]) * factors[i]);
+          }
+        }
+      };
+      if (threads == 1 || in.size() <= kFactorGrain) {
+        kernel(0, 0, in.size());
+        return;
+      }
+      detail::parallelFor(in.size(), kFactorGrain, threads, kernel);
+    }
+
+    // Smallest id of the dense array.
+    key_type base_;
+    std::size_t size_;
+    // Factors of ids base_, base_ + 1, ..., zero where there is none. Empty in hashed mode.
+    std::vector<rep> dense_;
+    // Hashed slots, a power of two of them. Empty in dense mode.
+    std::vector<Slot> slots_;
+  };
+
+  using DensityTable = FactorTable<Density>;
+  using IUFactorTable = FactorTable<MassPerIU>;
+}
@@ -0,0 +1,126 @@
+#pragma once
+#include <uniTypes.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+// Runtime representation of the dimension of a quantity.
+namespace uniTypes {
+  // Compact runtime dimension vector. Each exponent is stored as a signed byte in multiples of
+  // 1/kExponentScale, the same scale as the static Dims types, so every static dimension
+  // round-trips exactly.
+  class Dimension {
+  public:
+    static constexpr int kExponentScale = kDimensionScale;
+
+    constexpr Dimension() : exponents{} {}
+
+    // Dimension with integer exponents, in the order of BaseDimension.
+    constexpr Dimension(int mass, int length, int time, int temperature = 0, int amount = 0,
+                        int current = 0, int luminous_intensity = 0, int iu = 0)
+      : exponents{}
+    {
+      const int integer_exponents[kNumBaseDimensions] = {
+        mass, length, time, temperature, amount, current, luminous_intensity, iu};
+      for (std::size_t i = 0; i < kNumBaseDimensions; ++i) {
+        exponents[i] = checked(integer_exponents[i] * kExponentScale);
+      }
+    }
+
+    // Exponent of a base dimension, in multiples of 1/kExponentScale.
+    constexpr int scaledExponent(BaseDimension base) const {
+      return exponents[static_cast<std::size_t>(base)];
+    }
+
+    constexpr double exponent(BaseDimension base) const {
+      return static_cast<double>(scaledExponent(base)) / kExponentScale;
+    }
+
+    constexpr bool isDimensionless() const {
+      for (std::size_t i = 0; i < kNumBaseDimensions; ++i) {
+        if (exponents[i] != 0) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    // Dimension of the product of two quantities.
+    constexpr Dimension operator*(Dimension rhs) const {
+      Dimension result;
+      for (std::size_t i = 0; i < kNumBaseDimensions; ++i) {
+        result.exponents[i] = checked(exponents[i] + rhs.exponents[i]);
+      }
+      return result;
+    }
+
+    // Dimension of the quotient of two quantities.
+    constexpr Dimension operator/(Dimension rhs) const {
+      Dimension result;
+      for (std::size_t i = 0; i < kNumBaseDimensions; ++i) {
+        result.exponents[i] = checked(exponents[i] - rhs.exponents[i]);
+      }
+      return result;
+    }
+
+    // Dimension of a quantity raised to the power num/den, like dims_pow_t. Throws
+    // std::invalid_argument if den is zero or a resulting exponent is not a multiple of
+    // 1/kExponentScale, and std::overflow_error if a resulting exponent is out of range.
+    constexpr Dimension pow(int num, int den = 1) const {
+      if (den == 0) {
+        throw std::invalid_argument("uniTypes: dimension power with a zero denominator");
+      }
+      Dimension result;
+      for (std::size_t i = 0; i < kNumBaseDimensions; ++i) {
+        // In long long, so that any int power of a byte exponent is exact before it is checked.
+        const long long scaled = static_cast<long long>(exponents[i]) * num;
+        if (scaled % den != 0) {
+          throw std::invalid_argument("uniTypes: dimension power is not representable");
+        }
+        result.exponents[i] = checked(scaled / den);
+      }
+      return result;
+    }
+
+    constexpr bool operator==(Dimension rhs) const {
+      for (std::size_t i = 0; i < kNumBaseDimensions; ++i) {
+        if (exponents[i] != rhs.exponents[i]) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    constexpr bool operator!=(Dimension rhs) const {
+      return !(*this == rhs);
+    }
+
+    // Dimension of the static Dims type D.
+    template<typename D>
+    static constexpr Dimension fromDims() {
+      Dimension dimension;
+      for (std::size_t i = 0; i < kNumBaseDimensions; ++i) {
+        dimension.exponents[i] = checked(D::scaled_exponents[i]);
+      }
+      return dimension;
+    }
+
+    std::array<std::int8_t, kNumBaseDimensions> exponents;
+
+  private:
+    static constexpr std::int8_t checked(long long scaled) {
+      if (scaled < INT8_MIN || scaled > INT8_MAX) {
+        throw std::overflow_error("uniTypes: dimension exponent out of range");
+      }
+      return static_cast<std::int8_t>(scaled);
+    }
+  };
+
+  // Runtime dimension of a static quantity type.
+  template<typename Q>
+  constexpr Dimension dimensionOf() {
+    return Dimension::fromDims<typename Q::dims>();
+  }
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// Compile-time dimension of a quantity type.
+//
+// A dimension is a single Dims type holding the exponent of every base dimension as an integer in
+// multiples of 1/kDimensionScale. There is exactly one Dims type per dimension, so equal
+// dimensions reached through any chain of products and quotients are the same type, and combining
+// two dimensions is one pack expansion rather than a std::ratio_add per base dimension.
+namespace uniTypes {
+  // Base dimensions: the seven SI base dimensions and International Units, which measure
+  // biological activity and have no conversion to any SI dimension.
+  enum class BaseDimension : std::size_t {
+    Mass = 0,
+    Length,
+    Time,
+    Temperature,
+    Amount,
+    Current,
+    LuminousIntensity,
+    IU
+  };
+
+  constexpr std::size_t kNumBaseDimensions = 8;
+
+  // Exponents are stored in multiples of 1/kDimensionScale, so halves and thirds (e.g. the
+  // dimension of the square root of an area) can be represented exactly.
+  constexpr int kDimensionScale = 6;
+
+  // This should not be instantiated directly! Instead use dims_t, or the dims of a quantity type.
+  template<int... ScaledExponents>
+  struct Dims {
+    static_assert(sizeof...(ScaledExponents) == kNumBaseDimensions,
+                  "Dims needs one exponent per base dimension");
+
+    static constexpr int scaled_exponents[kNumBaseDimensions] = {ScaledExponents...};
+  };
+
+  // Dims with integer exponents, in the order of BaseDimension.
+  template<int Mass, int Length, int Time, int Temperature = 0, int Amount = 0, int Current = 0,
+           int LuminousIntensity = 0, int IU = 0>
+  using dims_t = Dims<Mass * kDimensionScale, Length * kDimensionScale, Time * kDimensionScale,
+                      Temperature * kDimensionScale, Amount * kDimensionScale,
+                      Current * kDimensionScale, LuminousIntensity * kDimensionScale,
+                      IU * kDimensionScale>;
+
+  namespace detail {
+    template<typename D1, typename D2>
+    struct dims_product;
+
+    template<int... E1, int... E2>
+    struct dims_product<Dims<E1...>, Dims<E2...>> {
+      using type = Dims<(E1 + E2)...>;
+    };
+
+    template<typename D1, typename D2>
+    struct dims_quotient;
+
+    template<int... E1, int... E2>
+    struct dims_quotient<Dims<E1...>, Dims<E2...>> {
+      using type = Dims<(E1 - E2)...>;
+    };
+
+    template<typename D, int Num, int Den>
+    struct dims_pow;
+
+    template<int... E, int Num, int Den>
+    struct dims_pow<Dims<E...>, Num, Den> {
+      static_assert(Den > 0, "Exponent denominator must be positive");
+      static_assert(((E * Num % Den == 0) && ...),
+                    "Exponent is not a multiple of 1/6 and has no representation");
+      using type = Dims<(E * Num / Den)...>;
+    };
+
+    template<BaseDimension Base, std::size_t... I>
+    constexpr auto baseDims(std::index_sequence<I...>) {
+      return Dims<(I == static_cast<std::size_t>(Base) ? kDimensionScale : 0)...>();
+    }
+  }
+
+  // Dimensions of the product and quotient of two quantities, and of a quantity raised to the
+  // power Num / Den.
+  template<typename D1, typename D2>
+  using dims_product_t = typename detail::dims_product<D1, D2>::type;
+
+  template<typename D1, typename D2>
+  using dims_quotient_t = typename detail::dims_quotient<D1, D2>::type;
+
+  template<typename D, int Num, int Den = 1>
+  using dims_pow_t = typename detail::dims_pow<D, Num, Den>::type;
+
+  // Dims of a single base dimension with exponent 1.
+  template<BaseDimension Base>
+  using base_dims_t =
+    decltype(detail::baseDims<Base>(std::make_index_sequence<kNumBaseDimensions>()));
+}
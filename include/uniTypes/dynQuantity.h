@@ -0,0 +1,229 @@
+#pragma once
+#include <uniTypes.h>
+#include <uniTypes/dimension.h>
+
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+// Quantities whose dimension is only known at runtime.
+//
+// A DynQuantity is a value type holding a double and a compact Dimension. It never allocates, so
+// it can be stored in maps and vectors directly. Arithmetic checks dimensions at runtime and
+// conversion back to the static RatioQuantity types is checked as well.
+namespace uniTypes {
+  // Thrown when quantities of incompatible dimensions are combined at runtime.
+  class DimensionMismatch : public std::invalid_argument {
+  public:
+    using std::invalid_argument::invalid_argument;
+  };
+
+  // Quantity types that DynQuantity::createRatio can create.
+  enum class QuantityKind {
+    Number = 1,
+    UOBA,
+    Mass,
+    Length,
+    Area,
+    Volume,
+    Time,
+    Force,
+    Energy
+  };
+
+  class DynQuantity {
+  public:
+    constexpr DynQuantity() : value(0.0), dimension() {}
+    constexpr DynQuantity(double val, Dimension dim) : value(val), dimension(dim) {}
+
+    template<typename D, typename Rep>
+    constexpr DynQuantity(RatioQuantity<D, Rep> quantity)
+      : value(static_cast<double>(quantity.getValue())),
+        dimension(dimensionOf<RatioQuantity<D, Rep>>()) {}
+
+    static DynQuantity createRatio(QuantityKind kind, double val = 0.0);
+    static DynQuantity createRatio(int choice, double val = 0.0);
+
+    // Whether this quantity has the dimension of the static quantity type Q.
+    template<typename Q>
+    constexpr bool is() const {
+      return dimension == dimensionOf<Q>();
+    }
+
+    // Returns the quantity as the static type Q. Throws DimensionMismatch if the dimensions differ.
+    template<typename Q>
+    Q as() const {
+      if (!is<Q>()) {
+        throw DimensionMismatch("uniTypes: quantity does not have the requested dimension");
+      }
+      return Q(value);
+    }
+
+    // Return value of the quantity in multiples of the specified unit. Throws DimensionMismatch if
+    // the unit has a different dimension.
+    double convertTo(DynQuantity unit) const {
+      checkSameDimension(unit);
+      return value / unit.value;
+    }
+
+    DynQuantity& operator+=(DynQuantity rhs) {
+      checkSameDimension(rhs);
+      value += rhs.value;
+      return *this;
+    }
+
+    DynQuantity& operator-=(DynQuantity rhs) {
+      checkSameDimension(rhs);
+      value -= rhs.value;
+      return *this;
+    }
+
+    // Returns the raw value of the quantity.
+    constexpr double getValue() const {
+      return value;
+    }
+
+    constexpr Dimension getDimension() const {
+      return dimension;
+    }
+
+    void checkSameDimension(DynQuantity rhs) const {
+      if (dimension != rhs.dimension) {
+        throw DimensionMismatch("uniTypes: quantities have different dimensions");
+      }
+    }
+
+    double value;
+    Dimension dimension;
+  };
+
+  static_assert(sizeof(DynQuantity) == 2 * sizeof(double), "DynQuantity should stay compact");
+  static_assert(std::is_trivially_copyable<DynQuantity>::value,
+                "DynQuantity must be trivially copyable");
+
+  // ------------------------------------------
+  // DynQuantity::createRatio
+  // ------------------------------------------
+  // Factory method for creating a DynQuantity of one of the predefined quantity types.
+  // QuantityKind kind, Quantity type to create.
+  // double val = 0.0, Value (in SI units) that the quantity is constructed with.
+  inline DynQuantity DynQuantity::createRatio(QuantityKind kind, double val) {
+    switch(kind) {
+      case QuantityKind::Number: return Number(val);
+      case QuantityKind::UOBA: return UOBA(val);
+      case QuantityKind::Mass: return Mass(val);
+      case QuantityKind::Length: return Length(val);
+      case QuantityKind::Area: return Area(val);
+      case QuantityKind::Volume: return Volume(val);
+      case QuantityKind::Time: return Time(val);
+      case QuantityKind::Force: return Force(val);
+      case QuantityKind::Energy: return Energy(val);
+    }
+    throw std::invalid_argument("uniTypes: unknown quantity kind");
+  }
+
+  // int choice, Integer value of a QuantityKind:
+  //    + 1 - Number
+  //    + 2 - UOBA
+  //    + 3 - Mass
+  //    + 4 - Length
+  //    + 5 - Area
+  //    + 6 - Volume
+  //    + 7 - Time
+  //    + 8 - Force
+  //    + 9 - Energy
+  // Throws std::invalid_argument for any other choice.
+  inline DynQuantity DynQuantity::createRatio(int choice, double val) {
+    if (choice < static_cast<int>(QuantityKind::Number) ||
+        choice > static_cast<int>(QuantityKind::Energy)) {
+      throw std::invalid_argument("uniTypes: unknown quantity choice " + std::to_string(choice));
+    }
+    return createRatio(static_cast<QuantityKind>(choice), val);
+  }
+
+  namespace detail {
+    // Operand types of the runtime operators below. One of them must already be a DynQuantity, so
+    // two static quantities of different dimensions never meet there and stay a compile error.
+    template<typename L, typename R>
+    using enable_dyn_operands_t = std::enable_if_t<
+      (std::is_same<L, DynQuantity>::value || std::is_same<R, DynQuantity>::value) &&
+      std::is_convertible<L, DynQuantity>::value && std::is_convertible<R, DynQuantity>::value>;
+  }
+
+  // Runtime arithmetic operators. Addition, subtraction and comparisons throw DimensionMismatch
+  // when the dimensions differ; multiplication and division combine them. A static quantity on
+  // either side is converted to a DynQuantity.
+  template<typename L, typename R, typename = detail::enable_dyn_operands_t<L, R>>
+  inline DynQuantity operator+(L lhs, R rhs) {
+    DynQuantity sum(lhs);
+    return sum += DynQuantity(rhs);
+  }
+
+  template<typename L, typename R, typename = detail::enable_dyn_operands_t<L, R>>
+  inline DynQuantity operator-(L lhs, R rhs) {
+    DynQuantity difference(lhs);
+    return difference -= DynQuantity(rhs);
+  }
+
+  template<typename L, typename R, typename = detail::enable_dyn_operands_t<L, R>>
+  constexpr DynQuantity operator*(L lhs, R rhs) {
+    const DynQuantity l(lhs);
+    const DynQuantity r(rhs);
+    return DynQuantity(l.value * r.value, l.dimension * r.dimension);
+  }
+
+  template<typename L, typename R, typename = detail::enable_dyn_operands_t<L, R>>
+  constexpr DynQuantity operator/(L lhs, R rhs) {
+    const DynQuantity l(lhs);
+    const DynQuantity r(rhs);
+    return DynQuantity(l.value / r.value, l.dimension / r.dimension);
+  }
+
+  constexpr DynQuantity operator*(double lhs, DynQuantity rhs) {
+    return DynQuantity(lhs * rhs.value, rhs.dimension);
+  }
+
+  constexpr DynQuantity operator*(DynQuantity lhs, double rhs) {
+    return DynQuantity(lhs.value * rhs, lhs.dimension);
+  }
+
+  constexpr DynQuantity operator/(DynQuantity lhs, double rhs) {
+    return DynQuantity(lhs.value / rhs, lhs.dimension);
+  }
+
+  template<typename L, typename R, typename = detail::enable_dyn_operands_t<L, R>>
+  inline bool operator==(L lhs, R rhs) {
+    const DynQuantity l(lhs);
+    const DynQuantity r(rhs);
+    l.checkSameDimension(r);
+    return l.value == r.value;
+  }
+
+  template<typename L, typename R, typename = detail::enable_dyn_operands_t<L, R>>
+  inline bool operator!=(L lhs, R rhs) {
+    return !(lhs == rhs);
+  }
+
+  template<typename L, typename R, typename = detail::enable_dyn_operands_t<L, R>>
+  inline bool operator<(L lhs, R rhs) {
+    const DynQuantity l(lhs);
+    const DynQuantity r(rhs);
+    l.checkSameDimension(r);
+    return l.value < r.value;
+  }
+
+  template<typename L, typename R, typename = detail::enable_dyn_operands_t<L, R>>
+  inline bool operator>(L lhs, R rhs) {
+    return rhs < lhs;
+  }
+
+  template<typename L, typename R, typename = detail::enable_dyn_operands_t<L, R>>
+  inline bool operator<=(L lhs, R rhs) {
+    return !(rhs < lhs);
+  }
+
+  template<typename L, typename R, typename = detail::enable_dyn_operands_t<L, R>>
+  inline bool operator>=(L lhs, R rhs) {
+    return !(lhs < rhs);
+  }
+}
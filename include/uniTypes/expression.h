@@ -0,0 +1,280 @@
+#pragma once
+#include <uniTypes.h>
+#include <uniTypes/quantityVector.h>
+
+#include <cstddef>
+#include <type_traits>
+
+// Lazy element-wise arithmetic over quantity ranges.
+//
+// Applying +, -, * or / to a QuantityVector or QuantitySpan does not compute anything. It builds a
+// small expression object recording the operands, and its quantity type is worked out at compile
+// time from the scalar operators (and so from dims_product_t / dims_quotient_t). The whole
+// expression is then computed in a single loop when it is assigned to a QuantityVector or passed
+// to evaluate(), so `density * volume + tare` reads each input once and writes the output once
+// instead of going through a full-size temporary per operator.
+//
+// Expressions hold pointers into their operands and must be evaluated before those go away.
+namespace uniTypes {
+  namespace detail {
+    // Size reported by operands that broadcast a single value to every element.
+    constexpr std::size_t kBroadcastSize = static_cast<std::size_t>(-1);
+
+    // Contiguous range operand.
+    template<typename Q>
+    class RangeOperand {
+    public:
+      using quantity_type = Q;
+      using rep = typename Q::rep;
+
+      explicit RangeOperand(QuantitySpan<const Q> range)
+        : data_(range.data()), size_(range.size()) {}
+
+      std::size_t size() const { return size_; }
+      rep operator[](std::size_t i) const { return data_[i]; }
+
+    private:
+      const rep* data_;
+      std::size_t size_;
+    };
+
+    // Single quantity (or plain number) applied to every element.
+    template<typename Q>
+    class ScalarOperand {
+    public:
+      using quantity_type = Q;
+      using rep = typename Q::rep;
+
+      explicit ScalarOperand(Q value) : value_(value.getValue()) {}
+
+      std::size_t size() const { return kBroadcastSize; }
+      rep operator[](std::size_t) const { return value_; }
+
+    private:
+      rep value_;
+    };
+
+    // Result of adding or subtracting two quantities of the same dimension.
+    template<typename Q1, typename Q2>
+    using quantity_sum_t = with_rep_t<Q1, std::common_type_t<typename Q1::rep, typename Q2::rep>>;
+
+    struct AddOp {
+      template<typename Q1, typename Q2>
+      struct result {
+        static_assert(is_same_dimension<Q1, Q2>::value,
+                      "Only quantities of the same dimension can be added");
+        using type = quantity_sum_t<Q1, Q2>;
+      };
+
+      template<typename A, typename B>
+      static auto apply(A a, B b) { return a + b; }
+    };
+
+    struct SubtractOp {
+      template<typename Q1, typename Q2>
+      struct result {
+        static_assert(is_same_dimension<Q1, Q2>::value,
+                      "Only quantities of the same dimension can be subtracted");
+        using type = quantity_sum_t<Q1, Q2>;
+      };
+
+      template<typename A, typename B>
+      static auto apply(A a, B b) { return a - b; }
+    };
+
+    struct MultiplyOp {
+      template<typename Q1, typename Q2>
+      struct result {
+        using type = quantity_product_t<Q1, Q2>;
+      };
+
+      template<typename A, typename B>
+      static auto apply(A a, B b) { return a * b; }
+    };
+
+    struct DivideOp {
+      template<typename Q1, typename Q2>
+      struct result {
+        using type = quantity_quotient_t<Q1, Q2>;
+      };
+
+      template<typename A, typename B>
+      static auto apply(A a, B b) { return a / b; }
+    };
+
+    inline std::size_t combinedSize(std::size_t lhs, std::size_t rhs) {
+      if (lhs == kBroadcastSize) {
+        return rhs;
+      }
+      if (rhs != kBroadcastSize) {
+        checkSizes(lhs, rhs);
+      }
+      return lhs;
+    }
+  }
+
+  // Element-wise lhs `Op` rhs. Built by the operators below rather than by hand.
+  template<typename Op, typename Lhs, typename Rhs>
+  class QuantityExpr {
+  public:
+    using quantity_type = typename Op::template result<typename Lhs::quantity_type,
+                                                       typename Rhs::quantity_type>::type;
+    using rep = typename quantity_type::rep;
+
+    QuantityExpr(Lhs lhs, Rhs rhs)
+      : lhs_(lhs), rhs_(rhs), size_(detail::combinedSize(lhs.size(), rhs.size())) {}
+
+    std::size_t size() const { return size_; }
+
+    rep operator[](std::size_t i) const { return Op::apply(lhs_[i], rhs_[i]); }
+
+    // Writes every element to out[0, size()). out may alias an operand.
+    template<typename OutRep>
+    void evaluateInto(OutRep* out) const {
+      // Work on a local copy so the compiler can see that out does not overlap the expression
+      // object itself, and vectorize the loop.
+      const QuantityExpr expr = *this;
+      const std::size_t n = size_;
+      for (std::size_t i = 0; i < n; ++i) {
+        out[i] = static_cast<OutRep>(expr[i]);
+      }
+    }
+
+  private:
+    Lhs lhs_;
+    Rhs rhs_;
+    std::size_t size_;
+  };
+
+  namespace detail {
+    template<typename Op, typename Lhs, typename Rhs>
+    struct is_quantity_expression<QuantityExpr<Op, Lhs, Rhs>> : std::true_type {};
+
+    template<typename T>
+    struct is_ratio_quantity : std::false_type {};
+
+    template<typename D, typename Rep>
+    struct is_ratio_quantity<RatioQuantity<D, Rep>> : std::true_type {};
+
+    // Ranges and expressions are element-wise operands; quantities and numbers are broadcast.
+    template<typename T>
+    struct is_elementwise_operand
+      : std::integral_constant<bool, range_traits<T>::is_range ||
+                                     is_quantity_expression<std::decay_t<T>>::value> {};
+
+    template<typename T>
+    struct is_broadcast_operand
+      : std::integral_constant<bool, is_ratio_quantity<std::decay_t<T>>::value ||
+                                     std::is_arithmetic<std::decay_t<T>>::value> {};
+
+    // At least one side must be element-wise so the scalar operators in uniTypes.h are not hidden.
+    template<typename Lhs, typename Rhs>
+    using enable_if_elementwise_t = std::enable_if_t<
+      (is_elementwise_operand<Lhs>::value && (is_elementwise_operand<Rhs>::value ||
+                                             is_broadcast_operand<Rhs>::value)) ||
+      (is_broadcast_operand<Lhs>::value && is_elementwise_operand<Rhs>::value)>;
+
+    template<typename Q>
+    RangeOperand<Q> toOperand(const QuantityVector<Q>& range) { return RangeOperand<Q>(range); }
+
+    template<typename Q>
+    RangeOperand<std::remove_const_t<Q>> toOperand(QuantitySpan<Q> range) {
+      return RangeOperand<std::remove_const_t<Q>>(range);
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    QuantityExpr<Op, Lhs, Rhs> toOperand(const QuantityExpr<Op, Lhs, Rhs>& expr) { return expr; }
+
+    template<typename D, typename Rep>
+    ScalarOperand<RatioQuantity<D, Rep>> toOperand(RatioQuantity<D, Rep> value) {
+      return ScalarOperand<RatioQuantity<D, Rep>>(value);
+    }
+
+    // Operand for value when the other side of the operator is an Other. A plain number takes the
+    // rep of the other side, so `floats * 2.0` stays a float expression, unless that would turn a
+    // fractional factor into an integer.
+    template<typename Other, typename T, std::enable_if_t<std::is_arithmetic<T>::value, int> = 0>
+    auto toOperandBeside(T value) {
+      using OtherRep = typename decltype(toOperand(std::declval<const Other&>()))::rep;
+      using Rep = std::conditional_t<std::is_floating_point<OtherRep>::value ||
+                                     std::is_integral<T>::value, OtherRep, T>;
+      return ScalarOperand<with_rep_t<Number, Rep>>(static_cast<Rep>(value));
+    }
+
+    template<typename Other, typename T, std::enable_if_t<!std::is_arithmetic<T>::value, int> = 0>
+    auto toOperandBeside(const T& value) {
+      return toOperand(value);
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    auto makeExpr(const Lhs& lhs, const Rhs& rhs) {
+      using LhsOperand = decltype(toOperandBeside<Rhs>(lhs));
+      using RhsOperand = decltype(toOperandBeside<Lhs>(rhs));
+      return QuantityExpr<Op, LhsOperand, RhsOperand>(toOperandBeside<Rhs>(lhs),
+                                                      toOperandBeside<Lhs>(rhs));
+    }
+  }
+
+  // ------------------------------------------
+  // Element-wise operators
+  // ------------------------------------------
+  // Each operand is a QuantityVector, QuantitySpan or expression, or a single quantity or number
+  // that is applied to every element. Mismatched dimensions fail to compile; mismatched sizes
+  // throw std::invalid_argument.
+  template<typename Lhs, typename Rhs, typename = detail::enable_if_elementwise_t<Lhs, Rhs>>
+  auto operator+(const Lhs& lhs, const Rhs& rhs) {
+    return detail::makeExpr<detail::AddOp>(lhs, rhs);
+  }
+
+  template<typename Lhs, typename Rhs, typename = detail::enable_if_elementwise_t<Lhs, Rhs>>
+  auto operator-(const Lhs& lhs, const Rhs& rhs) {
+    return detail::makeExpr<detail::SubtractOp>(lhs, rhs);
+  }
+
+  template<typename Lhs, typename Rhs, typename = detail::enable_if_elementwise_t<Lhs, Rhs>>
+  auto operator*(const Lhs& lhs, const Rhs& rhs) {
+    return detail::makeExpr<detail::MultiplyOp>(lhs, rhs);
+  }
+
+  template<typename Lhs, typename Rhs, typename = detail::enable_if_elementwise_t<Lhs, Rhs>>
+  auto operator/(const Lhs& lhs, const Rhs& rhs) {
+    return detail::makeExpr<detail::DivideOp>(lhs, rhs);
+  }
+
+  template<typename Operand,
+           typename = std::enable_if_t<detail::is_elementwise_operand<Operand>::value>>
+  auto operator-(const Operand& operand) {
+    return detail::makeExpr<detail::MultiplyOp>(-1, operand);
+  }
+
+  // ------------------------------------------
+  // evaluate
+  // ------------------------------------------
+  // Computes expr into out, a QuantityVector or QuantitySpan of the same size and dimension, in a
+  // single pass. out may also appear in expr. As for single quantities, out may have a different
+  // floating-point rep than expr.
+  template<typename Expr, typename Out,
+           typename = std::enable_if_t<detail::is_quantity_expression<Expr>::value>>
+  void evaluate(const Expr& expr, Out&& out) {
+    static_assert(detail::is_assignable_quantity<typename Expr::quantity_type,
+                                                 range_quantity_t<Out>>::value,
+                  "Output range must have the dimension of the expression");
+    auto o = mutableSpan(out);
+    detail::checkSizes(expr.size(), o.size());
+    expr.evaluateInto(o.data());
+  }
+
+  template<typename Q, typename Expr,
+           typename = std::enable_if_t<detail::is_quantity_expression<Expr>::value>>
+  QuantityVector<Q>& operator+=(QuantityVector<Q>& lhs, const Expr& rhs) {
+    evaluate(lhs + rhs, lhs);
+    return lhs;
+  }
+
+  template<typename Q, typename Expr,
+           typename = std::enable_if_t<detail::is_quantity_expression<Expr>::value>>
+  QuantityVector<Q>& operator-=(QuantityVector<Q>& lhs, const Expr& rhs) {
+    evaluate(lhs - rhs, lhs);
+    return lhs;
+  }
+}
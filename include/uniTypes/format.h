@@ -0,0 +1,330 @@
+#pragma once
+#include <uniTypes.h>
+#include <uniTypes/dimension.h>
+#include <uniTypes/dynQuantity.h>
+#include <uniTypes/quantityVector.h>
+
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <ostream>
+#include <string_view>
+#include <system_error>
+
+// Human-readable formatting of quantities.
+//
+// A quantity is printed in the unit of a UnitFamily that needs the fewest significant digits, e.g.
+// 1.5 kg rather than 1500 g, and 250 g rather than 0.25 kg. Ties go to the unit that puts the
+// number in [1, 1000), then to the larger unit (1 m rather than 100 cm). Formatting is done with
+// std::to_chars into caller-provided buffers and never allocates.
+//
+// IU is not in the built-in families: UOBA values have a base dimension of their own and are
+// printed in IU as their base unit.
+namespace uniTypes {
+  // Significant digits printed at most. Values are rounded to this many digits before the digits
+  // are counted, so conversion noise such as 12.499999999999998 prints as 12.5. Must stay below
+  // the 18 digits a long long holds.
+  constexpr int kFormatPrecision = 12;
+
+  // Enough for any single quantity: a 12-digit number in scientific notation, then all eight base
+  // units with fractional exponents such as "mol^-0.16666666666666666".
+  constexpr std::size_t kMaxFormattedChars = 256;
+
+  struct FormatUnit {
+    std::string_view symbol;
+    // Value of one of this unit in SI units.
+    double factor;
+    Dimension dimension;
+  };
+
+  // A list of units to choose from when formatting.
+  class UnitFamily {
+  public:
+    template<std::size_t N>
+    constexpr UnitFamily(const FormatUnit (&units)[N]) : begin_(units), end_(units + N) {}
+
+    constexpr UnitFamily(const FormatUnit* begin, const FormatUnit* end)
+      : begin_(begin), end_(end) {}
+
+    constexpr const FormatUnit* begin() const { return begin_; }
+    constexpr const FormatUnit* end() const { return end_; }
+
+  private:
+    const FormatUnit* begin_;
+    const FormatUnit* end_;
+  };
+
+  namespace detail {
+    template<typename Q>
+    constexpr FormatUnit formatUnit(std::string_view symbol, Q unit) {
+      return FormatUnit{symbol, unit.getValue(), dimensionOf<Q>()};
+    }
+  }
+
+  inline constexpr FormatUnit metric_units[] = {
+    detail::formatUnit("mg", milligram), detail::formatUnit("g", gram),
+    detail::formatUnit("kg", kilogram), detail::formatUnit("t", ton),
+    detail::formatUnit("mm", millimeter), detail::formatUnit("cm", centimeter),
+    detail::formatUnit("m", meter), detail::formatUnit("km", kilometer),
+    detail::formatUnit("mm2", millimeter2), detail::formatUnit("cm2", centimeter2),
+    detail::formatUnit("m2", meter2), detail::formatUnit("km2", kilometer2),
+    detail::formatUnit("ml", milliliter), detail::formatUnit("l", liter),
+    detail::formatUnit("m3", meter3),
+    detail::formatUnit("ns", nanosecond), detail::formatUnit("us", microsecond),
+    detail::formatUnit("ms", millisecond), detail::formatUnit("s", second),
+    detail::formatUnit("min", minute), detail::formatUnit("h", hour),
+    detail::formatUnit("mN", millinewton), detail::formatUnit("N", newton),
+    detail::formatUnit("kN", kilonewton), detail::formatUnit("MN", meganewton),
+    detail::formatUnit("J", joule), detail::formatUnit("kJ", kilojoule),
+    detail::formatUnit("MJ", megajoule)
+  };
+
+  inline constexpr FormatUnit us_customary_units[] = {
+    detail::formatUnit("oz", ounce), detail::formatUnit("lb", pound),
+    detail::formatUnit("in", inch), detail::formatUnit("ft", foot),
+    detail::formatUnit("yd", yard), detail::formatUnit("mi", mile),
+    detail::formatUnit("in2", inch2), detail::formatUnit("ft2", foot2),
+    detail::formatUnit("yd2", yard2), detail::formatUnit("mi2", mile2),
+    detail::formatUnit("tsp", teaspoon), detail::formatUnit("tbsp", tablespoon),
+    detail::formatUnit("fl oz", floz), detail::formatUnit("cup", cup),
+    detail::formatUnit("qt", quart), detail::formatUnit("gal", gallon),
+    detail::formatUnit("ns", nanosecond), detail::formatUnit("us", microsecond),
+    detail::formatUnit("ms", millisecond), detail::formatUnit("s", second),
+    detail::formatUnit("min", minute), detail::formatUnit("h", hour),
+    detail::formatUnit("lbf", poundforce),
+    detail::formatUnit("kcal", kilocalorie), detail::formatUnit("btu", btu)
+  };
+
+  namespace detail {
+    inline std::to_chars_result writeNumber(char* first, char* last, double value) {
+      return std::to_chars(first, last, value, std::chars_format::general, kFormatPrecision);
+    }
+
+    // Number of significant digits writeNumber prints for value. Computed arithmetically, since
+    // bestUnit calls this for every candidate unit and to_chars with a precision is much slower.
+    // The scaling multiply can round a value sitting almost exactly halfway between two
+    // 12-digit numbers the other way, which only affects which unit wins a tie.
+    inline int significantDigits(double value) {
+      static constexpr double powers_of_ten[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+      };
+      const double magnitude = std::fabs(value);
+      if (magnitude == 0.0 || !std::isfinite(magnitude)) {
+        return 1;
+      }
+      // Scale to a kFormatPrecision-digit integer.
+      const int shift = kFormatPrecision - 1 - static_cast<int>(std::floor(std::log10(magnitude)));
+      const int abs_shift = shift < 0 ? -shift : shift;
+      const double power = abs_shift <= 22 ? powers_of_ten[abs_shift] : std::pow(10.0, abs_shift);
+      long long mantissa = std::llround(shift < 0 ? magnitude / power : magnitude * power);
+
+      int digits = kFormatPrecision;
+      while (mantissa != 0 && mantissa % 10 == 0) {
+        mantissa /= 10;
+        --digits;
+      }
+      return digits < 1 ? 1 : digits;
+    }
+
+    inline bool inPreferredRange(double value) {
+      const double magnitude = std::fabs(value);
+      return magnitude >= 1.0 && magnitude < 1000.0;
+    }
+
+    // Writes the SI base unit of dimension, e.g. "kg*m^2*s^-2", for dimensions without a unit in
+    // the family.
+    inline char* writeBaseUnit(char* first, char* last, Dimension dimension) {
+      static constexpr std::string_view symbols[kNumBaseDimensions] = {
+        "kg", "m", "s", "K", "mol", "A", "cd", "IU"};
+      bool separator = false;
+      for (std::size_t i = 0; i < kNumBaseDimensions; ++i) {
+        const int scaled = dimension.exponents[i];
+        if (scaled == 0) {
+          continue;
+        }
+        const std::size_t needed = symbols[i].size() + (separator ? 1 : 0);
+        if (static_cast<std::size_t>(last - first) < needed) {
+          return nullptr;
+        }
+        if (separator) {
+          *first++ = '*';
+        }
+        for (char c : symbols[i]) {
+          *first++ = c;
+        }
+        separator = true;
+        if (scaled == Dimension::kExponentScale) {
+          continue;
+        }
+        if (first == last) {
+          return nullptr;
+        }
+        *first++ = '^';
+        const double exponent = static_cast<double>(scaled) / Dimension::kExponentScale;
+        const std::to_chars_result result = std::to_chars(first, last, exponent);
+        if (result.ec != std::errc()) {
+          return nullptr;
+        }
+        first = result.ptr;
+      }
+      return first;
+    }
+
+    inline std::to_chars_result writeQuantity(char* first, char* last, double value_in_unit,
+                                              const FormatUnit* unit, Dimension dimension)
+    {
+      const std::to_chars_result number = writeNumber(first, last, value_in_unit);
+      if (number.ec != std::errc()) {
+        return {last, std::errc::value_too_large};
+      }
+      char* end = number.ptr;
+      if (unit == nullptr && dimension.isDimensionless()) {
+        return {end, std::errc()};
+      }
+      if (end == last) {
+        return {last, std::errc::value_too_large};
+      }
+      *end++ = ' ';
+      if (unit == nullptr) {
+        end = writeBaseUnit(end, last, dimension);
+        return end == nullptr ? std::to_chars_result{last, std::errc::value_too_large}
+                              : std::to_chars_result{end, std::errc()};
+      }
+      if (static_cast<std::size_t>(last - end) < unit->symbol.size()) {
+        return {last, std::errc::value_too_large};
+      }
+      for (char c : unit->symbol) {
+        *end++ = c;
+      }
+      return {end, std::errc()};
+    }
+  }
+
+  // ------------------------------------------
+  // bestUnit
+  // ------------------------------------------
+  // Unit of family that expresses quantity with the fewest significant digits, or nullptr if the
+  // family has no unit of that dimension. See the top of this file for how ties are broken.
+  inline const FormatUnit* bestUnit(DynQuantity quantity, UnitFamily family) {
+    const FormatUnit* best = nullptr;
+    int best_digits = 0;
+    bool best_in_range = false;
+    for (const FormatUnit& unit : family) {
+      if (unit.dimension != quantity.getDimension()) {
+        continue;
+      }
+      const double value = quantity.getValue() / unit.factor;
+      const int digits = detail::significantDigits(value);
+      const bool in_range = detail::inPreferredRange(value);
+      if (best == nullptr || digits < best_digits ||
+          (digits == best_digits && in_range && !best_in_range) ||
+          (digits == best_digits && in_range == best_in_range && unit.factor > best->factor)) {
+        best = &unit;
+        best_digits = digits;
+        best_in_range = in_range;
+      }
+    }
+    return best;
+  }
+
+  // ------------------------------------------
+  // formatQuantity
+  // ------------------------------------------
+  // Writes quantity as "<number> <unit>" into [first, last) using the best unit of family.
+  // Returns the end of the written text, or std::errc::value_too_large if it does not fit.
+  inline std::to_chars_result formatQuantity(char* first, char* last, DynQuantity quantity,
+                                             UnitFamily family = metric_units)
+  {
+    const FormatUnit* unit = bestUnit(quantity, family);
+    const double value = unit == nullptr ? quantity.getValue() : quantity.getValue() / unit->factor;
+    return detail::writeQuantity(first, last, value, unit, quantity.getDimension());
+  }
+
+  // ------------------------------------------
+  // bestColumnUnit
+  // ------------------------------------------
+  // Single unit of family for a whole column: the one needing the fewest significant digits in
+  // total over (a sample of up to max_samples evenly spaced) values, ties going to the unit that
+  // puts the most values in [1, 1000) and then to the larger unit.
+  template<typename Range>
+  const FormatUnit* bestColumnUnit(const Range& range, UnitFamily family,
+                                   std::size_t max_samples = 256)
+  {
+    using Q = range_quantity_t<Range>;
+    const auto values = constSpan(range);
+    const Dimension dimension = dimensionOf<Q>();
+    const std::size_t stride = values.size() <= max_samples ? 1 : values.size() / max_samples;
+
+    const FormatUnit* best = nullptr;
+    std::size_t best_digits = 0;
+    std::size_t best_in_range = 0;
+    for (const FormatUnit& unit : family) {
+      if (unit.dimension != dimension) {
+        continue;
+      }
+      std::size_t digits = 0;
+      std::size_t in_range = 0;
+      for (std::size_t i = 0; i < values.size(); i += stride) {
+        const double value = values.data()[i] / unit.factor;
+        if (std::isnan(value)) {
+          continue;
+        }
+        digits += static_cast<std::size_t>(detail::significantDigits(value));
+        in_range += detail::inPreferredRange(value) ? 1 : 0;
+      }
+      if (best == nullptr || digits < best_digits ||
+          (digits == best_digits && in_range > best_in_range) ||
+          (digits == best_digits && in_range == best_in_range && unit.factor > best->factor)) {
+        best = &unit;
+        best_digits = digits;
+        best_in_range = in_range;
+      }
+    }
+    return best;
+  }
+
+  // ------------------------------------------
+  // formatColumn
+  // ------------------------------------------
+  // Writes every value of range in one unit chosen by bestColumnUnit, each followed by
+  // separator, into [first, last). Returns the end of the written text, or
+  // std::errc::value_too_large (with ptr pointing past the last complete value) if the buffer is
+  // too small.
+  template<typename Range>
+  std::to_chars_result formatColumn(char* first, char* last, const Range& range,
+                                    UnitFamily family = metric_units, char separator = '\n')
+  {
+    using Q = range_quantity_t<Range>;
+    const auto values = constSpan(range);
+    const FormatUnit* unit = bestColumnUnit(range, family);
+    const double factor = unit == nullptr ? 1.0 : unit->factor;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      const std::to_chars_result result =
+        detail::writeQuantity(first, last, values.data()[i] / factor, unit, dimensionOf<Q>());
+      if (result.ec != std::errc() || result.ptr == last) {
+        return {first, std::errc::value_too_large};
+      }
+      first = result.ptr;
+      *first++ = separator;
+    }
+    return {first, std::errc()};
+  }
+
+  // Stream output in the best metric unit. Sets failbit if the text does not fit in
+  // kMaxFormattedChars.
+  inline std::ostream& operator<<(std::ostream& os, DynQuantity quantity) {
+    char buffer[kMaxFormattedChars];
+    const std::to_chars_result result = formatQuantity(buffer, buffer + sizeof(buffer), quantity);
+    if (result.ec != std::errc()) {
+      os.setstate(std::ios_base::failbit);
+      return os;
+    }
+    return os.write(buffer, result.ptr - buffer);
+  }
+
+  template<typename D, typename Rep>
+  std::ostream& operator<<(std::ostream& os, RatioQuantity<D, Rep> quantity) {
+    return os << DynQuantity(quantity);
+  }
+}
@@ -0,0 +1,457 @@
+#pragma once
+#include <uniTypes/dimension.h>
+#include <uniTypes/dynQuantity.h>
+#include <uniTypes/mappedFile.h>
+#include <uniTypes/parallel.h>
+#include <uniTypes/quantityVector.h>
+#include <uniTypes/unitParser.h>
+#include <uniTypes/unitRegistry.h>
+#include <uniTypes/unitTable.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Ingestion of unit-annotated CSV/TSV files into quantity columns.
+//
+// Cells either carry their own unit ("250 g", "1.5 cup") or are bare numbers in a unit declared in
+// the column header ("weight (g)" or "weight [g]"). Every value is normalized to SI as it is
+// parsed. The file is memory-mapped and split into line-aligned chunks that are parsed in
+// parallel; with streamFile() only a bounded number of chunks is held in memory at any time, so
+// files larger than RAM can be processed.
+//
+// Cells that cannot be parsed or that have the wrong dimension for their column never stop the
+// load: they are stored as NaN and counted in the column's ColumnReport.
+//
+// Fields are split on the delimiter only; quoted fields may be wrapped in double quotes but must
+// not contain the delimiter or line breaks.
+namespace uniTypes {
+  struct IngestOptions {
+    // Field delimiter, ',' for CSV and '\t' for TSV.
+    char delimiter = ',';
+    // Whether the first line holds column names (and optionally units).
+    bool has_header = true;
+    // Approximate number of bytes parsed per task.
+    std::size_t chunk_bytes = std::size_t(1) << 20;
+    // Number of threads to parse with. 0 means all cores.
+    unsigned threads = 0;
+    // Maximum number of parsed chunks held in memory by streamFile. 0 means twice the threads.
+    std::size_t max_chunks_in_flight = 0;
+    // Number of leading rows inspected to find the dimension of columns without a header unit.
+    std::size_t dimension_scan_rows = 64;
+  };
+
+  // Per-column outcome of a load.
+  struct ColumnReport {
+    static constexpr std::size_t kNoError = std::numeric_limits<std::size_t>::max();
+
+    std::string name;
+    Dimension dimension;
+    // False for columns in which no cell could be read as a quantity (e.g. free text). Such
+    // columns are skipped and have no QuantityColumn.
+    bool is_quantity = false;
+    std::size_t missing = 0;
+    std::size_t parse_errors = 0;
+    std::size_t dimension_mismatches = 0;
+    // Zero-based data row of the first parse error or dimension mismatch.
+    std::size_t first_error_row = kNoError;
+  };
+
+  // SI values of one quantity column. Unreadable cells are NaN.
+  struct QuantityColumn {
+    std::string name;
+    Dimension dimension;
+    std::vector<double, AlignedAllocator<double>> values;
+
+    // Typed view of the column. Throws DimensionMismatch if the column has another dimension.
+    template<typename Q>
+    QuantitySpan<const Q> as() const {
+      static_assert(std::is_same<typename Q::rep, double>::value, "Columns are stored as double");
+      if (dimension != dimensionOf<Q>()) {
+        throw DimensionMismatch("uniTypes: column " + name + " does not have the requested dimension");
+      }
+      return QuantitySpan<const Q>(values.data(), values.size());
+    }
+  };
+
+  // A run of consecutive rows handed to the streamFile callback.
+  struct RecordBatch {
+    // Zero-based index of the first data row in the batch.
+    std::size_t first_row = 0;
+    std::size_t rows = 0;
+    // One entry per quantity column, in file order.
+    std::vector<QuantityColumn> columns;
+  };
+
+  struct IngestReport {
+    std::size_t rows = 0;
+    // One entry per column in the file, including non-quantity columns.
+    std::vector<ColumnReport> columns;
+  };
+
+  struct IngestResult {
+    std::size_t rows = 0;
+    std::vector<QuantityColumn> columns;
+    IngestReport report;
+
+    // Column by name. Throws std::out_of_range if there is no such quantity column.
+    const QuantityColumn& column(std::string_view name) const {
+      for (const QuantityColumn& column : columns) {
+        if (column.name == name) {
+          return column;
+        }
+      }
+      throw std::out_of_range("uniTypes: no quantity column named " + std::string(name));
+    }
+  };
+
+  namespace detail {
+    struct IngestColumn {
+      std::string name;
+      Dimension dimension;
+      bool is_quantity = false;
+      bool has_header_unit = false;
+      double header_factor = 1.0;
+      // Index among the quantity columns, if is_quantity.
+      std::size_t quantity_index = 0;
+    };
+
+    enum class CellStatus { Ok, Missing, ParseError, DimensionMismatch };
+
+    struct ColumnCounts {
+      std::size_t missing = 0;
+      std::size_t parse_errors = 0;
+      std::size_t dimension_mismatches = 0;
+      std::size_t first_error_row = ColumnReport::kNoError;
+    };
+
+    struct ParsedChunk {
+      std::size_t rows = 0;
+      std::vector<std::vector<double, AlignedAllocator<double>>> values;
+      std::vector<ColumnCounts> counts;
+    };
+
+    // Removes and returns the next line of text, without its line terminator.
+    inline std::string_view nextLine(std::string_view& text) {
+      const std::size_t end = text.find('\n');
+      std::string_view line = text.substr(0, end);
+      text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+      if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+      }
+      return line;
+    }
+
+    // Removes and returns the next field of line.
+    inline std::string_view nextField(std::string_view& line, char delimiter) {
+      const std::size_t end = line.find(delimiter);
+      std::string_view field = line.substr(0, end);
+      line.remove_prefix(end == std::string_view::npos ? line.size() : end + 1);
+      return field;
+    }
+
+    inline std::string_view unquote(std::string_view field) {
+      field = trim(field);
+      if (field.size() >= 2 && field.front() == '"' && field.back() == '"') {
+        field = trim(field.substr(1, field.size() - 2));
+      }
+      return field;
+    }
+
+    // Reads "name (unit)" or "name [unit]" header fields.
+    inline IngestColumn parseHeaderField(std::string_view field) {
+      IngestColumn column;
+      field = unquote(field);
+      column.name = std::string(field);
+      if (field.empty()) {
+        return column;
+      }
+      const char close = field.back();
+      const char open = close == ')' ? '(' : (close == ']' ? '[' : '\0');
+      const std::size_t start = open == '\0' ? std::string_view::npos : field.rfind(open);
+      if (start == std::string_view::npos) {
+        return column;
+      }
+      const UnitEntry* unit = findUnit(trim(field.substr(start + 1, field.size() - start - 2)));
+      if (unit == nullptr) {
+        return column;
+      }
+      column.name = std::string(trim(field.substr(0, start)));
+      column.dimension = unit->dimension;
+      column.is_quantity = true;
+      column.has_header_unit = true;
+      column.header_factor = unit->factor;
+      return column;
+    }
+
+    inline CellStatus parseCell(std::string_view cell, const IngestColumn& column, double& out) {
+      out = std::numeric_limits<double>::quiet_NaN();
+      cell = unquote(cell);
+      if (cell.empty()) {
+        return CellStatus::Missing;
+      }
+      double number = 0.0;
+      const char* last = cell.data() + cell.size();
+      const std::from_chars_result parsed = std::from_chars(cell.data(), last, number);
+      if (parsed.ec != std::errc()) {
+        return CellStatus::ParseError;
+      }
+      const std::string_view unit_name =
+        trim(std::string_view(parsed.ptr, static_cast<std::size_t>(last - parsed.ptr)));
+      if (unit_name.empty()) {
+        if (!column.has_header_unit) {
+          return CellStatus::ParseError;
+        }
+        out = number * column.header_factor;
+        return CellStatus::Ok;
+      }
+      const UnitEntry* unit = findUnit(unit_name);
+      if (unit == nullptr) {
+        return CellStatus::ParseError;
+      }
+      if (unit->dimension != column.dimension) {
+        return CellStatus::DimensionMismatch;
+      }
+      out = number * unit->factor;
+      return CellStatus::Ok;
+    }
+
+    // Fills in the dimension of columns without a header unit from their first parseable cell.
+    inline void resolveDimensions(std::string_view body, std::vector<IngestColumn>& columns,
+                                  const IngestOptions& options)
+    {
+      for (std::size_t row = 0; row < options.dimension_scan_rows && !body.empty(); ++row) {
+        std::string_view line = nextLine(body);
+        for (std::size_t c = 0; c < columns.size() && !line.empty(); ++c) {
+          const std::string_view cell = nextField(line, options.delimiter);
+          if (columns[c].is_quantity) {
+            continue;
+          }
+          const ParseResult result = parseQuantity(unquote(cell));
+          if (result) {
+            columns[c].is_quantity = true;
+            columns[c].dimension = result.quantity.getDimension();
+          }
+        }
+      }
+    }
+
+    // Splits body into chunks of roughly chunk_bytes that end on line boundaries.
+    inline std::vector<std::string_view> splitChunks(std::string_view body, std::size_t chunk_bytes) {
+      std::vector<std::string_view> chunks;
+      chunk_bytes = std::max<std::size_t>(chunk_bytes, 1);
+      while (!body.empty()) {
+        std::size_t end = body.size();
+        if (chunk_bytes < body.size()) {
+          const std::size_t newline = body.find('\n', chunk_bytes);
+          end = newline == std::string_view::npos ? body.size() : newline + 1;
+        }
+        chunks.push_back(body.substr(0, end));
+        body.remove_prefix(end);
+      }
+      return chunks;
+    }
+
+    inline void parseChunk(std::string_view chunk, const std::vector<IngestColumn>& columns,
+                           std::size_t num_quantity_columns, char delimiter, ParsedChunk& out)
+    {
+      out.rows = 0;
+      out.values.assign(num_quantity_columns, {});
+      out.counts.assign(num_quantity_columns, {});
+      const std::size_t expected_rows = static_cast<std::size_t>(
+        std::count(chunk.begin(), chunk.end(), '\n') + 1);
+      for (auto& values : out.values) {
+        values.reserve(expected_rows);
+      }
+
+      while (!chunk.empty()) {
+        std::string_view line = nextLine(chunk);
+        if (trim(line).empty()) {
+          continue;
+        }
+        for (const IngestColumn& column : columns) {
+          const std::string_view cell = nextField(line, delimiter);
+          if (!column.is_quantity) {
+            continue;
+          }
+          double value;
+          const CellStatus status = parseCell(cell, column, value);
+          out.values[column.quantity_index].push_back(value);
+          ColumnCounts& counts = out.counts[column.quantity_index];
+          switch (status) {
+            case CellStatus::Ok: break;
+            case CellStatus::Missing: ++counts.missing; break;
+            case CellStatus::ParseError: ++counts.parse_errors; break;
+            case CellStatus::DimensionMismatch: ++counts.dimension_mismatches; break;
+          }
+          if ((status == CellStatus::ParseError || status == CellStatus::DimensionMismatch) &&
+              counts.first_error_row == ColumnReport::kNoError) {
+            counts.first_error_row = out.rows;
+          }
+        }
+        ++out.rows;
+      }
+    }
+
+    // Parses the header and resolves column dimensions. Returns the remaining data rows.
+    inline std::string_view prepareColumns(std::string_view text, const IngestOptions& options,
+                                           std::vector<IngestColumn>& columns)
+    {
+      std::string_view body = text;
+      std::string_view header = nextLine(body);
+      if (options.has_header) {
+        while (!header.empty()) {
+          columns.push_back(parseHeaderField(nextField(header, options.delimiter)));
+        }
+      } else {
+        body = text;
+        const std::size_t num_fields = static_cast<std::size_t>(
+          std::count(header.begin(), header.end(), options.delimiter) + 1);
+        for (std::size_t c = 0; c < num_fields; ++c) {
+          columns.emplace_back();
+          columns.back().name = std::to_string(c);
+        }
+      }
+      resolveDimensions(body, columns, options);
+
+      std::size_t quantity_index = 0;
+      for (IngestColumn& column : columns) {
+        if (column.is_quantity) {
+          column.quantity_index = quantity_index++;
+        }
+      }
+      return body;
+    }
+
+    template<typename Callback>
+    IngestReport streamText(std::string_view text, const IngestOptions& options,
+                            const MappedFile* file, Callback&& on_batch)
+    {
+      std::vector<IngestColumn> columns;
+      const std::string_view body = prepareColumns(text, options, columns);
+
+      IngestReport report;
+      std::vector<std::size_t> quantity_columns;
+      for (std::size_t c = 0; c < columns.size(); ++c) {
+        ColumnReport column_report;
+        column_report.name = columns[c].name;
+        column_report.dimension = columns[c].dimension;
+        column_report.is_quantity = columns[c].is_quantity;
+        report.columns.push_back(column_report);
+        if (columns[c].is_quantity) {
+          quantity_columns.push_back(c);
+        }
+      }
+
+      const std::vector<std::string_view> chunks = splitChunks(body, options.chunk_bytes);
+      const unsigned threads = options.threads == 0 ? hardwareThreads() : options.threads;
+      const std::size_t in_flight = options.max_chunks_in_flight == 0
+        ? 2 * static_cast<std::size_t>(threads)
+        : options.max_chunks_in_flight;
+      std::vector<ParsedChunk> parsed(std::min(in_flight, chunks.size()));
+
+      for (std::size_t wave = 0; wave < chunks.size(); wave += in_flight) {
+        const std::size_t wave_size = std::min(in_flight, chunks.size() - wave);
+        parallelFor(wave_size, 1, threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+          for (std::size_t k = begin; k < end; ++k) {
+            parseChunk(chunks[wave + k], columns, quantity_columns.size(), options.delimiter,
+                       parsed[k]);
+          }
+        });
+
+        // Hand the chunks to the caller in file order.
+        for (std::size_t k = 0; k < wave_size; ++k) {
+          RecordBatch batch;
+          batch.first_row = report.rows;
+          batch.rows = parsed[k].rows;
+          for (std::size_t q = 0; q < quantity_columns.size(); ++q) {
+            ColumnReport& column_report = report.columns[quantity_columns[q]];
+            const ColumnCounts& counts = parsed[k].counts[q];
+            column_report.missing += counts.missing;
+            column_report.parse_errors += counts.parse_errors;
+            column_report.dimension_mismatches += counts.dimension_mismatches;
+            if (column_report.first_error_row == ColumnReport::kNoError &&
+                counts.first_error_row != ColumnReport::kNoError) {
+              column_report.first_error_row = report.rows + counts.first_error_row;
+            }
+            batch.columns.push_back(QuantityColumn{column_report.name, column_report.dimension,
+                                                   std::move(parsed[k].values[q])});
+          }
+          report.rows += batch.rows;
+          on_batch(batch);
+        }
+
+        if (file != nullptr) {
+          const std::string_view& last = chunks[wave + wave_size - 1];
+          file->release(static_cast<std::size_t>(last.data() + last.size() - file->data()));
+        }
+      }
+      return report;
+    }
+  }
+
+  // ------------------------------------------
+  // streamText / streamFile
+  // ------------------------------------------
+  // Parses text (or the file at path) and calls on_batch(RecordBatch&) for consecutive runs of
+  // rows, in file order. The callback may move the column values out of the batch. Returns the
+  // per-column report for the whole input.
+  template<typename Callback>
+  IngestReport streamText(std::string_view text, Callback&& on_batch,
+                          const IngestOptions& options = IngestOptions())
+  {
+    return detail::streamText(text, options, nullptr, on_batch);
+  }
+
+  template<typename Callback>
+  IngestReport streamFile(const std::string& path, Callback&& on_batch,
+                          const IngestOptions& options = IngestOptions())
+  {
+    MappedFile file(path);
+    file.adviseSequential();
+    return detail::streamText(file.view(), options, &file, on_batch);
+  }
+
+  // ------------------------------------------
+  // ingestText / ingestFile
+  // ------------------------------------------
+  // Parses text (or the file at path) into one QuantityColumn per quantity column.
+  inline IngestResult ingestText(std::string_view text,
+                                 const IngestOptions& options = IngestOptions())
+  {
+    IngestResult result;
+    result.report = streamText(text, [&](RecordBatch& batch) {
+      if (result.columns.empty()) {
+        result.columns = std::move(batch.columns);
+        return;
+      }
+      for (std::size_t q = 0; q < batch.columns.size(); ++q) {
+        auto& values = result.columns[q].values;
+        values.insert(values.end(), batch.columns[q].values.begin(), batch.columns[q].values.end());
+      }
+    }, options);
+    result.rows = result.report.rows;
+    if (result.columns.empty()) {
+      for (const ColumnReport& column : result.report.columns) {
+        if (column.is_quantity) {
+          result.columns.push_back(QuantityColumn{column.name, column.dimension, {}});
+        }
+      }
+    }
+    return result;
+  }
+
+  inline IngestResult ingestFile(const std::string& path,
+                                 const IngestOptions& options = IngestOptions())
+  {
+    MappedFile file(path);
+    file.adviseSequential();
+    return ingestText(file.view(), options);
+  }
+}
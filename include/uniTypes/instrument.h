@@ -0,0 +1,465 @@
+#pragma once
+#include <uniTypes.h>
+#include <uniTypes/atomicQuantity.h>
+#include <uniTypes/chrono.h>
+#include <uniTypes/dimension.h>
+#include <uniTypes/dynQuantity.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Hot-path instrumentation that records dimensioned metrics.
+//
+// A Metric<Q> is a named stream of samples of quantity type Q, e.g. a Time latency or a Mass/Time
+// throughput. Recording a sample writes it to a lock-free ring owned by the calling thread; an
+// aggregator drains the rings, either when asked to or from a background thread, into one
+// log-bucketed histogram per metric. ScopedTimer records the lifetime of a scope as a Time.
+//
+// Build with UNITYPES_INSTRUMENTATION=1 to turn on the UNITYPES_SCOPED_TIMER and UNITYPES_RECORD
+// macros. Without it they expand to nothing and their arguments are never evaluated, so
+// instrumented code costs nothing. The classes below work either way when used directly.
+#ifndef UNITYPES_INSTRUMENTATION
+#define UNITYPES_INSTRUMENTATION 0
+#endif
+
+namespace uniTypes {
+  // Samples each thread's ring holds before further samples are dropped.
+  constexpr std::size_t kInstrumentRingSize = 4096;
+
+  class Instrumentation;
+
+  namespace detail {
+    struct MetricSample {
+      std::uint32_t metric;
+      double value;
+    };
+
+    // Single-producer single-consumer ring of samples. The owning thread pushes and the
+    // aggregator drains; each side only writes its own index, on its own cache line.
+    class SampleRing {
+    public:
+      bool push(MetricSample sample) noexcept {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) == kInstrumentRingSize) {
+          dropped_.store(dropped_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+          return false;
+        }
+        samples_[head % kInstrumentRingSize] = sample;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+      }
+
+      // Calls fn on every sample pushed so far, oldest first, and frees their slots.
+      template<typename Fn>
+      std::size_t drain(Fn&& fn) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        const std::size_t head = head_.load(std::memory_order_acquire);
+        for (std::size_t i = tail; i != head; ++i) {
+          fn(samples_[i % kInstrumentRingSize]);
+        }
+        tail_.store(head, std::memory_order_release);
+        return head - tail;
+      }
+
+      std::uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+      // Set when the owning thread exits; the aggregator frees the ring after its last drain.
+      std::atomic<bool> retired{false};
+      // Set when the Instrumentation is destroyed; the thread frees the ring on its next sample.
+      std::atomic<bool> orphaned{false};
+
+    private:
+      alignas(kCacheLineSize) std::atomic<std::size_t> head_{0};
+      std::atomic<std::uint64_t> dropped_{0};
+      alignas(kCacheLineSize) std::atomic<std::size_t> tail_{0};
+      std::array<MetricSample, kInstrumentRingSize> samples_;
+    };
+
+    // Histogram of non-negative values with buckets spaced evenly on a log scale: every power of
+    // two is split into kSubBuckets, so quantiles are within 1/(2*kSubBuckets) of the true value.
+    // Negative values are counted as zero.
+    class LogHistogram {
+    public:
+      static constexpr int kSubBucketBits = 3;
+      static constexpr int kSubBuckets = 1 << kSubBucketBits;
+      static constexpr int kMinExponent = -64;
+      static constexpr int kMaxExponent = 64;
+      static constexpr std::size_t kNumBuckets =
+        static_cast<std::size_t>((kMaxExponent - kMinExponent) * kSubBuckets);
+
+      void add(double value) {
+        ++count_;
+        sum_ += value;
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+        if (!(value > 0.0)) {
+          ++zeros_;
+          return;
+        }
+        ++buckets_[bucketIndex(value)];
+      }
+
+      std::uint64_t count() const { return count_; }
+      double sum() const { return sum_; }
+      double min() const { return count_ == 0 ? 0.0 : min_; }
+      double max() const { return count_ == 0 ? 0.0 : max_; }
+
+      // Value below which a fraction q of the samples lie, at the geometric midpoint of its
+      // bucket and clamped to [min, max]. Returns 0 for an empty histogram.
+      double quantile(double q) const {
+        if (count_ == 0) {
+          return 0.0;
+        }
+        const double clamped = std::min(std::max(q, 0.0), 1.0);
+        const std::uint64_t rank = static_cast<std::uint64_t>(clamped * (count_ - 1));
+        std::uint64_t seen = zeros_;
+        if (rank < seen) {
+          return min();
+        }
+        for (std::size_t i = 0; i < kNumBuckets; ++i) {
+          seen += buckets_[i];
+          if (rank < seen) {
+            return std::min(std::max(bucketMidpoint(i), min_), max_);
+          }
+        }
+        return max_;
+      }
+
+    private:
+      // Reads the bucket off the bits of value: its binary exponent and the top kSubBucketBits
+      // bits of its mantissa.
+      static std::size_t bucketIndex(double value) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        const int exponent = static_cast<int>((bits >> 52) & 0x7ff) - 1023;
+        if (exponent < kMinExponent) {
+          return 0;
+        }
+        if (exponent >= kMaxExponent) {
+          return kNumBuckets - 1;
+        }
+        const int sub = static_cast<int>((bits >> (52 - kSubBucketBits)) & (kSubBuckets - 1));
+        return static_cast<std::size_t>((exponent - kMinExponent) * kSubBuckets + sub);
+      }
+
+      static double bucketMidpoint(std::size_t index) {
+        const int exponent = static_cast<int>(index) / kSubBuckets + kMinExponent;
+        const int sub = static_cast<int>(index) % kSubBuckets;
+        const double lower = 1.0 + static_cast<double>(sub) / kSubBuckets;
+        const double upper = 1.0 + static_cast<double>(sub + 1) / kSubBuckets;
+        return std::ldexp(std::sqrt(lower * upper), exponent);
+      }
+
+      std::uint64_t count_ = 0;
+      std::uint64_t zeros_ = 0;
+      double sum_ = 0.0;
+      double min_ = std::numeric_limits<double>::infinity();
+      double max_ = -std::numeric_limits<double>::infinity();
+      std::array<std::uint64_t, kNumBuckets> buckets_{};
+    };
+  }
+
+  // Handle of a registered metric. Cheap to copy; valid as long as its Instrumentation.
+  template<typename Q>
+  class Metric {
+  public:
+    using quantity_type = Q;
+
+    constexpr Metric() = default;
+
+    // Records one sample. Lock-free once the calling thread has recorded its first sample, which
+    // registers the thread's ring. The sample is dropped (and counted) if that ring is full
+    // because nothing has drained it.
+    void record(Q value) const;
+
+    Instrumentation* owner() const { return owner_; }
+    std::uint32_t id() const { return id_; }
+
+  private:
+    friend class Instrumentation;
+
+    Metric(Instrumentation* owner, std::uint32_t id) : owner_(owner), id_(id) {}
+
+    Instrumentation* owner_ = nullptr;
+    std::uint32_t id_ = 0;
+  };
+
+  // Aggregated samples of one metric, in its quantity type.
+  template<typename Q>
+  class MetricSnapshot {
+  public:
+    MetricSnapshot(std::string name, const detail::LogHistogram& histogram)
+      : name_(std::move(name)), histogram_(histogram) {}
+
+    const std::string& name() const { return name_; }
+    std::uint64_t count() const { return histogram_.count(); }
+    Q sum() const { return quantity(histogram_.sum()); }
+    Q min() const { return quantity(histogram_.min()); }
+    Q max() const { return quantity(histogram_.max()); }
+
+    Q mean() const {
+      return quantity(count() == 0 ? 0.0 : histogram_.sum() / static_cast<double>(count()));
+    }
+
+    // Approximate q-quantile, e.g. quantile(0.99) for the 99th percentile.
+    Q quantile(double q) const { return quantity(histogram_.quantile(q)); }
+
+  private:
+    static Q quantity(double value) { return Q(static_cast<typename Q::rep>(value)); }
+
+    std::string name_;
+    detail::LogHistogram histogram_;
+  };
+
+  class Instrumentation {
+  public:
+    Instrumentation() : instance_id_(nextInstanceId()) {}
+
+    ~Instrumentation() {
+      stop();
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (const std::shared_ptr<detail::SampleRing>& ring : rings_) {
+        ring->orphaned.store(true, std::memory_order_release);
+      }
+    }
+
+    Instrumentation(const Instrumentation&) = delete;
+    Instrumentation& operator=(const Instrumentation&) = delete;
+
+    // Metric called name, registered on first use. Throws DimensionMismatch if name is already
+    // registered with another quantity type.
+    template<typename Q>
+    Metric<Q> metric(std::string_view name) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (std::size_t i = 0; i < metrics_.size(); ++i) {
+        if (metrics_[i].name == name) {
+          if (metrics_[i].dimension != dimensionOf<Q>()) {
+            throw DimensionMismatch("uniTypes: metric " + metrics_[i].name +
+                                    " is registered with another dimension");
+          }
+          return Metric<Q>(this, static_cast<std::uint32_t>(i));
+        }
+      }
+      metrics_.push_back(MetricState{std::string(name), dimensionOf<Q>(), {}});
+      return Metric<Q>(this, static_cast<std::uint32_t>(metrics_.size() - 1));
+    }
+
+    // Pushes a sample to the calling thread's ring. Prefer Metric::record.
+    void record(std::uint32_t metric, double value) noexcept {
+      if (detail::SampleRing* ring = threadRing()) {
+        ring->push(detail::MetricSample{metric, value});
+      }
+    }
+
+    // Moves every sample recorded so far into the histograms and frees the rings of threads that
+    // have exited. Returns the number of samples moved.
+    std::size_t drain() {
+      std::lock_guard<std::mutex> lock(mutex_);
+      std::size_t drained = 0;
+      for (std::size_t r = 0; r < rings_.size();) {
+        detail::SampleRing& ring = *rings_[r];
+        const bool retired = ring.retired.load(std::memory_order_acquire);
+        drained += ring.drain([this](const detail::MetricSample& sample) {
+          metrics_[sample.metric].histogram.add(sample.value);
+        });
+        if (retired) {
+          retired_dropped_ += ring.dropped();
+          rings_.erase(rings_.begin() + static_cast<std::ptrdiff_t>(r));
+        } else {
+          ++r;
+        }
+      }
+      return drained;
+    }
+
+    // Starts a background thread that drains every interval, until stop() is called.
+    void start(std::chrono::milliseconds interval = std::chrono::milliseconds(10)) {
+      std::lock_guard<std::mutex> lock(aggregator_mutex_);
+      if (aggregator_.joinable()) {
+        return;
+      }
+      stopping_ = false;
+      aggregator_ = std::thread([this, interval] {
+        std::unique_lock<std::mutex> wait_lock(aggregator_mutex_);
+        while (!stopping_) {
+          wait_lock.unlock();
+          drain();
+          wait_lock.lock();
+          wake_.wait_for(wait_lock, interval, [this] { return stopping_; });
+        }
+      });
+    }
+
+    // Stops the background thread, if any, and drains what is left.
+    void stop() {
+      {
+        std::lock_guard<std::mutex> lock(aggregator_mutex_);
+        stopping_ = true;
+      }
+      wake_.notify_all();
+      if (aggregator_.joinable()) {
+        aggregator_.join();
+      }
+      drain();
+    }
+
+    // Histogram of metric as of the last drain.
+    template<typename Q>
+    MetricSnapshot<Q> snapshot(Metric<Q> metric) const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      const MetricState& state = metrics_.at(metric.id());
+      return MetricSnapshot<Q>(state.name, state.histogram);
+    }
+
+    // Samples dropped because a thread's ring was full.
+    std::uint64_t dropped() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      std::uint64_t total = retired_dropped_;
+      for (const std::shared_ptr<detail::SampleRing>& ring : rings_) {
+        total += ring->dropped();
+      }
+      return total;
+    }
+
+  private:
+    struct MetricState {
+      std::string name;
+      Dimension dimension;
+      detail::LogHistogram histogram;
+    };
+
+    // Rings of the calling thread, one per live Instrumentation it has recorded to. Marks them
+    // retired when the thread exits.
+    struct ThreadRings {
+      std::vector<std::pair<std::uint64_t, std::shared_ptr<detail::SampleRing>>> rings;
+
+      ~ThreadRings() {
+        for (auto& entry : rings) {
+          entry.second->retired.store(true, std::memory_order_release);
+        }
+      }
+    };
+
+    static std::uint64_t nextInstanceId() {
+      static std::atomic<std::uint64_t> next_id(1);
+      return next_id.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    detail::SampleRing* threadRing() {
+      thread_local ThreadRings thread_rings;
+      auto& rings = thread_rings.rings;
+      for (std::size_t i = 0; i < rings.size();) {
+        if (rings[i].second->orphaned.load(std::memory_order_acquire)) {
+          // Its Instrumentation is gone: free the ring rather than keep scanning past it.
+          rings[i] = std::move(rings.back());
+          rings.pop_back();
+          continue;
+        }
+        if (rings[i].first == instance_id_) {
+          return rings[i].second.get();
+        }
+        ++i;
+      }
+      // First sample of this thread: register a new ring. Allocation failure drops the sample.
+      try {
+        auto ring = std::make_shared<detail::SampleRing>();
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          rings_.push_back(ring);
+        }
+        rings.emplace_back(instance_id_, ring);
+        return ring.get();
+      } catch (...) {
+        return nullptr;
+      }
+    }
+
+    const std::uint64_t instance_id_;
+
+    mutable std::mutex mutex_;
+    std::deque<MetricState> metrics_;
+    std::vector<std::shared_ptr<detail::SampleRing>> rings_;
+    std::uint64_t retired_dropped_ = 0;
+
+    std::mutex aggregator_mutex_;
+    std::condition_variable wake_;
+    std::thread aggregator_;
+    bool stopping_ = false;
+  };
+
+  template<typename Q>
+  void Metric<Q>::record(Q value) const {
+    if (owner_ != nullptr) {
+      owner_->record(id_, static_cast<double>(value.getValue()));
+    }
+  }
+
+  // ------------------------------------------
+  // instrumentation
+  // ------------------------------------------
+  // Process-wide Instrumentation used by the UNITYPES_* macros.
+  inline Instrumentation& instrumentation() {
+    static Instrumentation instance;
+    return instance;
+  }
+
+  // Records the time from construction to destruction as a sample of a Time metric.
+  class ScopedTimer {
+  public:
+    explicit ScopedTimer(Metric<Time> metric)
+      : metric_(metric), start_(std::chrono::steady_clock::now()) {}
+
+    ~ScopedTimer() { metric_.record(elapsed()); }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    // Time since construction.
+    Time elapsed() const { return fromDuration(std::chrono::steady_clock::now() - start_); }
+
+  private:
+    Metric<Time> metric_;
+    std::chrono::steady_clock::time_point start_;
+  };
+}
+
+#define UNITYPES_CONCAT_IMPL(a, b) a##b
+#define UNITYPES_CONCAT(a, b) UNITYPES_CONCAT_IMPL(a, b)
+
+#if UNITYPES_INSTRUMENTATION
+// Times the rest of the enclosing scope as a sample of the Time metric called name.
+#define UNITYPES_SCOPED_TIMER(name)                                                               \
+  static const ::uniTypes::Metric<::uniTypes::Time> UNITYPES_CONCAT(uniTypes_metric_, __LINE__) = \
+    ::uniTypes::instrumentation().metric<::uniTypes::Time>(name);                                 \
+  const ::uniTypes::ScopedTimer UNITYPES_CONCAT(uniTypes_timer_, __LINE__)(                       \
+    UNITYPES_CONCAT(uniTypes_metric_, __LINE__))
+
+// Records a quantity as a sample of the metric called name, of the quantity's type.
+#define UNITYPES_RECORD(name, ...)                                                       \
+  do {                                                                                   \
+    const auto uniTypes_value = (__VA_ARGS__);                                           \
+    static const auto uniTypes_metric =                                                  \
+      ::uniTypes::instrumentation().metric<std::decay_t<decltype(uniTypes_value)>>(name); \
+    uniTypes_metric.record(uniTypes_value);                                              \
+  } while (false)
+#else
+#define UNITYPES_SCOPED_TIMER(name) static_cast<void>(0)
+#define UNITYPES_RECORD(name, ...) static_cast<void>(0)
+#endif
@@ -0,0 +1,105 @@
+#pragma once
+#include <uniTypes/units.h>
+
+// Unit literal operators such as 1.5_kg. Bring them into scope with
+// `using namespace uniTypes::string_literals;`.
+namespace uniTypes {
+  // Unit string literals
+  namespace string_literals{
+    // IU literals.
+    constexpr UOBA operator "" _IU(long double x) { return static_cast<double>(x) * IU; }
+    constexpr UOBA operator "" _IU(unsigned long long int x) { return static_cast<double>(x) * IU; }
+
+    // Length literals.
+    constexpr Length operator"" _m(long double x) { return static_cast<double>(x) * meter; }
+    constexpr Length operator"" _dm(long double x) { return static_cast<double>(x) * decimeter; }
+    constexpr Length operator"" _cm(long double x) { return static_cast<double>(x) * centimeter; }
+    constexpr Length operator"" _mm(long double x) { return static_cast<double>(x) * millimeter; }
+    constexpr Length operator"" _km(long double x) { return static_cast<double>(x) * kilometer; }
+    constexpr Length operator"" _in(long double x) { return static_cast<double>(x) * inch; }
+    constexpr Length operator"" _ft(long double x) { return static_cast<double>(x) * foot; }
+    constexpr Length operator"" _yd(long double x) { return static_cast<double>(x) * yard; }
+    constexpr Length operator"" _mi(long double x) { return static_cast<double>(x) * mile; }
+    constexpr Length operator"" _m(unsigned long long int x) { return static_cast<double>(x) * meter; }
+    constexpr Length operator"" _dm(unsigned long long int x) { return static_cast<double>(x) * decimeter; }
+    constexpr Length operator"" _cm(unsigned long long int x) { return static_cast<double>(x) * centimeter; }
+    constexpr Length operator"" _mm(unsigned long long int x) { return static_cast<double>(x) * millimeter; }
+    constexpr Length operator"" _km(unsigned long long int x) { return static_cast<double>(x) * kilometer; }
+    constexpr Length operator"" _in(unsigned long long int x) { return static_cast<double>(x) * inch; }
+    constexpr Length operator"" _ft(unsigned long long int x) { return static_cast<double>(x) * foot; }
+    constexpr Length operator"" _yd(unsigned long long int x) { return static_cast<double>(x) * yard; }
+    constexpr Length operator"" _mi(unsigned long long int x) { return static_cast<double>(x) * mile; }
+
+    // Mass literals.
+    constexpr Mass operator"" _kg(long double x) { return static_cast<double>(x) * kilogram; }
+    constexpr Mass operator"" _g(long double x) { return static_cast<double>(x) * gram; }
+    constexpr Mass operator"" _mg(long double x) { return static_cast<double>(x) * milligram; }
+    constexpr Mass operator"" _tn(long double x) { return static_cast<double>(x) * ton; }
+    constexpr Mass operator"" _oz(long double x) { return static_cast<double>(x) * ounce; }
+    constexpr Mass operator"" _lb(long double x) { return static_cast<double>(x) * pound; }
+    constexpr Mass operator"" _kg(unsigned long long int x) { return static_cast<double>(x) * kilogram; }
+    constexpr Mass operator"" _g(unsigned long long int x) { return static_cast<double>(x) * gram; }
+    constexpr Mass operator"" _mg(unsigned long long int x) { return static_cast<double>(x) * milligram; }
+    constexpr Mass operator"" _tn(unsigned long long int x) { return static_cast<double>(x) * ton; }
+    constexpr Mass operator"" _oz(unsigned long long int x) { return static_cast<double>(x) * ounce; }
+    constexpr Mass operator"" _lb(unsigned long long int x) { return static_cast<double>(x) * pound; }
+
+    // Volume literals.
+    constexpr Volume operator "" _ml(long double x) { return static_cast<double>(x) * milliliter; }
+    constexpr Volume operator "" _liter(long double x) { return static_cast<double>(x) * liter; }
+    constexpr Volume operator "" _gal(long double x) { return static_cast<double>(x) * gallon; }
+    constexpr Volume operator "" _qt(long double x) { return static_cast<double>(x) * quart; }
+    constexpr Volume operator "" _cup(long double x) { return static_cast<double>(x) * cup; }
+    constexpr Volume operator "" _fl(long double x) { return static_cast<double>(x) * floz; }
+    constexpr Volume operator "" _tbsp(long double x) { return static_cast<double>(x) * tablespoon; }
+    constexpr Volume operator "" _tsp(long double x) { return static_cast<double>(x) * teaspoon; }
+    constexpr Volume operator "" _ml(unsigned long long int x) { return static_cast<double>(x) * milliliter; }
+    constexpr Volume operator "" _liter(unsigned long long int x) { return static_cast<double>(x) * liter; }
+    constexpr Volume operator "" _gal(unsigned long long int x) { return static_cast<double>(x) * gallon; }
+    constexpr Volume operator "" _qt(unsigned long long int x) { return static_cast<double>(x) * quart; }
+    constexpr Volume operator "" _cup(unsigned long long int x) { return static_cast<double>(x) * cup; }
+    constexpr Volume operator "" _fl(unsigned long long int x) { return static_cast<double>(x) * floz; }
+    constexpr Volume operator "" _tbsp(unsigned long long int x) { return static_cast<double>(x) * tablespoon; }
+    constexpr Volume operator "" _tsp(unsigned long long int x) { return static_cast<double>(x) * teaspoon; }
+  
+    constexpr Time operator "" _s(long double x) { return static_cast<double>(x) * second; }
+    constexpr Time operator "" _min(long double x) { return static_cast<double>(x) * minute; }
+    constexpr Time operator "" _hr(long double x) { return static_cast<double>(x) * hour; }
+    constexpr Time operator "" _day(long double x) { return static_cast<double>(x) * day; }
+    constexpr Time operator "" _week(long double x) { return static_cast<double>(x) * week; }
+    constexpr Time operator "" _year(long double x) { return static_cast<double>(x) * year; }
+    constexpr Time operator "" _ms(long double x) { return static_cast<double>(x) * millisecond; }
+    constexpr Time operator "" _ns(long double x) { return static_cast<double>(x) * nanosecond; }
+    constexpr Time operator "" _s(unsigned long long int x) { return static_cast<double>(x) * second; }
+    constexpr Time operator "" _min(unsigned long long int x) { return static_cast<double>(x) * minute; }
+    constexpr Time operator "" _hr(unsigned long long int x) { return static_cast<double>(x) * hour; }
+    constexpr Time operator "" _day(unsigned long long int x) { return static_cast<double>(x) * day; }
+    constexpr Time operator "" _week(unsigned long long int x) { return static_cast<double>(x) * week; }
+    constexpr Time operator "" _year(unsigned long long int x) { return static_cast<double>(x) * year; }
+    constexpr Time operator "" _ms(unsigned long long int x) { return static_cast<double>(x) * millisecond; }
+    constexpr Time operator "" _ns(unsigned long long int x) { return static_cast<double>(x) * nanosecond; }
+
+    constexpr Force operator "" _N(long double x) { return static_cast<double>(x) * newton; }
+    constexpr Force operator "" _kN(long double x) { return static_cast<double>(x) * kilonewton; }
+    constexpr Force operator "" _MN(long double x) { return static_cast<double>(x) * meganewton; }
+    constexpr Force operator "" _mN(long double x) { return static_cast<double>(x) * millinewton; }
+    constexpr Force operator "" _lbf(long double x) { return static_cast<double>(x) * poundforce; }
+    constexpr Force operator "" _N(unsigned long long int x) { return static_cast<double>(x) * newton; }
+    constexpr Force operator "" _kN(unsigned long long int x) { return static_cast<double>(x) * kilonewton; }
+    constexpr Force operator "" _MN(unsigned long long int x) { return static_cast<double>(x) * meganewton; }
+    constexpr Force operator "" _mN(unsigned long long int x) { return static_cast<double>(x) * millinewton; }
+    constexpr Force operator "" _lbf(unsigned long long int x) { return static_cast<double>(x) * poundforce; }
+
+    constexpr Energy operator "" _J(long double x) { return static_cast<double>(x) * joule; }
+    constexpr Energy operator "" _kJ(long double x) { return static_cast<double>(x) * kilojoule; }
+    constexpr Energy operator "" _MJ(long double x) { return static_cast<double>(x) * megajoule; }
+    constexpr Energy operator "" _kcal(long double x) { return static_cast<double>(x) * kilocalorie; }
+    constexpr Energy operator "" _btu(long double x) { return static_cast<double>(x) * btu; }
+    constexpr Energy operator "" _J(unsigned long long int x) { return static_cast<double>(x) * joule; }
+    constexpr Energy operator "" _kJ(unsigned long long int x) { return static_cast<double>(x) * kilojoule; }
+    constexpr Energy operator "" _MJ(unsigned long long int x) { return static_cast<double>(x) * megajoule; }
+    constexpr Energy operator "" _kcal(unsigned long long int x) { return static_cast<double>(x)
+      * kilocalorie; }
+    constexpr Energy operator "" _btu(unsigned long long int x) { return static_cast<double>(x) * btu;}
+  }
+}
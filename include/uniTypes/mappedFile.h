@@ -0,0 +1,109 @@
+#pragma once
+#include <cerrno>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define UNITYPES_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define UNITYPES_HAS_MMAP 0
+#include <fstream>
+#include <iterator>
+#include <vector>
+#endif
+
+// Read-only view of a whole file.
+//
+// On POSIX systems the file is memory-mapped, so it can be larger than RAM: pages are loaded on
+// demand and can be dropped again with release(). Elsewhere the file is read into memory.
+namespace uniTypes {
+  class MappedFile {
+  public:
+    // Opens and maps path. Throws std::system_error if the file cannot be opened or mapped.
+    explicit MappedFile(const std::string& path) {
+#if UNITYPES_HAS_MMAP
+      const int fd = ::open(path.c_str(), O_RDONLY);
+      if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "uniTypes: cannot open " + path);
+      }
+      struct stat info;
+      if (::fstat(fd, &info) != 0) {
+        const int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "uniTypes: cannot stat " + path);
+      }
+      size_ = static_cast<std::size_t>(info.st_size);
+      if (size_ > 0) {
+        void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+          const int error = errno;
+          ::close(fd);
+          throw std::system_error(error, std::generic_category(), "uniTypes: cannot map " + path);
+        }
+        data_ = static_cast<const char*>(mapping);
+      }
+      ::close(fd);
+#else
+      std::ifstream file(path, std::ios::binary);
+      if (!file) {
+        throw std::system_error(std::make_error_code(std::errc::no_such_file_or_directory),
+                                "uniTypes: cannot open " + path);
+      }
+      buffer_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+      data_ = buffer_.data();
+      size_ = buffer_.size();
+#endif
+    }
+
+    ~MappedFile() {
+#if UNITYPES_HAS_MMAP
+      if (data_ != nullptr) {
+        ::munmap(const_cast<char*>(data_), size_);
+      }
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return data_; }
+    std::size_t size() const { return size_; }
+    std::string_view view() const { return std::string_view(data_, size_); }
+
+    // Hints that the file will be read front to back.
+    void adviseSequential() const {
+#if UNITYPES_HAS_MMAP
+      if (data_ != nullptr) {
+        ::madvise(const_cast<char*>(data_), size_, MADV_SEQUENTIAL);
+      }
+#endif
+    }
+
+    // Tells the OS that the first `bytes` bytes are no longer needed, so their pages can be
+    // dropped from memory. They are transparently reloaded if accessed again.
+    void release(std::size_t bytes) const {
+#if UNITYPES_HAS_MMAP
+      const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+      bytes = bytes / page * page;
+      if (data_ != nullptr && bytes > 0) {
+        ::madvise(const_cast<char*>(data_), bytes < size_ ? bytes : size_, MADV_DONTNEED);
+      }
+#else
+      (void)bytes;
+#endif
+    }
+
+  private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+#if !UNITYPES_HAS_MMAP
+    std::vector<char> buffer_;
+#endif
+  };
+}
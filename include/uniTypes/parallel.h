@@ -0,0 +1,73 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+// Minimal fork-join helper shared by the bulk kernels.
+namespace uniTypes {
+  // Number of threads to use when a caller asks for "all cores".
+  inline unsigned hardwareThreads() {
+    unsigned threads = std::thread::hardware_concurrency();
+    return threads == 0 ? 1 : threads;
+  }
+
+  namespace detail {
+    // ------------------------------------------
+    // parallelFor
+    // ------------------------------------------
+    // Calls fn(chunk_index, begin, end) for every chunk of grain elements in [0, n). Threads claim
+    // chunks from a shared counter, so a thread that finishes early steals the remaining chunks
+    // of slower ones. Chunk boundaries only depend on n and grain, never on the thread count, so
+    // kernels that combine per-chunk results in chunk order are deterministic.
+    // unsigned threads, Maximum number of threads (including the caller) to use. 0 means all.
+    template<typename Fn>
+    void parallelFor(std::size_t n, std::size_t grain, unsigned threads, Fn fn) {
+      if (grain == 0) {
+        grain = 1;
+      }
+      const std::size_t num_chunks = (n + grain - 1) / grain;
+      if (threads == 0) {
+        threads = hardwareThreads();
+      }
+      threads = static_cast<unsigned>(std::min<std::size_t>(threads, num_chunks));
+
+      if (threads <= 1) {
+        for (std::size_t chunk = 0; chunk < num_chunks; ++chunk) {
+          fn(chunk, chunk * grain, std::min(n, (chunk + 1) * grain));
+        }
+        return;
+      }
+
+      std::atomic<std::size_t> next_chunk(0);
+      std::vector<std::exception_ptr> errors(threads);
+      auto worker = [&](unsigned id) {
+        try {
+          for (std::size_t chunk = next_chunk++; chunk < num_chunks; chunk = next_chunk++) {
+            fn(chunk, chunk * grain, std::min(n, (chunk + 1) * grain));
+          }
+        } catch (...) {
+          errors[id] = std::current_exception();
+          next_chunk = num_chunks;
+        }
+      };
+
+      std::vector<std::thread> pool;
+      pool.reserve(threads - 1);
+      for (unsigned id = 1; id < threads; ++id) {
+        pool.emplace_back(worker, id);
+      }
+      worker(0);
+      for (auto& thread : pool) {
+        thread.join();
+      }
+      for (auto& error : errors) {
+        if (error) {
+          std::rethrow_exception(error);
+        }
+      }
+    }
+  }
+}
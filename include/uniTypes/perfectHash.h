@@ -0,0 +1,139 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+
+// Compile-time minimal-probe perfect hashing over a fixed set of string keys.
+//
+// The table is built with the "hash, displace" scheme: keys are first grouped into buckets by one
+// hash, then each bucket (largest first) searches for a seed that sends all of its keys to free
+// slots under a second, seeded hash. A lookup therefore costs two hashes, two array reads and a
+// single string comparison, and the whole table is constant-initialized static data.
+namespace uniTypes {
+  namespace detail {
+    // Seeded 64-bit FNV-1a.
+    constexpr std::uint64_t hashString(std::string_view key, std::uint64_t seed) {
+      std::uint64_t hash = 14695981039346656037ull ^ (seed * 0x9E3779B97F4A7C15ull);
+      for (char c : key) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+      }
+      return hash ^ (hash >> 29);
+    }
+
+    constexpr std::size_t nextPowerOfTwo(std::size_t n) {
+      std::size_t power = 1;
+      while (power < n) {
+        power *= 2;
+      }
+      return power;
+    }
+  }
+
+  template<std::size_t NumKeys>
+  class PerfectHash {
+  public:
+    static constexpr std::size_t kNumBuckets = detail::nextPowerOfTwo(NumKeys / 2 + 1);
+    static constexpr std::size_t kNumSlots = detail::nextPowerOfTwo(NumKeys * 2);
+    static constexpr std::uint16_t kEmpty = 0xFFFF;
+
+    static_assert(NumKeys < kEmpty, "Too many keys for a PerfectHash");
+
+    // Builds the table. Fails to compile (or throws at runtime) if two keys are equal.
+    constexpr explicit PerfectHash(const std::array<std::string_view, NumKeys>& keys)
+      : seeds_{}, slots_{}
+    {
+      for (std::size_t slot = 0; slot < kNumSlots; ++slot) {
+        slots_[slot] = kEmpty;
+      }
+
+      std::array<std::size_t, kNumBuckets> bucket_sizes{};
+      std::array<std::size_t, NumKeys> key_buckets{};
+      for (std::size_t key = 0; key < NumKeys; ++key) {
+        key_buckets[key] = bucketOf(keys[key]);
+        ++bucket_sizes[key_buckets[key]];
+      }
+
+      // Place buckets from largest to smallest; the big ones are hardest to fit.
+      std::array<bool, kNumBuckets> placed{};
+      for (std::size_t round = 0; round < kNumBuckets; ++round) {
+        std::size_t bucket = 0;
+        std::size_t largest = 0;
+        bool found = false;
+        for (std::size_t b = 0; b < kNumBuckets; ++b) {
+          if (!placed[b] && (!found || bucket_sizes[b] > largest)) {
+            bucket = b;
+            largest = bucket_sizes[b];
+            found = true;
+          }
+        }
+        placed[bucket] = true;
+        if (largest == 0) {
+          continue;
+        }
+        placeBucket(keys, key_buckets, bucket);
+      }
+    }
+
+    // Index of key in the array the table was built from, or NumKeys when the key is not there.
+    constexpr std::size_t find(std::string_view key,
+                               const std::array<std::string_view, NumKeys>& keys) const
+    {
+      const std::size_t index = slots_[slotOf(key, seeds_[bucketOf(key)])];
+      return (index != kEmpty && keys[index] == key) ? index : NumKeys;
+    }
+
+  private:
+    static constexpr std::size_t bucketOf(std::string_view key) {
+      return static_cast<std::size_t>(detail::hashString(key, 0) & (kNumBuckets - 1));
+    }
+
+    static constexpr std::size_t slotOf(std::string_view key, std::uint16_t seed) {
+      return static_cast<std::size_t>(detail::hashString(key, seed) & (kNumSlots - 1));
+    }
+
+    constexpr void placeBucket(const std::array<std::string_view, NumKeys>& keys,
+                               const std::array<std::size_t, NumKeys>& key_buckets,
+                               std::size_t bucket)
+    {
+      for (std::uint32_t seed = 1; seed < 0x10000; ++seed) {
+        bool fits = true;
+        for (std::size_t key = 0; key < NumKeys && fits; ++key) {
+          if (key_buckets[key] != bucket) {
+            continue;
+          }
+          const std::size_t slot = slotOf(keys[key], static_cast<std::uint16_t>(seed));
+          if (slots_[slot] != kEmpty) {
+            fits = false;
+            break;
+          }
+          // Keys earlier in this bucket must not land on the same slot either.
+          for (std::size_t other = 0; other < key; ++other) {
+            if (key_buckets[other] == bucket &&
+                slotOf(keys[other], static_cast<std::uint16_t>(seed)) == slot) {
+              fits = false;
+              break;
+            }
+          }
+        }
+        if (!fits) {
+          continue;
+        }
+        seeds_[bucket] = static_cast<std::uint16_t>(seed);
+        for (std::size_t key = 0; key < NumKeys; ++key) {
+          if (key_buckets[key] == bucket) {
+            slots_[slotOf(keys[key], static_cast<std::uint16_t>(seed))] =
+              static_cast<std::uint16_t>(key);
+          }
+        }
+        return;
+      }
+      throw std::logic_error("uniTypes: PerfectHash keys must be unique");
+    }
+
+    std::array<std::uint16_t, kNumBuckets> seeds_;
+    std::array<std::uint16_t, kNumSlots> slots_;
+  };
+}
@@ -0,0 +1,402 @@
+#pragma once
+#include <uniTypes.h>
+#include <uniTypes/dimension.h>
+#include <uniTypes/dynQuantity.h>
+#include <uniTypes/parallel.h>
+#include <uniTypes/quantityVector.h>
+#include <uniTypes/wireFormat.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Mergeable streaming quantile sketches over quantities.
+//
+// QuantileSketch<Q> is a DDSketch: values are counted in buckets whose bounds grow geometrically,
+// so every quantile it reports is within a chosen relative accuracy of the exact one, whatever the
+// distribution, in memory that does not grow with the stream. Merging two sketches adds their
+// bucket counts, so per-thread or per-process sketches can be combined exactly, in memory or from
+// serialized snapshots. A sketch is not synchronized: each thread fills a sketch of its own,
+// without locks, and the sketches are merged when a result is needed.
+//
+// The bucket of a value is read off its bits, like the histogram in instrument.h: its binary
+// exponent plus its mantissa as a linear approximation of log2, which keeps inserts free of calls
+// to std::log. Buckets cover SI magnitudes from 2^kSketchMinExponent to 2^kSketchMaxExponent;
+// smaller and larger magnitudes fall into the end buckets, and their quantiles are clamped to the
+// exact min and max.
+namespace uniTypes {
+  constexpr int kSketchMinExponent = -64;
+  constexpr int kSketchMaxExponent = 64;
+  // Elements per task when an insert is split across threads.
+  constexpr std::size_t kSketchGrain = 1 << 16;
+  constexpr std::uint16_t kSketchVersion = 1;
+  // Finest relative accuracy a sketch accepts. A sketch this fine takes 5 MiB per sign.
+  constexpr double kSketchMinAccuracy = 1e-4;
+
+  namespace detail {
+    constexpr char kSketchMagic[4] = {'U', 'T', 'Q', 'S'};
+    // Header, then 12 bytes (int32 index, uint64 count) per non-empty bucket.
+    constexpr std::size_t kSketchHeaderSize = 72;
+    constexpr std::size_t kSketchEntrySize = 12;
+
+    // Approximate log2(|value|) - kSketchMinExponent for a finite non-zero value: the binary
+    // exponent plus the fraction bits of the mantissa. Monotonic in |value|. Both parts are
+    // turned into doubles by splicing bits rather than by integer conversions, so batches of
+    // values vectorize.
+    inline double sketchLogPosition(double value) {
+      std::uint64_t bits;
+      std::memcpy(&bits, &value, sizeof(bits));
+      // 2^52 + biased exponent, and 1 + fraction.
+      const std::uint64_t exponent_bits = 0x4330000000000000ull | ((bits >> 52) & 0x7ff);
+      const std::uint64_t mantissa_bits = 0x3ff0000000000000ull | (bits & 0xfffffffffffffull);
+      double exponent;
+      double mantissa;
+      std::memcpy(&exponent, &exponent_bits, sizeof(exponent));
+      std::memcpy(&mantissa, &mantissa_bits, sizeof(mantissa));
+      return (exponent - (0x1p52 + 1024.0 + kSketchMinExponent)) + mantissa;
+    }
+
+    // Bucket of the magnitude v > 0: the smallest i with position(v) <= i / multiplier, clamped
+    // to [0, last]. Positions are below 2^11, so with multiplier bounded as in QuantileSketch the
+    // scaled position fits an int32, and the clamp is done on integers, which vectorizes where a
+    // floating-point clamp does not.
+    inline std::uint32_t sketchBucketIndex(double v, double multiplier, std::int32_t last) {
+      const double position = sketchLogPosition(v) * multiplier;
+      const std::int32_t truncated = static_cast<std::int32_t>(position);
+      const std::int32_t index = truncated + (static_cast<double>(truncated) < position);
+      return static_cast<std::uint32_t>(std::min(std::max(index, 0), last));
+    }
+
+    // Bucket indices of the magnitudes of values[0, n), as a plain counted loop that the
+    // compiler vectorizes.
+    template<typename Rep>
+    void sketchBucketIndices(const Rep* values, std::size_t n, double multiplier,
+                             std::int32_t last, std::uint32_t* out) {
+      for (std::size_t i = 0; i < n; ++i) {
+        out[i] = sketchBucketIndex(std::fabs(static_cast<double>(values[i])), multiplier, last);
+      }
+    }
+
+    // Inverse of sketchLogPosition.
+    inline double sketchMagnitude(double position) {
+      const double shifted = position + kSketchMinExponent;
+      const double exponent = std::floor(shifted);
+      return std::ldexp(1.0 + (shifted - exponent), static_cast<int>(exponent));
+    }
+  }
+
+  template<typename Q>
+  class QuantileSketch {
+  public:
+    using quantity_type = Q;
+
+    // double relative_accuracy = 0.01, Bound on the relative error of every quantile inside the
+    // bucketed range. Each sign of the values added takes 50 KiB at the default accuracy, in
+    // proportion to 1 / relative_accuracy. Throws std::invalid_argument unless it is in
+    // [kSketchMinAccuracy, 1).
+    explicit QuantileSketch(double relative_accuracy = 0.01)
+      : relative_accuracy_(relative_accuracy),
+        multiplier_(bucketsPerOctave(relative_accuracy)),
+        num_buckets_(static_cast<std::size_t>(
+          std::ceil((kSketchMaxExponent - kSketchMinExponent) * multiplier_)) + 1) {}
+
+    // Adds one value. NaN values are ignored.
+    void add(Q value) {
+      const double v = static_cast<double>(value.getValue());
+      if (v > 0.0) {
+        ++bucketsFor(positive_)[bucketIndex(v)];
+      } else if (v < 0.0) {
+        ++bucketsFor(negative_)[bucketIndex(-v)];
+      } else if (v == 0.0) {
+        ++zeros_;
+      } else {
+        return;
+      }
+      ++count_;
+      sum_ += v;
+      min_ = std::min(min_, v);
+      max_ = std::max(max_, v);
+    }
+
+    // Adds every value of values, a QuantitySpan or QuantityVector.
+    // unsigned threads = 1, Number of threads to split large inputs across, each filling a sketch
+    // of its own that is merged in afterwards. 0 means all cores.
+    void add(QuantitySpan<const Q> values, unsigned threads = 1) {
+      const std::size_t n = values.size();
+      if (threads == 1 || n <= kSketchGrain) {
+        addValues(values.data(), n);
+        return;
+      }
+      // At most 64 partial sketches, however large the input.
+      const std::size_t grain = std::max(kSketchGrain, (n + 63) / 64);
+      std::vector<QuantileSketch> partials((n + grain - 1) / grain,
+                                           QuantileSketch(relative_accuracy_));
+      detail::parallelFor(n, grain, threads,
+                          [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+                            partials[chunk].addValues(values.data() + begin, end - begin);
+                          });
+      for (const QuantileSketch& partial : partials) {
+        merge(partial);
+      }
+    }
+
+    // Adds the counts of other, which must have the same relative accuracy; throws
+    // std::invalid_argument otherwise.
+    void merge(const QuantileSketch& other) {
+      if (other.relative_accuracy_ != relative_accuracy_) {
+        throw std::invalid_argument("uniTypes: cannot merge sketches of different accuracy");
+      }
+      mergeBuckets(positive_, other.positive_);
+      mergeBuckets(negative_, other.negative_);
+      zeros_ += other.zeros_;
+      count_ += other.count_;
+      sum_ += other.sum_;
+      min_ = std::min(min_, other.min_);
+      max_ = std::max(max_, other.max_);
+    }
+
+    // Value below which a fraction q of the values lie, as the element of rank q * (count - 1)
+    // in sorted order would be. Within the relative accuracy of that element, and clamped to
+    // [min, max]. Returns Q() for an empty sketch.
+    Q quantile(double q) const {
+      if (count_ == 0) {
+        return Q();
+      }
+      const double clamped = std::min(std::max(q, 0.0), 1.0);
+      const std::uint64_t rank = static_cast<std::uint64_t>(clamped * (count_ - 1));
+      double value = max_;
+      std::uint64_t seen = 0;
+      bool found = false;
+      // Negative values from the most negative up, then zeros, then positive values.
+      for (std::size_t i = negative_.size(); i-- > 0 && !found;) {
+        seen += negative_[i];
+        if (rank < seen) {
+          value = -bucketValue(i);
+          found = true;
+        }
+      }
+      if (!found && rank < seen + zeros_) {
+        value = 0.0;
+        found = true;
+      }
+      seen += zeros_;
+      for (std::size_t i = 0; i < positive_.size() && !found; ++i) {
+        seen += positive_[i];
+        if (rank < seen) {
+          value = bucketValue(i);
+          found = true;
+        }
+      }
+      return toQuantity(std::min(std::max(value, min_), max_));
+    }
+
+    std::uint64_t count() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    double relativeAccuracy() const { return relative_accuracy_; }
+
+    Q sum() const { return toQuantity(sum_); }
+    Q min() const { return toQuantity(count_ == 0 ? 0.0 : min_); }
+    Q max() const { return toQuantity(count_ == 0 ? 0.0 : max_); }
+
+    // Bytes serialize() writes.
+    std::size_t serializedSize() const {
+      return detail::kSketchHeaderSize +
+             detail::kSketchEntrySize * (nonEmpty(positive_) + nonEmpty(negative_));
+    }
+
+    // Snapshot of the sketch as little-endian bytes, recording the dimension of Q, that
+    // deserialize reads back on any host.
+    std::string serialize() const {
+      std::string out(serializedSize(), '\0');
+      char* data = &out[0];
+      std::memcpy(data, detail::kSketchMagic, sizeof(detail::kSketchMagic));
+      detail::storeLittle<std::uint16_t>(data + 4, kSketchVersion);
+      data[6] = static_cast<char>(Dimension::kExponentScale);
+      const Dimension dimension = dimensionOf<Q>();
+      for (std::size_t i = 0; i < kNumBaseDimensions; ++i) {
+        data[8 + i] = static_cast<char>(dimension.exponents[i]);
+      }
+      detail::storeLittle<double>(data + 16, relative_accuracy_);
+      detail::storeLittle<std::uint64_t>(data + 24, count_);
+      detail::storeLittle<std::uint64_t>(data + 32, zeros_);
+      detail::storeLittle<double>(data + 40, sum_);
+      detail::storeLittle<double>(data + 48, min_);
+      detail::storeLittle<double>(data + 56, max_);
+      detail::storeLittle(data + 64, static_cast<std::uint32_t>(nonEmpty(positive_)));
+      detail::storeLittle(data + 68, static_cast<std::uint32_t>(nonEmpty(negative_)));
+      char* entry = data + detail::kSketchHeaderSize;
+      for (const std::vector<std::uint64_t>* buckets : {&positive_, &negative_}) {
+        for (std::size_t i = 0; i < buckets->size(); ++i) {
+          if ((*buckets)[i] != 0) {
+            detail::storeLittle<std::int32_t>(entry, static_cast<std::int32_t>(i));
+            detail::storeLittle<std::uint64_t>(entry + 4, (*buckets)[i]);
+            entry += detail::kSketchEntrySize;
+          }
+        }
+      }
+      return out;
+    }
+
+    // Sketch from a serialize() snapshot. Throws DimensionMismatch if it was taken of another
+    // dimension and std::invalid_argument if it is not a valid snapshot.
+    static QuantileSketch deserialize(std::string_view bytes) {
+      const char* data = bytes.data();
+      if (bytes.size() < detail::kSketchHeaderSize ||
+          std::memcmp(data, detail::kSketchMagic, sizeof(detail::kSketchMagic)) != 0) {
+        throw std::invalid_argument("uniTypes: not a quantile sketch");
+      }
+      if (detail::loadLittle<std::uint16_t>(data + 4) != kSketchVersion ||
+          data[6] != static_cast<char>(Dimension::kExponentScale)) {
+        throw std::invalid_argument("uniTypes: unsupported quantile sketch version");
+      }
+      Dimension dimension;
+      for (std::size_t i = 0; i < kNumBaseDimensions; ++i) {
+        dimension.exponents[i] = static_cast<std::int8_t>(data[8 + i]);
+      }
+      if (dimension != dimensionOf<Q>()) {
+        throw DimensionMismatch("uniTypes: sketch does not have the requested dimension");
+      }
+
+      QuantileSketch sketch(detail::loadLittle<double>(data + 16));
+      sketch.count_ = detail::loadLittle<std::uint64_t>(data + 24);
+      sketch.zeros_ = detail::loadLittle<std::uint64_t>(data + 32);
+      sketch.sum_ = detail::loadLittle<double>(data + 40);
+      sketch.min_ = detail::loadLittle<double>(data + 48);
+      sketch.max_ = detail::loadLittle<double>(data + 56);
+      const std::size_t num_positive = detail::loadLittle<std::uint32_t>(data + 64);
+      const std::size_t num_negative = detail::loadLittle<std::uint32_t>(data + 68);
+      if ((bytes.size() - detail::kSketchHeaderSize) / detail::kSketchEntrySize <
+          num_positive + num_negative) {
+        throw std::invalid_argument("uniTypes: truncated quantile sketch");
+      }
+      std::uint64_t total = sketch.zeros_;
+      const char* entry = data + detail::kSketchHeaderSize;
+      for (std::size_t i = 0; i < num_positive + num_negative; ++i) {
+        const std::int32_t index = detail::loadLittle<std::int32_t>(entry);
+        const std::uint64_t count = detail::loadLittle<std::uint64_t>(entry + 4);
+        if (index < 0 || static_cast<std::size_t>(index) >= sketch.num_buckets_) {
+          throw std::invalid_argument("uniTypes: quantile sketch bucket out of range");
+        }
+        std::vector<std::uint64_t>& buckets =
+          sketch.bucketsFor(i < num_positive ? sketch.positive_ : sketch.negative_);
+        buckets[static_cast<std::size_t>(index)] += count;
+        total += count;
+        entry += detail::kSketchEntrySize;
+      }
+      if (total != sketch.count_) {
+        throw std::invalid_argument("uniTypes: quantile sketch counts do not add up");
+      }
+      return sketch;
+    }
+
+  private:
+    using rep = typename Q::rep;
+
+    // The mantissa approximation of log2 rises at least as fast as the natural log, so buckets
+    // 1 / multiplier wide in it are at most gamma = (1 + a) / (1 - a) wide, and the harmonic mean
+    // of their bounds is within a of every value in them.
+    static double bucketsPerOctave(double relative_accuracy) {
+      if (!(relative_accuracy >= kSketchMinAccuracy && relative_accuracy < 1.0)) {
+        throw std::invalid_argument("uniTypes: sketch accuracy out of range");
+      }
+      return 1.0 / std::log((1.0 + relative_accuracy) / (1.0 - relative_accuracy));
+    }
+
+    // Buckets of one sign, allocated by the first value of that sign.
+    std::vector<std::uint64_t>& bucketsFor(std::vector<std::uint64_t>& buckets) {
+      if (buckets.empty()) {
+        buckets.assign(num_buckets_, 0);
+      }
+      return buckets;
+    }
+
+    std::uint32_t bucketIndex(double v) const {
+      return detail::sketchBucketIndex(v, multiplier_, static_cast<std::int32_t>(num_buckets_ - 1));
+    }
+
+    // Harmonic mean of the bounds of bucket i, which is within the relative accuracy of both.
+    double bucketValue(std::size_t i) const {
+      const double upper = detail::sketchMagnitude(static_cast<double>(i) / multiplier_);
+      if (i == 0) {
+        return upper;
+      }
+      const double lower = detail::sketchMagnitude(static_cast<double>(i - 1) / multiplier_);
+      return 2.0 * lower * upper / (lower + upper);
+    }
+
+    // Batched add: the bucket indices of a block of values are computed in one vectorized pass,
+    // then counted.
+    void addValues(const rep* values, std::size_t n) {
+      constexpr std::size_t kBlock = 256;
+      std::uint32_t indices[kBlock];
+      double sum = 0.0;
+      double lo = min_;
+      double hi = max_;
+      std::uint64_t added = 0;
+      const double multiplier = multiplier_;
+      const std::int32_t last = static_cast<std::int32_t>(num_buckets_ - 1);
+      for (std::size_t begin = 0; begin < n; begin += kBlock) {
+        const std::size_t size = std::min(kBlock, n - begin);
+        const rep* block = values + begin;
+        detail::sketchBucketIndices(block, size, multiplier, last, indices);
+        for (std::size_t j = 0; j < size; ++j) {
+          const double v = static_cast<double>(block[j]);
+          if (v > 0.0) {
+            ++bucketsFor(positive_)[indices[j]];
+          } else if (v < 0.0) {
+            ++bucketsFor(negative_)[indices[j]];
+          } else if (v == 0.0) {
+            ++zeros_;
+          } else {
+            continue;
+          }
+          ++added;
+          sum += v;
+          lo = std::min(lo, v);
+          hi = std::max(hi, v);
+        }
+      }
+      count_ += added;
+      sum_ += sum;
+      min_ = lo;
+      max_ = hi;
+    }
+
+    void mergeBuckets(std::vector<std::uint64_t>& into, const std::vector<std::uint64_t>& from) {
+      if (from.empty()) {
+        return;
+      }
+      bucketsFor(into);
+      for (std::size_t i = 0; i < num_buckets_; ++i) {
+        into[i] += from[i];
+      }
+    }
+
+    static std::size_t nonEmpty(const std::vector<std::uint64_t>& buckets) {
+      return static_cast<std::size_t>(
+        std::count_if(buckets.begin(), buckets.end(), [](std::uint64_t n) { return n != 0; }));
+    }
+
+    static Q toQuantity(double value) {
+      return Q(static_cast<rep>(value));
+    }
+
+    double relative_accuracy_;
+    double multiplier_;
+    std::size_t num_buckets_;
+    std::vector<std::uint64_t> positive_;
+    std::vector<std::uint64_t> negative_;
+    std::uint64_t zeros_ = 0;
+    std::uint64_t count_ = 0;
+    double sum_ = 0.0;
+    double min_ = std::numeric_limits<double>::infinity();
+    double max_ = -std::numeric_limits<double>::infinity();
+  };
+}
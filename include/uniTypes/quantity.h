@@ -0,0 +1,231 @@
+#pragma once
+#include <uniTypes/dims.h>
+
+#include <type_traits>
+#include <utility>
+
+// Core quantity types: RatioQuantity, the predefined quantity typedefs and their operators.
+namespace uniTypes {
+  // This should not be instantiated directly! Instead use the typedefs below.
+  //
+  // A RatioQuantity is a plain literal value type: it holds nothing but its value, has no vtable
+  // and is trivially copyable, so it is exactly the size of its Rep and can be used in constexpr,
+  // memcpy and vectorized contexts. Quantities whose dimension is only known at runtime use
+  // DynQuantity from uniTypes/dynQuantity.h instead.
+  //
+  // Rep is the type of the stored value. It defaults to double; float halves the memory of large
+  // columns, and integer or long double reps suit exact or high-precision totals. Mixing reps
+  // follows the usual arithmetic conversions (std::common_type), as std::chrono::duration does:
+  // float + double quantities give a double quantity. Quantities convert implicitly to a
+  // floating-point rep and explicitly to an integer one.
+  //
+  // D is the Dims type of the quantity (see uniTypes/dims.h).
+  template<typename D, typename Rep = double>
+  class RatioQuantity {
+  public:
+    using rep = Rep;
+    using dims = D;
+
+    static_assert(std::is_arithmetic<Rep>::value, "RatioQuantity rep must be an arithmetic type");
+
+    constexpr RatioQuantity() : value() {}
+    constexpr RatioQuantity(Rep val) : value(val) {}
+
+    template<typename Rep2, typename R = Rep,
+             std::enable_if_t<std::is_floating_point<R>::value, int> = 0>
+    constexpr RatioQuantity(RatioQuantity<D, Rep2> other)
+      : value(static_cast<Rep>(other.getValue())) {}
+
+    template<typename Rep2, typename R = Rep,
+             std::enable_if_t<!std::is_floating_point<R>::value, int> = 0>
+    constexpr explicit RatioQuantity(RatioQuantity<D, Rep2> other)
+      : value(static_cast<Rep>(other.getValue())) {}
+
+    constexpr RatioQuantity& operator+=(RatioQuantity rhs){
+      value += rhs.value;
+      return *this;
+    }
+
+    constexpr RatioQuantity& operator-=(RatioQuantity rhs){
+      value -= rhs.value;
+      return *this;
+    }
+
+    // Return value of the quantity in multiples of the specified unit.
+    constexpr Rep convertTo(RatioQuantity rhs) const {
+      return value / rhs.value;
+    }
+
+    template<typename Rep2>
+    constexpr std::common_type_t<Rep, Rep2>
+      convertTo(RatioQuantity<D, Rep2> rhs) const
+    {
+      using Common = std::common_type_t<Rep, Rep2>;
+      return static_cast<Common>(value) / static_cast<Common>(rhs.getValue());
+    }
+
+    // Returns the raw value of the quantity.
+    constexpr Rep getValue() const {
+      return value;
+    }
+
+    Rep value;
+  };
+
+  // Specify the predefined physical quantity types.
+  #define QUANTITY_TYPE(_Mdim, _Ldim, _Tdim, name) \
+    typedef RatioQuantity<dims_t<_Mdim, _Ldim, _Tdim>> name;
+
+  // Dimensionless.
+  QUANTITY_TYPE(0, 0, 0, Number);
+
+  // International Unit. Standardized unit of biological activity. No direct conversion to mass so
+  // it has a base dimension of its own.
+  // UOBA stands for "unit of biological activity" here.
+  typedef RatioQuantity<base_dims_t<BaseDimension::IU>> UOBA;
+
+  QUANTITY_TYPE(1, 0, 0, Mass);
+  QUANTITY_TYPE(0, 1, 0, Length);
+  QUANTITY_TYPE(0, 2, 0, Area);
+  QUANTITY_TYPE(0, 3, 0, Volume);
+  QUANTITY_TYPE(0, 0, 1, Time);
+  QUANTITY_TYPE(1, 1, -2, Force);
+  QUANTITY_TYPE(1, 2, -2, Energy);
+
+  // The remaining SI base quantities.
+  typedef RatioQuantity<base_dims_t<BaseDimension::Temperature>> Temperature;
+  typedef RatioQuantity<base_dims_t<BaseDimension::Amount>> Amount;
+  typedef RatioQuantity<base_dims_t<BaseDimension::Current>> Current;
+  typedef RatioQuantity<base_dims_t<BaseDimension::LuminousIntensity>> LuminousIntensity;
+
+  // The quantity type Q with its value stored as Rep, e.g. with_rep_t<Mass, float>.
+  template<typename Q, typename Rep>
+  using with_rep_t = RatioQuantity<typename Q::dims, Rep>;
+
+  static_assert(sizeof(Mass) == sizeof(double), "RatioQuantity must be the size of its value");
+  static_assert(sizeof(with_rep_t<Mass, float>) == sizeof(float),
+                "RatioQuantity must be the size of its value");
+  static_assert(std::is_trivially_copyable<Mass>::value, "RatioQuantity must be trivially copyable");
+
+  // Standard arithmentic operators. Mixed reps give a quantity of their common type.
+  template<typename D, typename R1, typename R2>
+  constexpr RatioQuantity<D, std::common_type_t<R1, R2>>
+    operator+(RatioQuantity<D, R1> lhs, RatioQuantity<D, R2> rhs)
+  {
+    return RatioQuantity<D, std::common_type_t<R1, R2>>(lhs.getValue() + rhs.getValue());
+  }
+
+  template<typename D, typename R1, typename R2>
+  constexpr RatioQuantity<D, std::common_type_t<R1, R2>>
+    operator-(RatioQuantity<D, R1> lhs, RatioQuantity<D, R2> rhs)
+  {
+    return RatioQuantity<D, std::common_type_t<R1, R2>>(lhs.getValue() - rhs.getValue());
+  }
+
+  template<typename S, typename D, typename R,
+           typename = std::enable_if_t<std::is_arithmetic<S>::value>>
+  constexpr RatioQuantity<D, std::common_type_t<S, R>>
+    operator*(S lhs, RatioQuantity<D, R> rhs)
+  {
+    return RatioQuantity<D, std::common_type_t<S, R>>(lhs * rhs.getValue());
+  }
+
+  template<typename D, typename R, typename S,
+           typename = std::enable_if_t<std::is_arithmetic<S>::value>>
+  constexpr RatioQuantity<D, std::common_type_t<R, S>>
+    operator*(RatioQuantity<D, R> lhs, S rhs)
+  {
+    return RatioQuantity<D, std::common_type_t<R, S>>(lhs.getValue() * rhs);
+  }
+
+  template<typename D1, typename R1, typename D2, typename R2>
+  constexpr RatioQuantity<dims_product_t<D1, D2>, std::common_type_t<R1, R2>>
+    operator*(RatioQuantity<D1, R1> lhs, RatioQuantity<D2, R2> rhs)
+  {
+    return RatioQuantity<dims_product_t<D1, D2>, std::common_type_t<R1, R2>>(
+      lhs.getValue() * rhs.getValue());
+  }
+
+  template<typename D, typename R1, typename R2>
+  constexpr std::common_type_t<R1, R2> operator/(RatioQuantity<D, R1> lhs,
+                                                 RatioQuantity<D, R2> rhs)
+  {
+    return lhs.getValue() / rhs.getValue();
+  }
+
+  template<typename D1, typename R1, typename D2, typename R2>
+  constexpr RatioQuantity<dims_quotient_t<D1, D2>, std::common_type_t<R1, R2>>
+    operator/(RatioQuantity<D1, R1> lhs, RatioQuantity<D2, R2> rhs)
+  {
+    return RatioQuantity<dims_quotient_t<D1, D2>, std::common_type_t<R1, R2>>(
+      lhs.getValue() / rhs.getValue());
+  }
+
+  template<typename S, typename D, typename R,
+           typename = std::enable_if_t<std::is_arithmetic<S>::value>>
+  constexpr RatioQuantity<dims_quotient_t<dims_t<0, 0, 0>, D>, std::common_type_t<S, R>>
+    operator/(S x, RatioQuantity<D, R> rhs)
+  {
+    return RatioQuantity<dims_quotient_t<dims_t<0, 0, 0>, D>, std::common_type_t<S, R>>(
+      x / rhs.getValue());
+  }
+
+  template<typename D, typename R, typename S,
+           typename = std::enable_if_t<std::is_arithmetic<S>::value>>
+  constexpr RatioQuantity<D, std::common_type_t<R, S>>
+    operator/(RatioQuantity<D, R> lhs, S x)
+  {
+    return RatioQuantity<D, std::common_type_t<R, S>>( lhs.getValue() / x );
+  }
+
+  // Result types of multiplying and dividing two quantity types. Dividing a quantity by one of the
+  // same dimension yields a plain number, which is mapped back to a dimensionless quantity (Number
+  // for double reps) here.
+  template<typename Q1, typename Q2>
+  using quantity_product_t = decltype(std::declval<Q1>() * std::declval<Q2>());
+
+  template<typename Q1, typename Q2>
+  using quantity_quotient_t = std::conditional_t<
+    std::is_arithmetic<decltype(std::declval<Q1>() / std::declval<Q2>())>::value,
+    with_rep_t<Number, std::common_type_t<typename Q1::rep, typename Q2::rep>>,
+    decltype(std::declval<Q1>() / std::declval<Q2>())>;
+
+  // Comparison operators.
+
+  // This isn't working great with larger numbers since this is a simple double comparison.
+  template<typename D, typename R1, typename R2>
+  constexpr bool operator==(RatioQuantity<D, R1> lhs, RatioQuantity<D, R2> rhs)
+  {
+    return (lhs.getValue() == rhs.getValue());
+  }
+
+  template<typename D, typename R1, typename R2>
+  constexpr bool operator!=(RatioQuantity<D, R1> lhs, RatioQuantity<D, R2> rhs)
+  {
+    return (lhs.getValue() != rhs.getValue());
+  }
+
+  template<typename D, typename R1, typename R2>
+  constexpr bool operator<=(RatioQuantity<D, R1> lhs, RatioQuantity<D, R2> rhs)
+  {
+    return (lhs.getValue() <= rhs.getValue());
+  }
+
+  template<typename D, typename R1, typename R2>
+  constexpr bool operator>=(RatioQuantity<D, R1> lhs, RatioQuantity<D, R2> rhs)
+  {
+    return (lhs.getValue() >= rhs.getValue());
+  }
+
+  template<typename D, typename R1, typename R2>
+  constexpr bool operator<(RatioQuantity<D, R1> lhs, RatioQuantity<D, R2> rhs)
+  {
+    return (lhs.getValue() < rhs.getValue());
+  }
+
+  template<typename D, typename R1, typename R2>
+  constexpr bool operator>(RatioQuantity<D, R1> lhs, RatioQuantity<D, R2> rhs)
+  {
+    return (lhs.getValue() > rhs.getValue());
+  }
+}
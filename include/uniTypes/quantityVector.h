@@ -0,0 +1,375 @@
+#pragma once
+#include <uniTypes.h>
+
+#include <cstddef>
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Structure-of-arrays containers for quantities.
+//
+// A QuantityVector<Mass> owns a contiguous, aligned block of bare doubles and a QuantitySpan<Mass>
+// is a non-owning view onto one. The dimension lives in the type only, so bulk kernels over them
+// compile down to the same loops as over raw double arrays.
+namespace uniTypes {
+  // Alignment of QuantityVector storage. 64 bytes covers a cache line and an AVX-512 register.
+  constexpr std::size_t kQuantityAlignment = 64;
+
+  // Allocator that hands out kQuantityAlignment-aligned storage.
+  template<typename T>
+  class AlignedAllocator {
+  public:
+    using value_type = T;
+
+    AlignedAllocator() = default;
+
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U>&) {}
+
+    T* allocate(std::size_t n) {
+      return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(kQuantityAlignment)));
+    }
+
+    void deallocate(T* ptr, std::size_t) {
+      ::operator delete(ptr, std::align_val_t(kQuantityAlignment));
+    }
+
+    // Growing a vector without a fill value default-initializes, so storage that is about to be
+    // overwritten by an expression is not zeroed first.
+    template<typename U>
+    void construct(U* ptr) noexcept(std::is_nothrow_default_constructible<U>::value) {
+      ::new (static_cast<void*>(ptr)) U;
+    }
+
+    template<typename U, typename... Args>
+    void construct(U* ptr, Args&&... args) {
+      ::new (static_cast<void*>(ptr)) U(std::forward<Args>(args)...);
+    }
+
+    template<typename U>
+    bool operator==(const AlignedAllocator<U>&) const { return true; }
+
+    template<typename U>
+    bool operator!=(const AlignedAllocator<U>&) const { return false; }
+  };
+
+  // Proxy returned when indexing mutable containers, since the elements are stored as bare reps.
+  template<typename Q>
+  class QuantityReference {
+  public:
+    using rep = typename Q::rep;
+
+    explicit QuantityReference(rep* ptr) : ptr_(ptr) {}
+
+    operator Q() const { return Q(*ptr_); }
+
+    QuantityReference& operator=(Q rhs) {
+      *ptr_ = rhs.getValue();
+      return *this;
+    }
+
+    QuantityReference& operator=(const QuantityReference& rhs) {
+      *ptr_ = *rhs.ptr_;
+      return *this;
+    }
+
+    QuantityReference& operator+=(Q rhs) {
+      *ptr_ += rhs.getValue();
+      return *this;
+    }
+
+    QuantityReference& operator-=(Q rhs) {
+      *ptr_ -= rhs.getValue();
+      return *this;
+    }
+
+    rep convertTo(Q unit) const { return Q(*ptr_).convertTo(unit); }
+
+    rep getValue() const { return *ptr_; }
+
+  private:
+    rep* ptr_;
+  };
+
+  // Non-owning view of contiguous quantities. QuantitySpan<const Q> is the read-only flavour.
+  template<typename Q>
+  class QuantitySpan {
+  public:
+    using quantity_type = std::remove_const_t<Q>;
+    using rep = typename quantity_type::rep;
+    using pointer = std::conditional_t<std::is_const<Q>::value, const rep*, rep*>;
+    using reference = std::conditional_t<std::is_const<Q>::value,
+                                         quantity_type,
+                                         QuantityReference<quantity_type>>;
+
+    constexpr QuantitySpan() : data_(nullptr), size_(0) {}
+    constexpr QuantitySpan(pointer data, std::size_t size) : data_(data), size_(size) {}
+
+    // A mutable span converts to a read-only one.
+    template<typename U,
+             typename = std::enable_if_t<std::is_const<Q>::value &&
+                                         std::is_same<U, quantity_type>::value>>
+    constexpr QuantitySpan(QuantitySpan<U> other) : data_(other.data()), size_(other.size()) {}
+
+    constexpr pointer data() const { return data_; }
+    constexpr std::size_t size() const { return size_; }
+    constexpr bool empty() const { return size_ == 0; }
+
+    reference operator[](std::size_t i) const { return reference(data_[i]); }
+
+    // Returns the view of count elements starting at offset.
+    QuantitySpan subspan(std::size_t offset, std::size_t count) const {
+      if (offset > size_ || count > size_ - offset) {
+        throw std::out_of_range("uniTypes: subspan out of range");
+      }
+      return QuantitySpan(data_ + offset, count);
+    }
+
+  private:
+    pointer data_;
+    std::size_t size_;
+  };
+
+  namespace detail {
+    // Specialized in expression.h for lazy element-wise expressions.
+    template<typename T>
+    struct is_quantity_expression : std::false_type {};
+
+    template<typename Q1, typename Q2>
+    struct is_same_dimension : std::is_same<with_rep_t<Q1, typename Q2::rep>, Q2> {};
+
+    // Whether values of quantity type From may be stored as To without an explicit conversion.
+    template<typename From, typename To>
+    struct is_assignable_quantity
+      : std::integral_constant<bool, is_same_dimension<From, To>::value &&
+                                     (std::is_same<typename From::rep, typename To::rep>::value ||
+                                      std::is_floating_point<typename To::rep>::value)> {};
+  }
+
+  // Owning, aligned, contiguous storage of quantities of a single type.
+  template<typename Q>
+  class QuantityVector {
+  public:
+    using quantity_type = Q;
+    using rep = typename Q::rep;
+
+    QuantityVector() = default;
+
+    explicit QuantityVector(std::size_t size, Q fill = Q()) : values_(size, fill.getValue()) {}
+
+    QuantityVector(std::initializer_list<Q> init) {
+      values_.reserve(init.size());
+      for (Q q : init) {
+        values_.push_back(q.getValue());
+      }
+    }
+
+    // Evaluates an element-wise expression (see expression.h) in a single pass.
+    template<typename Expr,
+             typename = std::enable_if_t<detail::is_quantity_expression<Expr>::value>>
+    QuantityVector(const Expr& expr) {
+      *this = expr;
+    }
+
+    template<typename Expr,
+             typename = std::enable_if_t<detail::is_quantity_expression<Expr>::value>>
+    QuantityVector& operator=(const Expr& expr) {
+      static_assert(detail::is_assignable_quantity<typename Expr::quantity_type, Q>::value,
+                    "Expression must have the dimension of the vector it is assigned to");
+      // Storage is only resized, never reallocated, when the size already matches, so the
+      // expression may read from this vector.
+      values_.resize(expr.size());
+      expr.evaluateInto(values_.data());
+      return *this;
+    }
+
+    std::size_t size() const { return values_.size(); }
+    bool empty() const { return values_.empty(); }
+    void reserve(std::size_t n) { values_.reserve(n); }
+    void resize(std::size_t n, Q fill = Q()) { values_.resize(n, fill.getValue()); }
+    void clear() { values_.clear(); }
+    void push_back(Q q) { values_.push_back(q.getValue()); }
+
+    rep* data() { return values_.data(); }
+    const rep* data() const { return values_.data(); }
+
+    QuantityReference<Q> operator[](std::size_t i) { return QuantityReference<Q>(&values_[i]); }
+    Q operator[](std::size_t i) const { return Q(values_[i]); }
+
+    QuantitySpan<Q> span() { return QuantitySpan<Q>(data(), size()); }
+    QuantitySpan<const Q> span() const { return QuantitySpan<const Q>(data(), size()); }
+
+    operator QuantitySpan<Q>() { return span(); }
+    operator QuantitySpan<const Q>() const { return span(); }
+
+  private:
+    std::vector<rep, AlignedAllocator<rep>> values_;
+  };
+
+  namespace detail {
+    template<typename T>
+    struct span_traits {
+      static constexpr bool is_range = false;
+    };
+
+    template<typename Q>
+    struct span_traits<QuantitySpan<Q>> {
+      static constexpr bool is_range = true;
+      using quantity_type = std::remove_const_t<Q>;
+    };
+
+    template<typename Q>
+    struct span_traits<QuantityVector<Q>> {
+      static constexpr bool is_range = true;
+      using quantity_type = Q;
+    };
+
+    template<typename T>
+    using range_traits = span_traits<std::remove_cv_t<std::remove_reference_t<T>>>;
+
+    // Element-wise kernels over raw reps. These are kept as simple counted loops so the compiler
+    // vectorizes them exactly as it would a hand-written loop over std::vector<double>.
+    template<typename Rep, typename Op>
+    inline void transformKernel(const Rep* lhs, const Rep* rhs, Rep* out, std::size_t n, Op op) {
+      for (std::size_t i = 0; i < n; ++i) {
+        out[i] = op(lhs[i], rhs[i]);
+      }
+    }
+
+    template<typename Rep, typename Op>
+    inline void transformKernel(const Rep* in, Rep* out, std::size_t n, Op op) {
+      for (std::size_t i = 0; i < n; ++i) {
+        out[i] = op(in[i]);
+      }
+    }
+
+    inline void checkSizes(std::size_t lhs, std::size_t rhs) {
+      if (lhs != rhs) {
+        throw std::invalid_argument("uniTypes: quantity range sizes do not match");
+      }
+    }
+  }
+
+  // Quantity type stored in a QuantitySpan or QuantityVector.
+  template<typename Range>
+  using range_quantity_t = typename detail::range_traits<Range>::quantity_type;
+
+  // Read-only and mutable views of any quantity range.
+  template<typename Q>
+  QuantitySpan<const Q> constSpan(const QuantityVector<Q>& range) { return range.span(); }
+
+  template<typename Q>
+  QuantitySpan<const Q> constSpan(QuantitySpan<Q> range) { return range; }
+
+  template<typename Q>
+  QuantitySpan<Q> mutableSpan(QuantityVector<Q>& range) { return range.span(); }
+
+  template<typename Q>
+  QuantitySpan<Q> mutableSpan(QuantitySpan<Q> range) {
+    static_assert(!std::is_const<Q>::value, "Output range must not be a read-only span");
+    return range;
+  }
+
+  // ------------------------------------------
+  // Bulk kernels
+  // ------------------------------------------
+  // Each kernel takes any mix of QuantitySpan and QuantityVector arguments and writes into out,
+  // which must already have the same size as the inputs. out may alias an input.
+
+  // out[i] = lhs[i] + rhs[i]
+  template<typename Lhs, typename Rhs, typename Out>
+  void add(const Lhs& lhs, const Rhs& rhs, Out&& out) {
+    static_assert(std::is_same<range_quantity_t<Lhs>, range_quantity_t<Rhs>>::value &&
+                  std::is_same<range_quantity_t<Lhs>, range_quantity_t<Out>>::value,
+                  "Only quantities of the same dimension can be added");
+    auto l = constSpan(lhs);
+    auto r = constSpan(rhs);
+    auto o = mutableSpan(out);
+    detail::checkSizes(l.size(), r.size());
+    detail::checkSizes(l.size(), o.size());
+    detail::transformKernel(l.data(), r.data(), o.data(), o.size(),
+                            [](auto a, auto b) { return a + b; });
+  }
+
+  // out[i] = lhs[i] - rhs[i]
+  template<typename Lhs, typename Rhs, typename Out>
+  void subtract(const Lhs& lhs, const Rhs& rhs, Out&& out) {
+    static_assert(std::is_same<range_quantity_t<Lhs>, range_quantity_t<Rhs>>::value &&
+                  std::is_same<range_quantity_t<Lhs>, range_quantity_t<Out>>::value,
+                  "Only quantities of the same dimension can be subtracted");
+    auto l = constSpan(lhs);
+    auto r = constSpan(rhs);
+    auto o = mutableSpan(out);
+    detail::checkSizes(l.size(), r.size());
+    detail::checkSizes(l.size(), o.size());
+    detail::transformKernel(l.data(), r.data(), o.data(), o.size(),
+                            [](auto a, auto b) { return a - b; });
+  }
+
+  // out[i] = in[i] * factor
+  template<typename In, typename Out>
+  void scale(const In& in, double factor, Out&& out) {
+    static_assert(std::is_same<range_quantity_t<In>, range_quantity_t<Out>>::value,
+                  "Scaling does not change the dimension of a quantity");
+    auto i = constSpan(in);
+    auto o = mutableSpan(out);
+    using rep = typename range_quantity_t<In>::rep;
+    const rep f = static_cast<rep>(factor);
+    detail::checkSizes(i.size(), o.size());
+    detail::transformKernel(i.data(), o.data(), o.size(), [f](auto a) { return a * f; });
+  }
+
+  // out[i] = lhs[i] * rhs[i], where out has the product dimension.
+  template<typename Lhs, typename Rhs, typename Out>
+  void multiply(const Lhs& lhs, const Rhs& rhs, Out&& out) {
+    static_assert(std::is_same<quantity_product_t<range_quantity_t<Lhs>, range_quantity_t<Rhs>>,
+                               range_quantity_t<Out>>::value,
+                  "Output range must have the product dimension of the inputs");
+    auto l = constSpan(lhs);
+    auto r = constSpan(rhs);
+    auto o = mutableSpan(out);
+    detail::checkSizes(l.size(), r.size());
+    detail::checkSizes(l.size(), o.size());
+    detail::transformKernel(l.data(), r.data(), o.data(), o.size(),
+                            [](auto a, auto b) { return a * b; });
+  }
+
+  // out[i] = lhs[i] / rhs[i], where out has the quotient dimension.
+  template<typename Lhs, typename Rhs, typename Out>
+  void divide(const Lhs& lhs, const Rhs& rhs, Out&& out) {
+    static_assert(std::is_same<quantity_quotient_t<range_quantity_t<Lhs>, range_quantity_t<Rhs>>,
+                               range_quantity_t<Out>>::value,
+                  "Output range must have the quotient dimension of the inputs");
+    auto l = constSpan(lhs);
+    auto r = constSpan(rhs);
+    auto o = mutableSpan(out);
+    detail::checkSizes(l.size(), r.size());
+    detail::checkSizes(l.size(), o.size());
+    detail::transformKernel(l.data(), r.data(), o.data(), o.size(),
+                            [](auto a, auto b) { return a / b; });
+  }
+
+  template<typename Q>
+  QuantityVector<Q>& operator+=(QuantityVector<Q>& lhs, const QuantityVector<Q>& rhs) {
+    add(lhs, rhs, lhs);
+    return lhs;
+  }
+
+  template<typename Q>
+  QuantityVector<Q>& operator-=(QuantityVector<Q>& lhs, const QuantityVector<Q>& rhs) {
+    subtract(lhs, rhs, lhs);
+    return lhs;
+  }
+
+  template<typename Q>
+  QuantityVector<Q>& operator*=(QuantityVector<Q>& lhs, double rhs) {
+    scale(lhs, rhs, lhs);
+    return lhs;
+  }
+}
+
+// Element-wise arithmetic operators over these containers build lazy expressions.
+#include <uniTypes/expression.h>
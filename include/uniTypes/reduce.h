@@ -0,0 +1,265 @@
+#pragma once
+#include <uniTypes.h>
+#include <uniTypes/expression.h>
+#include <uniTypes/parallel.h>
+#include <uniTypes/quantityVector.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Dimension-preserving reductions over quantity ranges.
+//
+// Every reduction accepts a QuantityVector, a QuantitySpan or a lazy expression (so
+// sum(force * distance) needs no temporary), and returns a quantity: the sum of Energy values is
+// an Energy, the variance of Mass values is a Mass squared.
+//
+// Floating-point sums use Neumaier compensated summation in double, which keeps the error of
+// adding millions of values close to that of a single rounding; integer sums are exact in the
+// rep. Means and variances of integer quantities are returned in double. Large ranges are split
+// into chunks of kReduceGrain elements that threads claim dynamically; the per-chunk results are
+// always merged in chunk order, so the answer is bit-for-bit the same for any thread count.
+namespace uniTypes {
+  // Elements per chunk. Chunk boundaries are part of the result, so this is fixed rather than
+  // derived from the thread count.
+  constexpr std::size_t kReduceGrain = std::size_t(1) << 16;
+
+  namespace detail {
+    // Running sum with a separate Neumaier compensation term.
+    struct NeumaierSum {
+      double sum = 0.0;
+      double compensation = 0.0;
+
+      void add(double x) {
+        const double t = sum + x;
+        if (std::fabs(sum) >= std::fabs(x)) {
+          compensation += (sum - t) + x;
+        } else {
+          compensation += (x - t) + sum;
+        }
+        sum = t;
+      }
+
+      void merge(const NeumaierSum& other) {
+        add(other.sum);
+        add(other.compensation);
+      }
+
+      double result() const { return sum + compensation; }
+    };
+
+    // Plain running sum for integer reps, which need no compensation.
+    template<typename Rep>
+    struct IntegerSum {
+      Rep sum = 0;
+
+      void add(Rep x) { sum += x; }
+      void merge(const IntegerSum& other) { sum += other.sum; }
+      Rep result() const { return sum; }
+    };
+
+    template<typename Rep>
+    using sum_partial_t =
+      std::conditional_t<std::is_integral<Rep>::value, IntegerSum<Rep>, NeumaierSum>;
+
+    // Smallest and largest non-NaN values seen.
+    template<typename Rep>
+    struct MinMax {
+      static constexpr bool kHasInfinity = std::numeric_limits<Rep>::has_infinity;
+
+      Rep min = kHasInfinity ? std::numeric_limits<Rep>::infinity()
+                             : std::numeric_limits<Rep>::max();
+      Rep max = kHasInfinity ? -std::numeric_limits<Rep>::infinity()
+                             : std::numeric_limits<Rep>::lowest();
+
+      void add(Rep x) {
+        min = x < min ? x : min;
+        max = x > max ? x : max;
+      }
+
+      void merge(const MinMax& other) {
+        min = other.min < min ? other.min : min;
+        max = other.max > max ? other.max : max;
+      }
+    };
+
+    // Count, mean and sum of squared deviations (Welford), merged with Chan et al.'s formula.
+    struct Moments {
+      double count = 0.0;
+      double mean = 0.0;
+      double m2 = 0.0;
+
+      void add(double x) {
+        count += 1.0;
+        const double delta = x - mean;
+        mean += delta / count;
+        m2 += delta * (x - mean);
+      }
+
+      void merge(const Moments& other) {
+        if (other.count == 0.0) {
+          return;
+        }
+        const double total = count + other.count;
+        const double delta = other.mean - mean;
+        mean += delta * (other.count / total);
+        m2 += other.m2 + delta * delta * (count * other.count / total);
+        count = total;
+      }
+    };
+
+    // Number of independent accumulators interleaved within a chunk. They break the loop-carried
+    // dependency of a single accumulator and are merged in a fixed order.
+    constexpr std::size_t kReduceLanes = 4;
+
+    template<typename Partial, typename Operand>
+    Partial reduceChunk(const Operand& operand, std::size_t begin, std::size_t end) {
+      const Operand local = operand;
+      Partial lanes[kReduceLanes];
+      std::size_t i = begin;
+      for (; i + kReduceLanes <= end; i += kReduceLanes) {
+        for (std::size_t lane = 0; lane < kReduceLanes; ++lane) {
+          lanes[lane].add(local[i + lane]);
+        }
+      }
+      for (; i < end; ++i) {
+        lanes[0].add(local[i]);
+      }
+      for (std::size_t lane = 1; lane < kReduceLanes; ++lane) {
+        lanes[0].merge(lanes[lane]);
+      }
+      return lanes[0];
+    }
+
+    // Reduces operand chunk by chunk on up to threads threads and merges the chunks in order.
+    template<typename Partial, typename Operand>
+    Partial reduceRange(const Operand& operand, unsigned threads) {
+      const std::size_t n = operand.size();
+      if (threads == 1 || n <= kReduceGrain) {
+        Partial result;
+        for (std::size_t begin = 0; begin < n; begin += kReduceGrain) {
+          result.merge(reduceChunk<Partial>(operand, begin, std::min(n, begin + kReduceGrain)));
+        }
+        return result;
+      }
+
+      std::vector<Partial> partials((n + kReduceGrain - 1) / kReduceGrain);
+      parallelFor(n, kReduceGrain, threads,
+                  [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+                    partials[chunk] = reduceChunk<Partial>(operand, begin, end);
+                  });
+      Partial result;
+      for (const Partial& partial : partials) {
+        result.merge(partial);
+      }
+      return result;
+    }
+
+    template<typename Range>
+    using enable_if_reducible_t = std::enable_if_t<is_elementwise_operand<Range>::value>;
+
+    template<typename Range>
+    using reduced_quantity_t =
+      typename decltype(toOperand(std::declval<const Range&>()))::quantity_type;
+
+    // Quantity returned by mean and variance: integer reps are widened to double.
+    template<typename Q>
+    using floating_quantity_t =
+      std::conditional_t<std::is_floating_point<typename Q::rep>::value, Q, with_rep_t<Q, double>>;
+
+    inline void checkNotEmpty(std::size_t n) {
+      if (n == 0) {
+        throw std::invalid_argument("uniTypes: cannot reduce an empty range");
+      }
+    }
+  }
+
+  // ------------------------------------------
+  // sum
+  // ------------------------------------------
+  // Compensated (or, for integer reps, exact) sum of all elements of range.
+  // unsigned threads = 1, Number of threads to split large inputs across. 0 means all cores.
+  template<typename Range, typename = detail::enable_if_reducible_t<Range>>
+  detail::reduced_quantity_t<Range> sum(const Range& range, unsigned threads = 1) {
+    using Q = detail::reduced_quantity_t<Range>;
+    using Partial = detail::sum_partial_t<typename Q::rep>;
+    const auto operand = detail::toOperand(range);
+    return Q(static_cast<typename Q::rep>(detail::reduceRange<Partial>(operand, threads).result()));
+  }
+
+  // ------------------------------------------
+  // dot
+  // ------------------------------------------
+  // Compensated sum of lhs[i] * rhs[i], in the product dimension (Force . Length is Energy).
+  // Throws std::invalid_argument if the sizes differ.
+  template<typename Lhs, typename Rhs,
+           typename = detail::enable_if_reducible_t<Lhs>,
+           typename = detail::enable_if_reducible_t<Rhs>>
+  auto dot(const Lhs& lhs, const Rhs& rhs, unsigned threads = 1) {
+    return sum(lhs * rhs, threads);
+  }
+
+  // ------------------------------------------
+  // mean
+  // ------------------------------------------
+  // Arithmetic mean of range. Throws std::invalid_argument if range is empty.
+  template<typename Range, typename = detail::enable_if_reducible_t<Range>>
+  detail::floating_quantity_t<detail::reduced_quantity_t<Range>>
+  mean(const Range& range, unsigned threads = 1) {
+    using Q = detail::floating_quantity_t<detail::reduced_quantity_t<Range>>;
+    const auto operand = detail::toOperand(range);
+    detail::checkNotEmpty(operand.size());
+    const double total = detail::reduceRange<detail::NeumaierSum>(operand, threads).result();
+    return Q(static_cast<typename Q::rep>(total / static_cast<double>(operand.size())));
+  }
+
+  // ------------------------------------------
+  // minMax
+  // ------------------------------------------
+  // Smallest and largest elements of range. NaN elements (e.g. missing cells from ingest.h) are
+  // skipped; if every element is NaN the result is (+inf, -inf). Throws std::invalid_argument if
+  // range is empty.
+  template<typename Range, typename = detail::enable_if_reducible_t<Range>>
+  std::pair<detail::reduced_quantity_t<Range>, detail::reduced_quantity_t<Range>>
+  minMax(const Range& range, unsigned threads = 1) {
+    using Q = detail::reduced_quantity_t<Range>;
+    using Partial = detail::MinMax<typename Q::rep>;
+    const auto operand = detail::toOperand(range);
+    detail::checkNotEmpty(operand.size());
+    const Partial result = detail::reduceRange<Partial>(operand, threads);
+    return {Q(result.min), Q(result.max)};
+  }
+
+  template<typename Range, typename = detail::enable_if_reducible_t<Range>>
+  detail::reduced_quantity_t<Range> min(const Range& range, unsigned threads = 1) {
+    return minMax(range, threads).first;
+  }
+
+  template<typename Range, typename = detail::enable_if_reducible_t<Range>>
+  detail::reduced_quantity_t<Range> max(const Range& range, unsigned threads = 1) {
+    return minMax(range, threads).second;
+  }
+
+  // ------------------------------------------
+  // variance
+  // ------------------------------------------
+  // Population variance of range, in the squared dimension (Mass -> Mass * Mass). Pass
+  // sample = true for the unbiased sample variance. Throws std::invalid_argument if range is empty
+  // (or has a single element when sample is set).
+  template<typename Range, typename = detail::enable_if_reducible_t<Range>,
+           typename Q = detail::floating_quantity_t<detail::reduced_quantity_t<Range>>>
+  quantity_product_t<Q, Q> variance(const Range& range, bool sample = false, unsigned threads = 1) {
+    const auto operand = detail::toOperand(range);
+    detail::checkNotEmpty(operand.size());
+    detail::checkNotEmpty(operand.size() - (sample ? 1 : 0));
+    const detail::Moments moments = detail::reduceRange<detail::Moments>(operand, threads);
+    const double divisor = moments.count - (sample ? 1.0 : 0.0);
+    using Result = quantity_product_t<Q, Q>;
+    return Result(static_cast<typename Result::rep>(moments.m2 / divisor));
+  }
+}
@@ -0,0 +1,337 @@
+#pragma once
+#include <uniTypes.h>
+
+#include <cstdint>
+#include <ratio>
+#include <type_traits>
+
+// Quantities with a compile-time scale, in the style of std::chrono::duration.
+//
+// A ScaledQuantity<Mass, std::micro, std::int64_t> stores a whole number of milligrams: its value
+// is a count of (std::micro * the SI unit of Mass), and the SI unit of Mass is the kilogram.
+// Because the scale is a std::ratio, converting between two scales reduces at compile time to
+// multiplying and/or dividing by the constants of a single reduced ratio (or to nothing at all),
+// with none of the rounding that chains such as `pound = 16 * ounce` accumulate. Integer
+// representations make aggregation exact.
+//
+// Conversions that can lose information (to an integer representation with a coarser scale, or
+// from a floating-point representation to an integer one) must be spelled out with quantityCast,
+// which truncates toward zero like std::chrono::duration_cast.
+namespace uniTypes {
+  template<typename Q, typename Scale = std::ratio<1>, typename Rep = double>
+  class ScaledQuantity;
+
+  namespace detail {
+    template<typename T>
+    struct is_scaled_quantity : std::false_type {};
+
+    template<typename Q, typename Scale, typename Rep>
+    struct is_scaled_quantity<ScaledQuantity<Q, Scale, Rep>> : std::true_type {};
+
+    constexpr std::intmax_t gcd(std::intmax_t a, std::intmax_t b) {
+      while (b != 0) {
+        const std::intmax_t t = a % b;
+        a = b;
+        b = t;
+      }
+      return a < 0 ? -a : a;
+    }
+
+    // Largest scale that both S1 and S2 are whole multiples of.
+    template<typename S1, typename S2>
+    using common_scale_t = std::ratio<gcd(S1::num, S2::num),
+                                      (S1::den / gcd(S1::den, S2::den)) * S2::den>;
+
+    // From and To are ScaledQuantity types of the same quantity.
+    template<typename From, typename To>
+    constexpr typename To::rep scaleCount(typename From::rep count) {
+      using Factor = std::ratio_divide<typename From::scale, typename To::scale>;
+      using Common = std::common_type_t<typename To::rep, typename From::rep, std::intmax_t>;
+      if (Factor::num == 1 && Factor::den == 1) {
+        return static_cast<typename To::rep>(count);
+      } else if (Factor::den == 1) {
+        return static_cast<typename To::rep>(static_cast<Common>(count) *
+                                             static_cast<Common>(Factor::num));
+      } else if (Factor::num == 1) {
+        return static_cast<typename To::rep>(static_cast<Common>(count) /
+                                             static_cast<Common>(Factor::den));
+      } else {
+        return static_cast<typename To::rep>(static_cast<Common>(count) *
+                                             static_cast<Common>(Factor::num) /
+                                             static_cast<Common>(Factor::den));
+      }
+    }
+
+    // Whether a From can be converted to a To without losing information, which is when the
+    // implicit conversion is allowed.
+    template<typename From, typename To>
+    struct is_exact_scale_conversion
+      : std::integral_constant<bool,
+          std::is_floating_point<typename To::rep>::value ||
+          (std::ratio_divide<typename From::scale, typename To::scale>::den == 1 &&
+           !std::is_floating_point<typename From::rep>::value)> {};
+  }
+
+  template<typename Q, typename Scale, typename Rep>
+  class ScaledQuantity {
+  public:
+    using quantity_type = Q;
+    using scale = typename Scale::type;
+    using rep = Rep;
+
+    static_assert(scale::num > 0, "Scale must be positive");
+    static_assert(!detail::is_scaled_quantity<Rep>::value, "Rep must be an arithmetic type");
+
+    constexpr ScaledQuantity() : count_() {}
+
+    // Count of scale units. A floating-point count only converts to a floating-point rep.
+    template<typename Rep2,
+             typename = std::enable_if_t<std::is_convertible<const Rep2&, Rep>::value &&
+                                         (std::is_floating_point<Rep>::value ||
+                                          !std::is_floating_point<Rep2>::value)>>
+    constexpr explicit ScaledQuantity(const Rep2& count) : count_(static_cast<Rep>(count)) {}
+
+    // Lossless conversion from another scale or representation.
+    template<typename Scale2, typename Rep2,
+             typename = std::enable_if_t<detail::is_exact_scale_conversion<
+               ScaledQuantity<Q, Scale2, Rep2>, ScaledQuantity>::value>>
+    constexpr ScaledQuantity(const ScaledQuantity<Q, Scale2, Rep2>& other)
+      : count_(detail::scaleCount<ScaledQuantity<Q, Scale2, Rep2>, ScaledQuantity>(
+          other.count())) {}
+
+    // Number of scale units held.
+    constexpr Rep count() const { return count_; }
+
+    // The same quantity as a plain SI-valued RatioQuantity.
+    constexpr operator Q() const {
+      return Q(static_cast<double>(count_) * static_cast<double>(scale::num) /
+               static_cast<double>(scale::den));
+    }
+
+    constexpr ScaledQuantity operator+() const { return *this; }
+    constexpr ScaledQuantity operator-() const { return ScaledQuantity(-count_); }
+
+    constexpr ScaledQuantity& operator+=(const ScaledQuantity& rhs) {
+      count_ += rhs.count_;
+      return *this;
+    }
+
+    constexpr ScaledQuantity& operator-=(const ScaledQuantity& rhs) {
+      count_ -= rhs.count_;
+      return *this;
+    }
+
+    constexpr ScaledQuantity& operator*=(const Rep& rhs) {
+      count_ *= rhs;
+      return *this;
+    }
+
+    constexpr ScaledQuantity& operator/=(const Rep& rhs) {
+      count_ /= rhs;
+      return *this;
+    }
+
+  private:
+    Rep count_;
+  };
+
+  static_assert(sizeof(ScaledQuantity<Mass, std::micro, std::int64_t>) == sizeof(std::int64_t),
+                "ScaledQuantity must be the size of its rep");
+  static_assert(std::is_trivially_copyable<ScaledQuantity<Mass, std::micro, std::int64_t>>::value,
+                "ScaledQuantity must be trivially copyable");
+
+  // ------------------------------------------
+  // quantityCast
+  // ------------------------------------------
+  // Converts from to the scale and representation of To, truncating toward zero when To has an
+  // integer rep. A plain RatioQuantity is treated as a count of SI units.
+  template<typename To, typename Q, typename Scale, typename Rep,
+           typename = std::enable_if_t<detail::is_scaled_quantity<To>::value>>
+  constexpr To quantityCast(const ScaledQuantity<Q, Scale, Rep>& from) {
+    static_assert(std::is_same<typename To::quantity_type, Q>::value,
+                  "Can only cast between scales of the same quantity type");
+    return To(detail::scaleCount<ScaledQuantity<Q, Scale, Rep>, To>(from.count()));
+  }
+
+  template<typename To, typename D, typename Rep,
+           typename = std::enable_if_t<detail::is_scaled_quantity<To>::value>>
+  constexpr To quantityCast(RatioQuantity<D, Rep> from) {
+    return quantityCast<To>(ScaledQuantity<RatioQuantity<D>, std::ratio<1>, Rep>(
+      from.getValue()));
+  }
+}
+
+namespace std {
+  // Result of mixing two scales of a quantity: the largest scale both are whole multiples of and
+  // the common representation, as for std::chrono::duration.
+  template<typename Q, typename S1, typename R1, typename S2, typename R2>
+  struct common_type<uniTypes::ScaledQuantity<Q, S1, R1>, uniTypes::ScaledQuantity<Q, S2, R2>> {
+    using type = uniTypes::ScaledQuantity<
+      Q, uniTypes::detail::common_scale_t<typename S1::type, typename S2::type>,
+      common_type_t<R1, R2>>;
+  };
+}
+
+namespace uniTypes {
+  // Arithmetic and comparisons between scales of the same quantity work on the common type, so
+  // adding grams to pounds is exact when both are integers.
+  template<typename Q, typename S1, typename R1, typename S2, typename R2>
+  constexpr auto operator+(const ScaledQuantity<Q, S1, R1>& lhs,
+                           const ScaledQuantity<Q, S2, R2>& rhs)
+  {
+    using Common = std::common_type_t<ScaledQuantity<Q, S1, R1>, ScaledQuantity<Q, S2, R2>>;
+    return Common(Common(lhs).count() + Common(rhs).count());
+  }
+
+  template<typename Q, typename S1, typename R1, typename S2, typename R2>
+  constexpr auto operator-(const ScaledQuantity<Q, S1, R1>& lhs,
+                           const ScaledQuantity<Q, S2, R2>& rhs)
+  {
+    using Common = std::common_type_t<ScaledQuantity<Q, S1, R1>, ScaledQuantity<Q, S2, R2>>;
+    return Common(Common(lhs).count() - Common(rhs).count());
+  }
+
+  template<typename Q, typename S, typename R, typename R2,
+           typename = std::enable_if_t<std::is_arithmetic<R2>::value>>
+  constexpr auto operator*(const ScaledQuantity<Q, S, R>& lhs, const R2& rhs) {
+    using Result = ScaledQuantity<Q, S, std::common_type_t<R, R2>>;
+    return Result(Result(lhs).count() * rhs);
+  }
+
+  template<typename Q, typename S, typename R, typename R2,
+           typename = std::enable_if_t<std::is_arithmetic<R2>::value>>
+  constexpr auto operator*(const R2& lhs, const ScaledQuantity<Q, S, R>& rhs) {
+    return rhs * lhs;
+  }
+
+  template<typename Q, typename S, typename R, typename R2,
+           typename = std::enable_if_t<std::is_arithmetic<R2>::value>>
+  constexpr auto operator/(const ScaledQuantity<Q, S, R>& lhs, const R2& rhs) {
+    using Result = ScaledQuantity<Q, S, std::common_type_t<R, R2>>;
+    return Result(Result(lhs).count() / rhs);
+  }
+
+  // Ratio of two amounts of the same quantity, as a plain number.
+  template<typename Q, typename S1, typename R1, typename S2, typename R2>
+  constexpr auto operator/(const ScaledQuantity<Q, S1, R1>& lhs,
+                           const ScaledQuantity<Q, S2, R2>& rhs)
+  {
+    using Common = std::common_type_t<ScaledQuantity<Q, S1, R1>, ScaledQuantity<Q, S2, R2>>;
+    return Common(lhs).count() / Common(rhs).count();
+  }
+
+  // Products, and quotients of different quantities, multiply or divide the scales too.
+  template<typename Q1, typename S1, typename R1, typename Q2, typename S2, typename R2>
+  constexpr auto operator*(const ScaledQuantity<Q1, S1, R1>& lhs,
+                           const ScaledQuantity<Q2, S2, R2>& rhs)
+  {
+    using Result = ScaledQuantity<quantity_product_t<Q1, Q2>, std::ratio_multiply<S1, S2>,
+                                  std::common_type_t<R1, R2>>;
+    return Result(lhs.count() * rhs.count());
+  }
+
+  template<typename Q1, typename S1, typename R1, typename Q2, typename S2, typename R2,
+           typename = std::enable_if_t<!std::is_same<Q1, Q2>::value>>
+  constexpr auto operator/(const ScaledQuantity<Q1, S1, R1>& lhs,
+                           const ScaledQuantity<Q2, S2, R2>& rhs)
+  {
+    using Result = ScaledQuantity<quantity_quotient_t<Q1, Q2>, std::ratio_divide<S1, S2>,
+                                  std::common_type_t<R1, R2>>;
+    return Result(lhs.count() / rhs.count());
+  }
+
+  template<typename Q, typename S1, typename R1, typename S2, typename R2>
+  constexpr bool operator==(const ScaledQuantity<Q, S1, R1>& lhs,
+                            const ScaledQuantity<Q, S2, R2>& rhs)
+  {
+    using Common = std::common_type_t<ScaledQuantity<Q, S1, R1>, ScaledQuantity<Q, S2, R2>>;
+    return Common(lhs).count() == Common(rhs).count();
+  }
+
+  template<typename Q, typename S1, typename R1, typename S2, typename R2>
+  constexpr bool operator!=(const ScaledQuantity<Q, S1, R1>& lhs,
+                            const ScaledQuantity<Q, S2, R2>& rhs)
+  {
+    return !(lhs == rhs);
+  }
+
+  template<typename Q, typename S1, typename R1, typename S2, typename R2>
+  constexpr bool operator<(const ScaledQuantity<Q, S1, R1>& lhs,
+                           const ScaledQuantity<Q, S2, R2>& rhs)
+  {
+    using Common = std::common_type_t<ScaledQuantity<Q, S1, R1>, ScaledQuantity<Q, S2, R2>>;
+    return Common(lhs).count() < Common(rhs).count();
+  }
+
+  template<typename Q, typename S1, typename R1, typename S2, typename R2>
+  constexpr bool operator>(const ScaledQuantity<Q, S1, R1>& lhs,
+                           const ScaledQuantity<Q, S2, R2>& rhs)
+  {
+    return rhs < lhs;
+  }
+
+  template<typename Q, typename S1, typename R1, typename S2, typename R2>
+  constexpr bool operator<=(const ScaledQuantity<Q, S1, R1>& lhs,
+                            const ScaledQuantity<Q, S2, R2>& rhs)
+  {
+    return !(rhs < lhs);
+  }
+
+  template<typename Q, typename S1, typename R1, typename S2, typename R2>
+  constexpr bool operator>=(const ScaledQuantity<Q, S1, R1>& lhs,
+                            const ScaledQuantity<Q, S2, R2>& rhs)
+  {
+    return !(lhs < rhs);
+  }
+
+  // Exact scales, relative to the SI unit of their quantity type, of the units in uniTypes.h. The
+  // US customary volumes follow uniTypes.h in taking a gallon as 3.78541 liters.
+  namespace scales {
+    using milligram = std::micro;
+    using gram = std::milli;
+    using kilogram = std::ratio<1>;
+    using ton = std::kilo;
+    using pound = std::ratio<45359237, 100000000>;
+    using ounce = std::ratio_divide<pound, std::ratio<16>>;
+    using stone = std::ratio_multiply<pound, std::ratio<14>>;
+
+    using millimeter = std::milli;
+    using centimeter = std::centi;
+    using meter = std::ratio<1>;
+    using kilometer = std::kilo;
+    using inch = std::ratio<254, 10000>;
+    using foot = std::ratio_multiply<inch, std::ratio<12>>;
+    using yard = std::ratio_multiply<foot, std::ratio<3>>;
+    using mile = std::ratio_multiply<foot, std::ratio<5280>>;
+
+    using milliliter = std::micro;
+    using liter = std::milli;
+    using gallon = std::ratio<378541, 100000000>;
+    using quart = std::ratio_divide<gallon, std::ratio<4>>;
+    using cup = std::ratio_divide<quart, std::ratio<2>>;
+    using floz = std::ratio_divide<cup, std::ratio<8>>;
+    using tablespoon = std::ratio_divide<cup, std::ratio<16>>;
+    using teaspoon = std::ratio_divide<tablespoon, std::ratio<3>>;
+
+    using nanosecond = std::nano;
+    using microsecond = std::micro;
+    using millisecond = std::milli;
+    using second = std::ratio<1>;
+    using minute = std::ratio<60>;
+    using hour = std::ratio<3600>;
+    using day = std::ratio<86400>;
+
+    using joule = std::ratio<1>;
+    using kilojoule = std::kilo;
+    using kilocalorie = std::ratio<4184>;
+  }
+
+  // Integer counts of common units.
+  using Milligrams = ScaledQuantity<Mass, scales::milligram, std::int64_t>;
+  using Grams = ScaledQuantity<Mass, scales::gram, std::int64_t>;
+  using Millimeters = ScaledQuantity<Length, scales::millimeter, std::int64_t>;
+  using Milliliters = ScaledQuantity<Volume, scales::milliliter, std::int64_t>;
+  using Nanoseconds = ScaledQuantity<Time, scales::nanosecond, std::int64_t>;
+  using Milliseconds = ScaledQuantity<Time, scales::millisecond, std::int64_t>;
+  using Seconds = ScaledQuantity<Time, scales::second, std::int64_t>;
+}
@@ -0,0 +1,380 @@
+#pragma once
+#include <uniTypes.h>
+#include <uniTypes/quantityVector.h>
+#include <uniTypes/reduce.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <stdexcept>
+
+// Quantities sampled over time, such as Mass readings from a scale or Energy intake per meal.
+//
+// A TimeSeries<Q> keeps its timestamps and its values in two aligned columns of raw reps, so
+// lookups search a plain array of doubles and bulk operations run over contiguous memory.
+// Timestamps are Time quantities in seconds from any epoch the caller chooses, and never
+// decrease. Range lookups are binary searches; batched interpolation finds the segment of each
+// query first and then interpolates whole blocks in a loop the compiler vectorizes. TimeWindow
+// keeps the sum, mean, min and max of a trailing window up to date as samples are appended.
+namespace uniTypes {
+  // How resample combines the samples of one interval.
+  enum class Aggregation {
+    Sum,
+    Mean,
+    // Value of the latest sample in the interval.
+    Last
+  };
+
+  // Samples of a TimeSeries within a time range.
+  template<typename Q>
+  struct TimeSeriesSlice {
+    // Index of the first sample of the slice in its series.
+    std::size_t offset;
+    QuantitySpan<const Time> times;
+    QuantitySpan<const Q> values;
+
+    std::size_t size() const { return times.size(); }
+    bool empty() const { return times.empty(); }
+  };
+
+  // Queries interpolated per block by TimeSeries::interpolate.
+  constexpr std::size_t kInterpolateBlock = 256;
+
+  namespace detail {
+    // Index of the first element of sorted[0, n) greater than value, searched for by galloping
+    // forward from hint, which must not be past it. O(log distance).
+    inline std::size_t gallopUpperBound(const double* sorted, std::size_t n, std::size_t hint,
+                                        double value) {
+      std::size_t lo = hint;
+      std::size_t step = 1;
+      std::size_t hi = hint;
+      while (hi < n && !(value < sorted[hi])) {
+        lo = hi + 1;
+        hi += step;
+        step *= 2;
+      }
+      return static_cast<std::size_t>(
+        std::upper_bound(sorted + lo, sorted + std::min(hi, n), value) - sorted);
+    }
+
+    // out[i] = linear interpolation at queries[i] on the segment starting at segments[i], for
+    // n <= kInterpolateBlock, with the fraction clamped to [0, 1] so queries outside the series
+    // hold its end values. The results go to a local block first: stores through out could
+    // alias the inputs and would keep the compiler from vectorizing the gathers.
+    template<typename Rep>
+    void interpolateSegments(const double* times, const Rep* values, const double* queries,
+                             const std::size_t* segments, std::size_t n, Rep* out) {
+      Rep block[kInterpolateBlock];
+      for (std::size_t i = 0; i < n; ++i) {
+        const std::size_t k = segments[i];
+        const double t0 = times[k];
+        const double dt = times[k + 1] - t0;
+        const double v0 = static_cast<double>(values[k]);
+        const double dv = static_cast<double>(values[k + 1]) - v0;
+        // Divided unconditionally, so the loop has no branch; repeated times select 1.
+        double fraction = (queries[i] - t0) / dt;
+        fraction = dt > 0.0 ? fraction : 1.0;
+        fraction = fraction < 0.0 ? 0.0 : fraction;
+        fraction = fraction > 1.0 ? 1.0 : fraction;
+        block[i] = static_cast<Rep>(v0 + dv * fraction);
+      }
+      std::copy(block, block + n, out);
+    }
+  }
+
+  template<typename Q>
+  class TimeSeries {
+  public:
+    using quantity_type = Q;
+    using rep = typename Q::rep;
+
+    TimeSeries() = default;
+
+    std::size_t size() const { return times_.size(); }
+    bool empty() const { return times_.empty(); }
+    void reserve(std::size_t n) {
+      times_.reserve(n);
+      values_.reserve(n);
+    }
+    void clear() {
+      times_.clear();
+      values_.clear();
+    }
+
+    // Appends one sample. Throws std::invalid_argument if time is not finite or is before the
+    // latest sample; samples at the same time are kept in the order they were appended.
+    void append(Time time, Q value) {
+      if (!std::isfinite(time.getValue())) {
+        throw std::invalid_argument("uniTypes: time series times must be finite");
+      }
+      if (!times_.empty() && time.getValue() < times_.data()[times_.size() - 1]) {
+        throw std::invalid_argument("uniTypes: time series samples must not go back in time");
+      }
+      times_.push_back(time);
+      values_.push_back(value);
+    }
+
+    // Appends a batch of samples. Throws std::invalid_argument, without appending anything, if
+    // the sizes differ or the times are not finite or out of order.
+    void append(QuantitySpan<const Time> times, QuantitySpan<const Q> values) {
+      const std::size_t n = times.size();
+      if (values.size() != n) {
+        throw std::invalid_argument("uniTypes: time series batch sizes differ");
+      }
+      if (n == 0) {
+        return;
+      }
+      const double* t = times.data();
+      bool finite = true;
+      for (std::size_t i = 0; i < n; ++i) {
+        finite &= std::isfinite(t[i]);
+      }
+      if (!finite) {
+        throw std::invalid_argument("uniTypes: time series times must be finite");
+      }
+      bool ordered = times_.empty() || !(t[0] < times_.data()[times_.size() - 1]);
+      for (std::size_t i = 1; i < n; ++i) {
+        ordered &= !(t[i] < t[i - 1]);
+      }
+      if (!ordered) {
+        throw std::invalid_argument("uniTypes: time series samples must not go back in time");
+      }
+      const std::size_t old_size = times_.size();
+      times_.resize(old_size + n);
+      values_.resize(old_size + n);
+      std::copy(t, t + n, times_.data() + old_size);
+      std::copy(values.data(), values.data() + n, values_.data() + old_size);
+    }
+
+    Time time(std::size_t i) const { return times_[i]; }
+    Q value(std::size_t i) const { return values_[i]; }
+
+    QuantitySpan<const Time> times() const { return times_.span(); }
+    QuantitySpan<const Q> values() const { return values_.span(); }
+
+    // Index of the first sample at or after time. O(log n).
+    std::size_t lowerBound(Time time) const {
+      const double* t = times_.data();
+      return static_cast<std::size_t>(std::lower_bound(t, t + size(), time.getValue()) - t);
+    }
+
+    // Index of the first sample after time. O(log n).
+    std::size_t upperBound(Time time) const {
+      const double* t = times_.data();
+      return static_cast<std::size_t>(std::upper_bound(t, t + size(), time.getValue()) - t);
+    }
+
+    // Samples with begin <= time < end. O(log n).
+    TimeSeriesSlice<Q> slice(Time begin, Time end) const {
+      const std::size_t first = lowerBound(begin);
+      const std::size_t last = std::max(first, lowerBound(end));
+      return TimeSeriesSlice<Q>{first, times().subspan(first, last - first),
+                                values().subspan(first, last - first)};
+    }
+
+    // Value at time, interpolated linearly between the samples around it, and held at the first
+    // or last value outside the series. Throws std::out_of_range if the series is empty.
+    Q interpolate(Time time) const {
+      const double query = time.getValue();
+      rep result;
+      interpolate(QuantitySpan<const Time>(&query, 1), QuantitySpan<Q>(&result, 1));
+      return Q(result);
+    }
+
+    // out[i] = interpolate(queries[i]). Queries may come in any order; blocks of increasing
+    // queries are found by galloping from the previous one, so a sorted batch costs O(n + m)
+    // rather than O(m log n). Throws std::invalid_argument if the sizes differ and
+    // std::out_of_range if the series is empty.
+    void interpolate(QuantitySpan<const Time> queries, QuantitySpan<Q> out) const {
+      const std::size_t m = queries.size();
+      if (out.size() != m) {
+        throw std::invalid_argument("uniTypes: interpolation output size differs");
+      }
+      if (empty()) {
+        throw std::out_of_range("uniTypes: cannot interpolate an empty time series");
+      }
+      const std::size_t n = size();
+      const double* t = times_.data();
+      const double* q = queries.data();
+      if (n == 1) {
+        std::fill(out.data(), out.data() + m, values_.data()[0]);
+        return;
+      }
+
+      std::size_t segments[kInterpolateBlock];
+      // Upper bound of the previous query, where the search for a later one can start.
+      std::size_t hint = 0;
+      double previous = q[0];
+      for (std::size_t begin = 0; begin < m; begin += kInterpolateBlock) {
+        const std::size_t count = std::min(kInterpolateBlock, m - begin);
+        // Galloping only pays off for increasing queries; unordered blocks search the whole
+        // series, whose first few probes the queries share and so find in cache. Written with >=
+        // rather than std::is_sorted so that a NaN query makes the block unordered.
+        bool increasing = q[begin] >= previous;
+        for (std::size_t i = 1; i < count; ++i) {
+          increasing &= q[begin + i] >= q[begin + i - 1];
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+          const double query = q[begin + i];
+          hint = increasing ? detail::gallopUpperBound(t, n, hint, query)
+                            : static_cast<std::size_t>(std::upper_bound(t, t + n, query) - t);
+          // The segment [k, k + 1] around query, clamped to the ends of the series.
+          segments[i] = std::min(hint == 0 ? 0 : hint - 1, n - 2);
+        }
+        previous = q[begin + count - 1];
+        detail::interpolateSegments(t, values_.data(), q + begin, segments, count,
+                                    out.data() + begin);
+      }
+    }
+
+    // Combines the samples of every interval [origin + k * interval, origin + (k + 1) *
+    // interval) into one sample stamped with the start of the interval. Intervals without
+    // samples are left out, and means of integer quantities are truncated to the rep. Throws
+    // std::invalid_argument unless interval is positive and finite and origin is finite, or if
+    // a sample is more than 2^53 intervals from origin, where intervals cannot be told apart.
+    TimeSeries resample(Time interval, Aggregation aggregation, Time origin = Time()) const {
+      const double width = interval.getValue();
+      if (!(width > 0.0) || !std::isfinite(width)) {
+        throw std::invalid_argument("uniTypes: resampling interval must be positive and finite");
+      }
+      if (!std::isfinite(origin.getValue())) {
+        throw std::invalid_argument("uniTypes: resampling origin must be finite");
+      }
+      const std::size_t n = size();
+      const double* t = times_.data();
+      const rep* v = values_.data();
+      TimeSeries result;
+      std::size_t begin = 0;
+      while (begin < n) {
+        double key = std::floor((t[begin] - origin.getValue()) / width);
+        if (!(std::fabs(key) < kMaxIntervalIndex)) {
+          throw std::invalid_argument("uniTypes: sample is too many intervals from the origin");
+        }
+        double end_time = origin.getValue() + (key + 1.0) * width;
+        // Rounding can put a sample on the wrong side of a boundary, by at most one interval.
+        if (!(t[begin] < end_time)) {
+          key += 1.0;
+          end_time = origin.getValue() + (key + 1.0) * width;
+          if (!(t[begin] < end_time)) {
+            throw std::invalid_argument("uniTypes: resampling interval is too fine for the times");
+          }
+        }
+        const std::size_t end = static_cast<std::size_t>(
+          std::lower_bound(t + begin, t + n, end_time) - t);
+        result.times_.push_back(Time(origin.getValue() + key * width));
+        if (aggregation == Aggregation::Last) {
+          result.values_.push_back(Q(v[end - 1]));
+        } else {
+          detail::sum_partial_t<rep> sum;
+          for (std::size_t i = begin; i < end; ++i) {
+            sum.add(v[i]);
+          }
+          result.values_.push_back(Q(static_cast<rep>(
+            aggregation == Aggregation::Sum
+              ? sum.result()
+              : static_cast<double>(sum.result()) / static_cast<double>(end - begin))));
+        }
+        begin = end;
+      }
+      return result;
+    }
+
+  private:
+    // Interval indices up to 2^53 are exact doubles, so consecutive intervals stay distinct.
+    static constexpr double kMaxIntervalIndex = 9007199254740992.0;
+
+    QuantityVector<Time> times_;
+    QuantityVector<Q> values_;
+  };
+
+  // Aggregates of the samples of a TimeSeries in the trailing window (latest - width, latest],
+  // where latest is the time of the newest sample.
+  //
+  // update() only visits the samples appended since the previous call and those that left the
+  // window, so following a growing series costs O(1) amortized per sample however wide the
+  // window is. Min and max are kept with monotonic queues of sample indices. The series must
+  // outlive the window and may only be appended to.
+  template<typename Q>
+  class TimeWindow {
+  public:
+    using quantity_type = Q;
+    using rep = typename Q::rep;
+
+    TimeWindow(const TimeSeries<Q>& series, Time width) : series_(&series), width_(width) {
+      if (!(width.getValue() > 0.0)) {
+        throw std::invalid_argument("uniTypes: window width must be positive");
+      }
+      update();
+    }
+
+    // Takes in the samples appended to the series since the last update.
+    void update() {
+      const std::size_t n = series_->size();
+      if (n == end_) {
+        return;
+      }
+      const double* t = series_->times().data();
+      const rep* v = series_->values().data();
+      for (; end_ < n; ++end_) {
+        const rep x = v[end_];
+        sum_.add(x);
+        while (!min_queue_.empty() && !(v[min_queue_.back()] < x)) {
+          min_queue_.pop_back();
+        }
+        min_queue_.push_back(end_);
+        while (!max_queue_.empty() && !(x < v[max_queue_.back()])) {
+          max_queue_.pop_back();
+        }
+        max_queue_.push_back(end_);
+      }
+      const double start = t[n - 1] - width_.getValue();
+      for (; begin_ < end_ && !(t[begin_] > start); ++begin_) {
+        sum_.add(-v[begin_]);
+        if (min_queue_.front() == begin_) {
+          min_queue_.pop_front();
+        }
+        if (max_queue_.front() == begin_) {
+          max_queue_.pop_front();
+        }
+      }
+    }
+
+    Time width() const { return width_; }
+    std::size_t count() const { return end_ - begin_; }
+    bool empty() const { return end_ == begin_; }
+    // Index range [begin, end) of the window in the series.
+    std::size_t begin() const { return begin_; }
+    std::size_t end() const { return end_; }
+
+    // Sum of the values in the window, compensated for floating-point reps.
+    Q sum() const { return Q(static_cast<rep>(sum_.result())); }
+
+    // The remaining aggregates throw std::invalid_argument for an empty window.
+    detail::floating_quantity_t<Q> mean() const {
+      detail::checkNotEmpty(count());
+      return detail::floating_quantity_t<Q>(static_cast<double>(sum_.result()) /
+                                            static_cast<double>(count()));
+    }
+
+    Q min() const {
+      detail::checkNotEmpty(count());
+      return series_->value(min_queue_.front());
+    }
+
+    Q max() const {
+      detail::checkNotEmpty(count());
+      return series_->value(max_queue_.front());
+    }
+
+  private:
+    const TimeSeries<Q>* series_;
+    Time width_;
+    std::size_t begin_ = 0;
+    std::size_t end_ = 0;
+    detail::sum_partial_t<rep> sum_;
+    std::deque<std::size_t> min_queue_;
+    std::deque<std::size_t> max_queue_;
+  };
+}
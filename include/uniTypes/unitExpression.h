@@ -0,0 +1,378 @@
+#pragma once
+#include <uniTypes/dimension.h>
+#include <uniTypes/dynQuantity.h>
+#include <uniTypes/perfectHash.h>
+#include <uniTypes/unitParser.h>
+#include <uniTypes/unitRegistry.h>
+#include <uniTypes/unitTable.h>
+
+#include <atomic>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+// Compound unit expressions such as "kg*m/s^2", "kcal/day" or "mg/dL".
+//
+// An expression is compiled once into the value of one of its unit in SI units and its runtime
+// Dimension, held as a DynQuantity like the entries of the unit table. Grammar:
+//   expression := power (('*' | '.' | '/') power)*     left to right, so "J/kg*K" is (J/kg)*K
+//   power      := primary ['^' exponent]               "m^2", "s^-1", "m^(1/2)"
+//   primary    := unit | number | '(' expression ')'
+//   exponent   := ['+' | '-'] integer | '(' ['+' | '-'] integer ['/' integer] ')'
+// A unit is a name from the built-in unit table, optionally with an SI prefix ("mmol", "dL",
+// "mIU"), or a unit defined in sharedUnitRegistry(), followed by an optional integer power
+// suffix ("s2" for s^2). Rational exponents have to be written in parentheses, as "m^1/2"
+// would otherwise read as m/2. UnitExpressionCache memoizes compiled expressions so that
+// repeated expressions cost one hash lookup, and parseUnit<Q> checks the result against a
+// static quantity type.
+namespace uniTypes {
+  // Maximum nesting of parentheses in a unit expression.
+  constexpr int kMaxUnitExpressionDepth = 16;
+
+  namespace detail {
+    constexpr bool isDigit(char c) {
+      return c >= '0' && c <= '9';
+    }
+
+    // Length of the micro sign or Greek mu at the start of text, or 0.
+    constexpr std::size_t microSignLength(std::string_view text) {
+      return text.substr(0, 2) == "\xC2\xB5" || text.substr(0, 2) == "\xCE\xBC" ? 2 : 0;
+    }
+
+    class UnitExpressionParser {
+    public:
+      explicit UnitExpressionParser(std::string_view text) : text_(text), pos_(0) {}
+
+      DynQuantity parse() {
+        const DynQuantity unit = expression(0);
+        skipSpaces();
+        if (pos_ != text_.size()) {
+          fail("unexpected character in unit expression");
+        }
+        // As for UnitRegistry::define: "m/0" or "0*kg" would scale every quantity to inf or 0.
+        if (!(unit.getValue() > 0.0) || !std::isfinite(unit.getValue())) {
+          fail("unit expression must have a positive finite value");
+        }
+        return unit;
+      }
+
+    private:
+      DynQuantity expression(int depth) {
+        DynQuantity unit = power(depth);
+        for (;;) {
+          skipSpaces();
+          if (accept('*') || accept('.') || accept("\xC2\xB7")) {
+            unit = unit * power(depth);
+          } else if (accept('/')) {
+            unit = unit / power(depth);
+          } else {
+            return unit;
+          }
+        }
+      }
+
+      DynQuantity power(int depth) {
+        const DynQuantity base = primary(depth);
+        skipSpaces();
+        if (!accept('^')) {
+          return base;
+        }
+        skipSpaces();
+        int num = 0;
+        int den = 1;
+        if (accept('(')) {
+          num = integer(true);
+          skipSpaces();
+          if (accept('/')) {
+            den = integer(false);
+          }
+          skipSpaces();
+          expect(')');
+        } else {
+          num = integer(true);
+        }
+        return raise(base, num, den);
+      }
+
+      DynQuantity primary(int depth) {
+        skipSpaces();
+        if (pos_ == text_.size()) {
+          fail("missing unit in unit expression");
+        }
+        if (accept('(')) {
+          if (depth == kMaxUnitExpressionDepth) {
+            fail("unit expression is nested too deeply");
+          }
+          const DynQuantity unit = expression(depth + 1);
+          skipSpaces();
+          expect(')');
+          return unit;
+        }
+        if (isDigit(text_[pos_])) {
+          double number = 0.0;
+          const char* last = text_.data() + text_.size();
+          const std::from_chars_result parsed = std::from_chars(text_.data() + pos_, last, number);
+          if (parsed.ec != std::errc()) {
+            fail("invalid number in unit expression");
+          }
+          pos_ = static_cast<std::size_t>(parsed.ptr - text_.data());
+          return DynQuantity(number, Dimension());
+        }
+
+        // A name, letters with single inner hyphens as in "pound-force", then a power suffix.
+        const std::size_t start = pos_;
+        for (;;) {
+          if (const std::size_t micro = microSignLength(text_.substr(pos_))) {
+            pos_ += micro;
+          } else if (pos_ < text_.size() &&
+                     (isUnitNameChar(text_[pos_]) ||
+                      (text_[pos_] == '-' && pos_ > start && pos_ + 1 < text_.size() &&
+                       isUnitNameChar(text_[pos_ + 1])))) {
+            ++pos_;
+          } else {
+            break;
+          }
+        }
+        if (pos_ == start) {
+          fail("unexpected character in unit expression");
+        }
+        const std::size_t name_end = pos_;
+        while (pos_ < text_.size() && isDigit(text_[pos_])) {
+          ++pos_;
+        }
+        return unitNamed(text_.substr(start, pos_ - start), name_end - start);
+      }
+
+      // Resolves name, whose first name_length characters are letters and the rest a power.
+      static DynQuantity unitNamed(std::string_view name, std::size_t name_length) {
+        // Table names such as "m2" and "km3" already include their power.
+        if (const UnitEntry* entry = lookupUnit(name)) {
+          return DynQuantity(entry->factor, entry->dimension);
+        }
+        const DynQuantity base = prefixedUnit(name.substr(0, name_length));
+        if (name_length == name.size()) {
+          return base;
+        }
+        int num = 0;
+        const std::string_view digits = name.substr(name_length);
+        const std::from_chars_result parsed =
+          std::from_chars(digits.data(), digits.data() + digits.size(), num);
+        if (parsed.ec != std::errc()) {
+          throw std::invalid_argument("uniTypes: invalid power in unit " + std::string(name));
+        }
+        return raise(base, num, 1);
+      }
+
+      static DynQuantity prefixedUnit(std::string_view name) {
+        if (const UnitEntry* entry = lookupUnit(name)) {
+          return DynQuantity(entry->factor, entry->dimension);
+        }
+        double prefix_factor = 1.0;
+        if (const UnitEntry* entry = lookupPrefixedUnit(name, prefix_factor)) {
+          return DynQuantity(prefix_factor * entry->factor, entry->dimension);
+        }
+        // Units defined at runtime come last, so they cannot change what a name already meant.
+        if (const UnitEntry* entry = sharedUnitRegistry().find(name)) {
+          return DynQuantity(entry->factor, entry->dimension);
+        }
+        throw std::out_of_range("uniTypes: unknown unit " + std::string(name));
+      }
+
+      static DynQuantity raise(DynQuantity base, int num, int den) {
+        const Dimension dimension = base.getDimension().pow(num, den);
+        const double factor = den == 1 ? std::pow(base.getValue(), num)
+                                       : std::pow(base.getValue(), static_cast<double>(num) / den);
+        return DynQuantity(factor, dimension);
+      }
+
+      int integer(bool is_signed) {
+        skipSpaces();
+        bool negative = false;
+        if (is_signed) {
+          negative = accept('-');
+          if (!negative) {
+            accept('+');
+          }
+        }
+        // from_chars would take another sign, as in "m^--1" or "m^(2/-1)".
+        if (pos_ == text_.size() || !isDigit(text_[pos_])) {
+          fail("invalid exponent in unit expression");
+        }
+        int value = 0;
+        const char* last = text_.data() + text_.size();
+        const std::from_chars_result parsed = std::from_chars(text_.data() + pos_, last, value);
+        if (parsed.ec != std::errc()) {
+          fail("invalid exponent in unit expression");
+        }
+        pos_ = static_cast<std::size_t>(parsed.ptr - text_.data());
+        return negative ? -value : value;
+      }
+
+      void skipSpaces() {
+        while (pos_ < text_.size() && isSpace(text_[pos_])) {
+          ++pos_;
+        }
+      }
+
+      bool accept(char c) {
+        if (pos_ < text_.size() && text_[pos_] == c) {
+          ++pos_;
+          return true;
+        }
+        return false;
+      }
+
+      bool accept(std::string_view token) {
+        if (text_.substr(pos_, token.size()) == token) {
+          pos_ += token.size();
+          return true;
+        }
+        return false;
+      }
+
+      void expect(char c) {
+        if (!accept(c)) {
+          fail(std::string("expected '") + c + "' in unit expression");
+        }
+      }
+
+      [[noreturn]] void fail(const std::string& message) const {
+        throw std::invalid_argument("uniTypes: " + message + " at offset " +
+                                    std::to_string(pos_) + ": " + std::string(text_));
+      }
+
+      std::string_view text_;
+      std::size_t pos_;
+    };
+  }
+
+  // ------------------------------------------
+  // compileUnit
+  // ------------------------------------------
+  // Value of one of the unit expression in SI units, with its dimension, e.g.
+  // compileUnit("kcal/day") is about 0.0484 W. Throws std::out_of_range for an unknown unit name,
+  // std::invalid_argument for a malformed expression, an exponent the dimension cannot represent
+  // or a value that is not positive and finite ("m/0", "0*kg"), and std::overflow_error for an
+  // exponent out of the dimension's range.
+  inline DynQuantity compileUnit(std::string_view expression) {
+    const std::string_view trimmed = detail::trim(expression);
+    // Whole-expression lookup first, for table names with spaces such as "fl oz".
+    if (const UnitEntry* entry = lookupUnit(trimmed)) {
+      return DynQuantity(entry->factor, entry->dimension);
+    }
+    return detail::UnitExpressionParser(trimmed).parse();
+  }
+
+  // Thread-safe cache of compiled unit expressions.
+  //
+  // The same insert-only table of atomic pointers as ConversionPlanCache: readers never lock, and
+  // once the table is full further expressions are compiled on every call instead of cached, so
+  // memory stays bounded however many distinct expressions a feed sends.
+  class UnitExpressionCache {
+  public:
+    // std::size_t capacity = 1024, Maximum number of cached expressions. Rounded up to a power of
+    // two.
+    explicit UnitExpressionCache(std::size_t capacity = 1024)
+      : mask_(detail::nextPowerOfTwo(capacity < 1 ? 1 : capacity) - 1),
+        slots_(new std::atomic<const Entry*>[mask_ + 1]) {
+      for (std::size_t i = 0; i <= mask_; ++i) {
+        slots_[i].store(nullptr, std::memory_order_relaxed);
+      }
+    }
+
+    ~UnitExpressionCache() {
+      for (std::size_t i = 0; i <= mask_; ++i) {
+        delete slots_[i].load(std::memory_order_relaxed);
+      }
+    }
+
+    UnitExpressionCache(const UnitExpressionCache&) = delete;
+    UnitExpressionCache& operator=(const UnitExpressionCache&) = delete;
+
+    // Unit of expression, compiled on first use. Throws like compileUnit; failed expressions are
+    // not cached.
+    DynQuantity get(std::string_view expression) {
+      const std::size_t start = static_cast<std::size_t>(detail::hashString(expression, 0));
+      for (std::size_t probe = 0; probe <= mask_; ++probe) {
+        std::atomic<const Entry*>& slot = slots_[(start + probe) & mask_];
+        const Entry* entry = slot.load(std::memory_order_acquire);
+        if (entry == nullptr) {
+          return insert(slot, expression);
+        }
+        if (entry->expression == expression) {
+          return entry->unit;
+        }
+      }
+      return compileUnit(expression);
+    }
+
+    // Number of cached expressions.
+    std::size_t size() const {
+      std::size_t count = 0;
+      for (std::size_t i = 0; i <= mask_; ++i) {
+        count += slots_[i].load(std::memory_order_acquire) != nullptr ? 1 : 0;
+      }
+      return count;
+    }
+
+    std::size_t capacity() const { return mask_ + 1; }
+
+  private:
+    struct Entry {
+      std::string expression;
+      DynQuantity unit;
+    };
+
+    // Compiles expression and publishes it in slot, or in a later free slot if another thread
+    // fills slot first with a different expression.
+    DynQuantity insert(std::atomic<const Entry*>& slot, std::string_view expression) {
+      std::unique_ptr<Entry> entry(new Entry{std::string(expression), compileUnit(expression)});
+      const DynQuantity unit = entry->unit;
+
+      std::size_t index = static_cast<std::size_t>(&slot - slots_.get());
+      for (std::size_t probe = 0; probe <= mask_; ++probe) {
+        const Entry* expected = nullptr;
+        if (slots_[index].compare_exchange_strong(expected, entry.get(),
+                                                  std::memory_order_acq_rel,
+                                                  std::memory_order_acquire)) {
+          entry.release();
+          return unit;
+        }
+        if (expected->expression == expression) {
+          return expected->unit;
+        }
+        index = (index + 1) & mask_;
+      }
+      return unit;
+    }
+
+    const std::size_t mask_;
+    std::unique_ptr<std::atomic<const Entry*>[]> slots_;
+  };
+
+  // ------------------------------------------
+  // sharedUnitCache
+  // ------------------------------------------
+  // Process-wide unit expression cache, for callers that do not need their own.
+  inline UnitExpressionCache& sharedUnitCache() {
+    static UnitExpressionCache cache;
+    return cache;
+  }
+
+  // ------------------------------------------
+  // parseUnit
+  // ------------------------------------------
+  // Unit expression as the static quantity type Q, e.g. 2.0 * parseUnit<Force>("kg*m/s^2"),
+  // compiled through sharedUnitCache(). Throws DimensionMismatch if the expression does not have
+  // the dimension of Q, and otherwise like compileUnit.
+  template<typename Q>
+  Q parseUnit(std::string_view expression) {
+    return sharedUnitCache().get(expression).template as<Q>();
+  }
+}
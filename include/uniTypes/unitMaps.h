@@ -0,0 +1,108 @@
+#pragma once
+#include <uniTypes/units.h>
+
+#include <cstddef>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+// Name-to-unit tables for mass, volume and length units.
+//
+// The tables are constexpr static data rather than std::maps, so including this header costs no
+// dynamic initialization or heap allocation at startup, and every translation unit shares one
+// copy. They keep the read-only part of the std::map interface (at, find, count, iteration);
+// entries are iterated in the order listed below.
+namespace uniTypes {
+  template<typename Q>
+  struct UnitMapEntry {
+    std::string_view first;
+    Q second;
+  };
+
+  // Fixed table of N unit names. Lookups compare against each name in turn, which for tables of
+  // this size is cheaper than hashing.
+  template<typename Q, std::size_t N>
+  class UnitMap {
+  public:
+    using key_type = std::string_view;
+    using mapped_type = Q;
+    using value_type = UnitMapEntry<Q>;
+    using const_iterator = const value_type*;
+    using iterator = const_iterator;
+
+    constexpr explicit UnitMap(const value_type (&entries)[N]) : entries_() {
+      for (std::size_t i = 0; i < N; ++i) {
+        entries_[i] = entries[i];
+      }
+    }
+
+    constexpr const_iterator begin() const { return entries_; }
+    constexpr const_iterator end() const { return entries_ + N; }
+    constexpr std::size_t size() const { return N; }
+
+    constexpr const_iterator find(std::string_view name) const {
+      for (std::size_t i = 0; i < N; ++i) {
+        if (entries_[i].first == name) {
+          return entries_ + i;
+        }
+      }
+      return end();
+    }
+
+    constexpr std::size_t count(std::string_view name) const {
+      return find(name) == end() ? 0 : 1;
+    }
+
+    // Throws std::out_of_range if there is no unit called name.
+    constexpr const Q& at(std::string_view name) const {
+      const const_iterator entry = find(name);
+      if (entry == end()) {
+        throw std::out_of_range("uniTypes: unknown unit name");
+      }
+      return entry->second;
+    }
+
+  private:
+    value_type entries_[N];
+  };
+
+  template<typename Q, std::size_t N>
+  constexpr UnitMap<Q, N> makeUnitMap(const UnitMapEntry<Q> (&entries)[N]) {
+    return UnitMap<Q, N>(entries);
+  }
+
+  inline constexpr auto string_to_mass_unit = makeUnitMap<Mass>({
+    {"kilogram", kilogram}, {"kg", kilogram},
+    {"gram", gram}, {"g", gram},
+    {"milligram", milligram}, {"mg", milligram},
+    {"ton", ton}, {"tn", ton},
+    {"ounce", ounce}, {"oz", ounce},
+    {"pound", pound}, {"lb", pound},
+  });
+  using mass_map_t = std::remove_const_t<decltype(string_to_mass_unit)>;
+
+  inline constexpr auto string_to_volume_unit = makeUnitMap<Volume>({
+    {"milliliter", milliliter}, {"ml", milliliter},
+    {"liter", liter}, {"l", liter},
+    {"gallon", gallon}, {"gal", gallon},
+    {"quart", quart}, {"qt", quart},
+    {"cup", cup}, {"c", cup},
+    {"fluid ounce", floz}, {"floz", floz}, {"fl", floz},
+    {"tablespoon", tablespoon}, {"tbsp", tablespoon},
+    {"teaspoon", teaspoon}, {"tsp", teaspoon}
+  });
+  using volume_map_t = std::remove_const_t<decltype(string_to_volume_unit)>;
+
+  inline constexpr auto string_to_length_unit = makeUnitMap<Length>({
+    {"meter", meter}, {"m", meter},
+    {"decimeter", decimeter}, {"dm", decimeter},
+    {"centimeter", centimeter}, {"cm", centimeter},
+    {"millimeter", millimeter}, {"mm", millimeter},
+    {"kilometer", kilometer}, {"km", kilometer},
+    {"inch", inch}, {"in", inch},
+    {"foot", foot}, {"ft", foot},
+    {"yard", yard}, {"yd", yard},
+    {"mile", mile}, {"mi", mile}
+  });
+  using length_map_t = std::remove_const_t<decltype(string_to_length_unit)>;
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <uniTypes/dimension.h>
+#include <uniTypes/dynQuantity.h>
+#include <uniTypes/unitRegistry.h>
+#include <uniTypes/unitTable.h>
+
+#include <charconv>
+#include <string_view>
+#include <system_error>
+
+// Parsing of quantity strings such as "12.5 lb" or "3 tbsp".
+//
+// Parsing never allocates and never throws: the number is read with std::from_chars and the unit
+// is resolved through the compile-time perfect hash of the built-in unit registry, then through
+// the units defined in sharedUnitRegistry(). Failures are reported through ParseResult::error.
+namespace uniTypes {
+  enum class ParseError {
+    None = 0,
+    EmptyInput,
+    InvalidNumber,
+    MissingUnit,
+    UnknownUnit,
+    WrongDimension
+  };
+
+  struct ParseResult {
+    DynQuantity quantity;
+    ParseError error;
+
+    constexpr explicit operator bool() const {
+      return error == ParseError::None;
+    }
+  };
+
+  namespace detail {
+    constexpr bool isSpace(char c) {
+      return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    constexpr std::string_view trim(std::string_view text) {
+      while (!text.empty() && isSpace(text.front())) {
+        text.remove_prefix(1);
+      }
+      while (!text.empty() && isSpace(text.back())) {
+        text.remove_suffix(1);
+      }
+      return text;
+    }
+  }
+
+  // ------------------------------------------
+  // parseQuantity
+  // ------------------------------------------
+  // Parses "<number> <unit>" (the whitespace between the two is optional) into a DynQuantity
+  // holding the value in SI units.
+  inline ParseResult parseQuantity(std::string_view text) {
+    text = detail::trim(text);
+    if (text.empty()) {
+      return {DynQuantity(), ParseError::EmptyInput};
+    }
+
+    double number = 0.0;
+    const char* first = text.data();
+    const char* last = text.data() + text.size();
+    const std::from_chars_result parsed = std::from_chars(first, last, number);
+    if (parsed.ec != std::errc()) {
+      return {DynQuantity(), ParseError::InvalidNumber};
+    }
+
+    const std::string_view unit_name = detail::trim(
+      std::string_view(parsed.ptr, static_cast<std::size_t>(last - parsed.ptr)));
+    if (unit_name.empty()) {
+      return {DynQuantity(), ParseError::MissingUnit};
+    }
+
+    const UnitEntry* unit = findUnit(unit_name);
+    if (unit == nullptr) {
+      return {DynQuantity(), ParseError::UnknownUnit};
+    }
+    return {DynQuantity(number * unit->factor, unit->dimension), ParseError::None};
+  }
+
+  // Same as parseQuantity(text), but also reports WrongDimension unless the parsed quantity has
+  // the expected dimension.
+  inline ParseResult parseQuantity(std::string_view text, Dimension expected) {
+    ParseResult result = parseQuantity(text);
+    if (result && result.quantity.getDimension() != expected) {
+      result.error = ParseError::WrongDimension;
+    }
+    return result;
+  }
+}
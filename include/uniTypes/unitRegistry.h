@@ -0,0 +1,216 @@
+#pragma once
+#include <uniTypes/dimension.h>
+#include <uniTypes/dynQuantity.h>
+#include <uniTypes/perfectHash.h>
+#include <uniTypes/unitTable.h>
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Units defined at runtime, such as "scoop", "serving" or a vendor's "pack".
+//
+// A UnitRegistry answers for the built-in units from the static unitTable.h data, and for the
+// units an application defines through define(). Defined units live in an open-addressing
+// table of atomic pointers that readers probe without locking, so find() is wait-free. Writers
+// take a mutex and publish each new entry with a release store; when the table fills up they
+// build a larger copy and swap it in, read-copy-update style. Replaced tables stay allocated
+// until the registry is destroyed, as readers may still be probing them, and since tables
+// double that costs less than the current table. Units can only be added, never changed or
+// removed, so a name that resolved once keeps its meaning and results cached from it (in
+// ConversionPlanCache or UnitExpressionCache) never go stale.
+namespace uniTypes {
+  namespace detail {
+    constexpr bool isUnitNameChar(char c) {
+      return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+    }
+
+    // Whether name is letters and underscores, with single hyphens between them as in
+    // "pound-force", i.e. a name that unit expressions read as a single unit.
+    constexpr bool isUnitName(std::string_view name) {
+      if (name.empty()) {
+        return false;
+      }
+      for (std::size_t i = 0; i < name.size(); ++i) {
+        const bool inner_hyphen = name[i] == '-' && i > 0 && i + 1 < name.size() &&
+                                  isUnitNameChar(name[i - 1]) && isUnitNameChar(name[i + 1]);
+        if (!isUnitNameChar(name[i]) && !inner_hyphen) {
+          return false;
+        }
+      }
+      return true;
+    }
+  }
+
+  // Slots of the first table of defined units. Tables double when more than half full.
+  constexpr std::size_t kUnitRegistryInitialSlots = 16;
+
+  class UnitRegistry {
+  public:
+    UnitRegistry() : table_(nullptr), size_(0) {}
+
+    ~UnitRegistry() {
+      delete table_.load(std::memory_order_relaxed);
+    }
+
+    UnitRegistry(const UnitRegistry&) = delete;
+    UnitRegistry& operator=(const UnitRegistry&) = delete;
+
+    // Defines name as a unit worth unit, e.g. define("scoop", 30 * gram). Defining a name again
+    // with the same value and dimension returns the existing entry. Throws
+    // std::invalid_argument if name is not letters and underscores (with inner hyphens), is a
+    // built-in unit with or without an SI prefix ("dN", "mmol") or is already defined
+    // differently, or if the value is not positive and finite. The returned entry stays valid as
+    // long as the registry.
+    const UnitEntry& define(std::string_view name, DynQuantity unit) {
+      if (!detail::isUnitName(name)) {
+        throw std::invalid_argument("uniTypes: invalid unit name \"" + std::string(name) + "\"");
+      }
+      if (!(unit.getValue() > 0.0) || !std::isfinite(unit.getValue())) {
+        throw std::invalid_argument("uniTypes: unit " + std::string(name) +
+                                    " must have a positive finite value");
+      }
+      double prefix_factor = 1.0;
+      if (lookupUnit(name) != nullptr || lookupPrefixedUnit(name, prefix_factor) != nullptr) {
+        throw std::invalid_argument("uniTypes: " + std::string(name) + " is a built-in unit");
+      }
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (const UnitEntry* existing = findDefined(name)) {
+        if (existing->factor != unit.getValue() || existing->dimension != unit.getDimension()) {
+          throw std::invalid_argument("uniTypes: unit " + std::string(name) +
+                                      " is already defined differently");
+        }
+        return *existing;
+      }
+
+      std::unique_ptr<Node> node(new Node);
+      node->name = std::string(name);
+      node->entry = UnitEntry{node->name, unit.getValue(), unit.getDimension()};
+      const std::size_t count = size_.load(std::memory_order_relaxed) + 1;
+      const Table* table = table_.load(std::memory_order_relaxed);
+      if (table == nullptr || 2 * count > table->mask + 1) {
+        table = grow(table);
+      }
+      place(*table, node.get());
+      nodes_.push_back(std::move(node));
+      size_.store(count, std::memory_order_release);
+      return nodes_.back()->entry;
+    }
+
+    // Defines name as a unit worth unit, a quantity of any static type.
+    template<typename D, typename Rep>
+    const UnitEntry& define(std::string_view name, RatioQuantity<D, Rep> unit) {
+      return define(name, DynQuantity(unit));
+    }
+
+    // Built-in unit called name, or else the unit defined under that name, or nullptr. Never
+    // blocks and never allocates.
+    const UnitEntry* find(std::string_view name) const {
+      if (const UnitEntry* builtin = lookupUnit(name)) {
+        return builtin;
+      }
+      return findDefined(name);
+    }
+
+    // Number of units defined at runtime, not counting the built-in ones.
+    std::size_t size() const { return size_.load(std::memory_order_acquire); }
+
+  private:
+    struct Node {
+      std::string name;
+      UnitEntry entry;
+    };
+
+    struct Table {
+      explicit Table(std::size_t slots)
+        : mask(slots - 1), slots(new std::atomic<const Node*>[slots]) {
+        for (std::size_t i = 0; i < slots; ++i) {
+          this->slots[i].store(nullptr, std::memory_order_relaxed);
+        }
+      }
+
+      const std::size_t mask;
+      std::unique_ptr<std::atomic<const Node*>[]> slots;
+    };
+
+    const UnitEntry* findDefined(std::string_view name) const {
+      const Table* table = table_.load(std::memory_order_acquire);
+      if (table == nullptr) {
+        return nullptr;
+      }
+      const std::size_t start = static_cast<std::size_t>(detail::hashString(name, 0));
+      // Tables are never more than half full, so the probe ends at an empty slot.
+      for (std::size_t probe = 0; probe <= table->mask; ++probe) {
+        const Node* node = table->slots[(start + probe) & table->mask].load(
+          std::memory_order_acquire);
+        if (node == nullptr) {
+          return nullptr;
+        }
+        if (node->name == name) {
+          return &node->entry;
+        }
+      }
+      return nullptr;
+    }
+
+    // Stores node in the first free slot of its probe sequence. Called with the mutex held.
+    static void place(const Table& table, const Node* node) {
+      std::size_t index = static_cast<std::size_t>(detail::hashString(node->name, 0));
+      for (;; ++index) {
+        std::atomic<const Node*>& slot = table.slots[index & table.mask];
+        if (slot.load(std::memory_order_relaxed) == nullptr) {
+          slot.store(node, std::memory_order_release);
+          return;
+        }
+      }
+    }
+
+    // Publishes a table twice the size of current with all the defined units, and retires
+    // current. Called with the mutex held.
+    const Table* grow(const Table* current) {
+      std::unique_ptr<Table> table(
+        new Table(current == nullptr ? kUnitRegistryInitialSlots : 2 * (current->mask + 1)));
+      for (const std::unique_ptr<Node>& node : nodes_) {
+        place(*table, node.get());
+      }
+      const Table* published = table.release();
+      table_.store(published, std::memory_order_release);
+      if (current != nullptr) {
+        retired_.emplace_back(current);
+      }
+      return published;
+    }
+
+    std::atomic<const Table*> table_;
+    std::atomic<std::size_t> size_;
+    // Everything below is only touched by writers, with mutex_ held.
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<Node>> nodes_;
+    std::vector<std::unique_ptr<const Table>> retired_;
+  };
+
+  // ------------------------------------------
+  // sharedUnitRegistry
+  // ------------------------------------------
+  // Process-wide registry, which parseQuantity, compileUnit, ConversionPlan and the ingest
+  // readers resolve unit names through.
+  inline UnitRegistry& sharedUnitRegistry() {
+    static UnitRegistry registry;
+    return registry;
+  }
+
+  // ------------------------------------------
+  // findUnit
+  // ------------------------------------------
+  // Built-in unit or unit defined in the shared registry called name, or nullptr. Wait-free.
+  inline const UnitEntry* findUnit(std::string_view name) {
+    return sharedUnitRegistry().find(name);
+  }
+}
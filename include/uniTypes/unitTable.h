@@ -0,0 +1,223 @@
+#pragma once
+#include <uniTypes.h>
+#include <uniTypes/dimension.h>
+#include <uniTypes/perfectHash.h>
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+// Registry of every built-in unit name and abbreviation, across all dimensions.
+//
+// The registry is constexpr static data: the entries reference the predefined unit constants, and
+// name lookups go through a PerfectHash that is built at compile time. lookupPrefixedUnit also
+// reads SI prefixes on the units that take them, as unit expressions do.
+namespace uniTypes {
+  struct UnitEntry {
+    std::string_view name;
+    // Value of one of this unit in SI units.
+    double factor;
+    Dimension dimension;
+  };
+
+  namespace detail {
+    template<typename Q>
+    constexpr UnitEntry unitEntry(std::string_view name, Q unit) {
+      return UnitEntry{name, unit.getValue(), dimensionOf<Q>()};
+    }
+  }
+
+  inline constexpr UnitEntry builtin_units[] = {
+    // International Units.
+    detail::unitEntry("IU", IU),
+
+    // Mass.
+    detail::unitEntry("kilogram", kilogram), detail::unitEntry("kilograms", kilogram),
+    detail::unitEntry("kg", kilogram),
+    detail::unitEntry("gram", gram), detail::unitEntry("grams", gram), detail::unitEntry("g", gram),
+    detail::unitEntry("milligram", milligram), detail::unitEntry("milligrams", milligram),
+    detail::unitEntry("mg", milligram),
+    detail::unitEntry("ton", ton), detail::unitEntry("tons", ton), detail::unitEntry("tn", ton),
+    detail::unitEntry("ounce", ounce), detail::unitEntry("ounces", ounce),
+    detail::unitEntry("oz", ounce),
+    detail::unitEntry("pound", pound), detail::unitEntry("pounds", pound),
+    detail::unitEntry("lb", pound), detail::unitEntry("lbs", pound),
+    detail::unitEntry("stone", stone), detail::unitEntry("st", stone),
+
+    // Length.
+    detail::unitEntry("meter", meter), detail::unitEntry("meters", meter),
+    detail::unitEntry("m", meter),
+    detail::unitEntry("decimeter", decimeter), detail::unitEntry("decimeters", decimeter),
+    detail::unitEntry("dm", decimeter),
+    detail::unitEntry("centimeter", centimeter), detail::unitEntry("centimeters", centimeter),
+    detail::unitEntry("cm", centimeter),
+    detail::unitEntry("millimeter", millimeter), detail::unitEntry("millimeters", millimeter),
+    detail::unitEntry("mm", millimeter),
+    detail::unitEntry("kilometer", kilometer), detail::unitEntry("kilometers", kilometer),
+    detail::unitEntry("km", kilometer),
+    detail::unitEntry("inch", inch), detail::unitEntry("inches", inch),
+    detail::unitEntry("in", inch),
+    detail::unitEntry("foot", foot), detail::unitEntry("feet", foot), detail::unitEntry("ft", foot),
+    detail::unitEntry("yard", yard), detail::unitEntry("yards", yard),
+    detail::unitEntry("yd", yard),
+    detail::unitEntry("mile", mile), detail::unitEntry("miles", mile),
+    detail::unitEntry("mi", mile),
+
+    // Area.
+    detail::unitEntry("km2", kilometer2),
+    detail::unitEntry("m2", meter2),
+    detail::unitEntry("dm2", decimeter2),
+    detail::unitEntry("cm2", centimeter2),
+    detail::unitEntry("mm2", millimeter2),
+    detail::unitEntry("in2", inch2),
+    detail::unitEntry("ft2", foot2),
+    detail::unitEntry("yd2", yard2),
+    detail::unitEntry("mi2", mile2),
+
+    // Volume.
+    detail::unitEntry("km3", kilometer3),
+    detail::unitEntry("m3", meter3),
+    detail::unitEntry("dm3", decimeter3),
+    detail::unitEntry("cm3", centimeter3), detail::unitEntry("cc", centimeter3),
+    detail::unitEntry("mm3", millimeter3),
+    detail::unitEntry("in3", inch3),
+    detail::unitEntry("ft3", foot3),
+    detail::unitEntry("yd3", yard3),
+    detail::unitEntry("mi3", mile3),
+    detail::unitEntry("milliliter", milliliter), detail::unitEntry("milliliters", milliliter),
+    detail::unitEntry("ml", milliliter), detail::unitEntry("mL", milliliter),
+    detail::unitEntry("liter", liter), detail::unitEntry("liters", liter),
+    detail::unitEntry("l", liter), detail::unitEntry("L", liter),
+    detail::unitEntry("gallon", gallon), detail::unitEntry("gallons", gallon),
+    detail::unitEntry("gal", gallon),
+    detail::unitEntry("quart", quart), detail::unitEntry("quarts", quart),
+    detail::unitEntry("qt", quart),
+    detail::unitEntry("cup", cup), detail::unitEntry("cups", cup), detail::unitEntry("c", cup),
+    detail::unitEntry("fluid ounce", floz), detail::unitEntry("fluid ounces", floz),
+    detail::unitEntry("floz", floz), detail::unitEntry("fl oz", floz),
+    detail::unitEntry("fl", floz),
+    detail::unitEntry("tablespoon", tablespoon), detail::unitEntry("tablespoons", tablespoon),
+    detail::unitEntry("tbsp", tablespoon),
+    detail::unitEntry("teaspoon", teaspoon), detail::unitEntry("teaspoons", teaspoon),
+    detail::unitEntry("tsp", teaspoon),
+
+    // Time.
+    detail::unitEntry("second", second), detail::unitEntry("seconds", second),
+    detail::unitEntry("sec", second), detail::unitEntry("s", second),
+    detail::unitEntry("minute", minute), detail::unitEntry("minutes", minute),
+    detail::unitEntry("min", minute),
+    detail::unitEntry("hour", hour), detail::unitEntry("hours", hour),
+    detail::unitEntry("hr", hour), detail::unitEntry("h", hour),
+    detail::unitEntry("day", day), detail::unitEntry("days", day),
+    detail::unitEntry("week", week), detail::unitEntry("weeks", week),
+    detail::unitEntry("year", year), detail::unitEntry("years", year),
+    detail::unitEntry("yr", year),
+    detail::unitEntry("millisecond", millisecond), detail::unitEntry("milliseconds", millisecond),
+    detail::unitEntry("ms", millisecond),
+    detail::unitEntry("microsecond", microsecond), detail::unitEntry("microseconds", microsecond),
+    detail::unitEntry("us", microsecond),
+    detail::unitEntry("nanosecond", nanosecond), detail::unitEntry("nanoseconds", nanosecond),
+    detail::unitEntry("ns", nanosecond),
+
+    // Force.
+    detail::unitEntry("newton", newton), detail::unitEntry("newtons", newton),
+    detail::unitEntry("N", newton),
+    detail::unitEntry("kilonewton", kilonewton), detail::unitEntry("kilonewtons", kilonewton),
+    detail::unitEntry("kN", kilonewton),
+    detail::unitEntry("meganewton", meganewton), detail::unitEntry("meganewtons", meganewton),
+    detail::unitEntry("MN", meganewton),
+    detail::unitEntry("millinewton", millinewton), detail::unitEntry("millinewtons", millinewton),
+    detail::unitEntry("mN", millinewton),
+    detail::unitEntry("pound-force", poundforce), detail::unitEntry("lbf", poundforce),
+
+    // Energy.
+    detail::unitEntry("joule", joule), detail::unitEntry("joules", joule),
+    detail::unitEntry("J", joule),
+    detail::unitEntry("kilojoule", kilojoule), detail::unitEntry("kilojoules", kilojoule),
+    detail::unitEntry("kJ", kilojoule),
+    detail::unitEntry("megajoule", megajoule), detail::unitEntry("megajoules", megajoule),
+    detail::unitEntry("MJ", megajoule),
+    detail::unitEntry("kilocalorie", kilocalorie), detail::unitEntry("kilocalories", kilocalorie),
+    detail::unitEntry("kcal", kilocalorie), detail::unitEntry("Cal", kilocalorie),
+    detail::unitEntry("btu", btu), detail::unitEntry("BTU", btu),
+
+    // Remaining SI base units.
+    detail::unitEntry("kelvin", kelvin), detail::unitEntry("K", kelvin),
+    detail::unitEntry("mole", mole), detail::unitEntry("moles", mole),
+    detail::unitEntry("mol", mole),
+    detail::unitEntry("ampere", ampere), detail::unitEntry("amperes", ampere),
+    detail::unitEntry("A", ampere),
+    detail::unitEntry("candela", candela), detail::unitEntry("candelas", candela),
+    detail::unitEntry("cd", candela),
+  };
+
+  constexpr std::size_t kNumBuiltinUnits = sizeof(builtin_units) / sizeof(builtin_units[0]);
+
+  namespace detail {
+    constexpr std::array<std::string_view, kNumBuiltinUnits> builtinUnitNames() {
+      std::array<std::string_view, kNumBuiltinUnits> names{};
+      for (std::size_t i = 0; i < kNumBuiltinUnits; ++i) {
+        names[i] = builtin_units[i].name;
+      }
+      return names;
+    }
+
+    inline constexpr std::array<std::string_view, kNumBuiltinUnits> builtin_unit_names =
+      builtinUnitNames();
+
+    inline constexpr PerfectHash<kNumBuiltinUnits> builtin_unit_hash(builtin_unit_names);
+  }
+
+  // ------------------------------------------
+  // lookupUnit
+  // ------------------------------------------
+  // Finds a built-in unit by its exact (case-sensitive) name or abbreviation. Returns nullptr if
+  // there is no such unit. Never allocates.
+  constexpr const UnitEntry* lookupUnit(std::string_view name) {
+    const std::size_t index = detail::builtin_unit_hash.find(name, detail::builtin_unit_names);
+    return index == kNumBuiltinUnits ? nullptr : &builtin_units[index];
+  }
+
+  namespace detail {
+    struct UnitPrefix {
+      std::string_view symbol;
+      double factor;
+    };
+
+    // "da" before "d", so that the longest prefix wins. "u", "µ" (micro sign or Greek mu) and "mc"
+    // (as in "mcg") all mean micro.
+    inline constexpr UnitPrefix unit_prefixes[] = {
+      {"da", 1e1}, {"Y", 1e24}, {"Z", 1e21}, {"E", 1e18}, {"P", 1e15}, {"T", 1e12}, {"G", 1e9},
+      {"M", 1e6}, {"k", 1e3}, {"h", 1e2}, {"d", 1e-1}, {"c", 1e-2}, {"mc", 1e-6}, {"m", 1e-3},
+      {"u", 1e-6}, {"\xC2\xB5", 1e-6}, {"\xCE\xBC", 1e-6}, {"n", 1e-9}, {"p", 1e-12},
+      {"f", 1e-15}, {"a", 1e-18}};
+
+    // Unit symbols that accept a prefix. Prefixes are not applied to other names, so that e.g.
+    // "mi" stays a mile and never becomes a milli-inch.
+    inline constexpr std::string_view prefixable_units[] = {
+      "g", "m", "s", "l", "L", "N", "J", "K", "mol", "A", "cd", "IU"};
+  }
+
+  // ------------------------------------------
+  // lookupPrefixedUnit
+  // ------------------------------------------
+  // Finds a built-in unit written with an SI prefix, such as "dN" or "mmol", and sets
+  // prefix_factor to the factor of the prefix. Returns nullptr if name is not a prefixed
+  // built-in unit. Never allocates.
+  constexpr const UnitEntry* lookupPrefixedUnit(std::string_view name, double& prefix_factor) {
+    for (const detail::UnitPrefix& prefix : detail::unit_prefixes) {
+      if (name.size() <= prefix.symbol.size() ||
+          name.substr(0, prefix.symbol.size()) != prefix.symbol) {
+        continue;
+      }
+      const std::string_view rest = name.substr(prefix.symbol.size());
+      for (std::string_view prefixable : detail::prefixable_units) {
+        if (rest == prefixable) {
+          prefix_factor = prefix.factor;
+          return lookupUnit(rest);
+        }
+      }
+    }
+    return nullptr;
+  }
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include <uniTypes/quantity.h>
+
+// Predefined unit constants, each holding its value in SI units.
+namespace uniTypes {
+  // International Units.
+  inline constexpr UOBA IU(1.0);
+
+  // Our predefined mass units.
+  inline constexpr Mass kilogram(1.0);
+  inline constexpr Mass gram = 0.001 * kilogram;
+  inline constexpr Mass milligram = 0.001 * gram;
+  inline constexpr Mass ton = 1000.0 * kilogram;
+  inline constexpr Mass ounce = 0.028349523125 * kilogram;
+  inline constexpr Mass pound = 16 * ounce;
+  inline constexpr Mass stone = 14 * pound;
+
+  // Our predefined length units.
+  inline constexpr Length meter(1.0);
+  inline constexpr Length decimeter = meter / 10.0;
+  inline constexpr Length centimeter = meter / 100.0;
+  inline constexpr Length millimeter = meter / 1000.0;
+  inline constexpr Length kilometer = meter * 1000.0;
+  inline constexpr Length inch = 2.54 * centimeter;
+  inline constexpr Length foot = 12.0 * inch;
+  inline constexpr Length yard = 3.0 * foot;
+  inline constexpr Length mile = 5280.0 * foot;
+
+  // Our predefined area units.
+  inline constexpr Area kilometer2 = kilometer * kilometer;
+  inline constexpr Area meter2 = meter * meter;
+  inline constexpr Area decimeter2 = decimeter * decimeter;
+  inline constexpr Area centimeter2 = centimeter * centimeter;
+  inline constexpr Area millimeter2 = millimeter * millimeter;
+  inline constexpr Area inch2 = inch * inch;
+  inline constexpr Area foot2 = foot * foot;
+  inline constexpr Area yard2 = yard * yard;
+  inline constexpr Area mile2 = mile * mile;
+
+  // Our predefined volume units.
+  inline constexpr Volume kilometer3 = kilometer2 * kilometer;
+  inline constexpr Volume meter3 = meter2 * meter;
+  inline constexpr Volume decimeter3 = decimeter2 * decimeter;
+  inline constexpr Volume centimeter3 = centimeter2 * centimeter;
+  inline constexpr Volume milliliter = centimeter3;
+  inline constexpr Volume liter = 1000.0 * milliliter;
+  inline constexpr Volume millimeter3 = millimeter2 * millimeter;
+  inline constexpr Volume inch3 = inch2 * inch;
+  inline constexpr Volume foot3 = foot2 * foot;
+  inline constexpr Volume yard3 = yard2 * yard;
+  inline constexpr Volume mile3 = mile2 * mile;
+  inline constexpr Volume gallon = 3.78541 * liter;
+  inline constexpr Volume quart = gallon / 4.0;
+  inline constexpr Volume cup = quart / 2.0;
+  inline constexpr Volume floz = cup / 8.0;
+  inline constexpr Volume tablespoon = cup / 16.0;
+  inline constexpr Volume teaspoon = tablespoon / 3.0;
+
+  inline constexpr Time second(1.0);
+  inline constexpr Time minute = 60.0 * second;
+  inline constexpr Time hour = 60.0 * minute;
+  inline constexpr Time day = 24.0 * hour;
+  inline constexpr Time week = 7.0 * day;
+  inline constexpr Time year = 365.25 * day;
+  inline constexpr Time millisecond = second / 1000.0;
+  inline constexpr Time microsecond = millisecond / 1000.0;
+  inline constexpr Time nanosecond = microsecond / 1000.0;
+
+  inline constexpr Force newton(1.0);
+  inline constexpr Force kilonewton = 1000.0 * newton;
+  inline constexpr Force meganewton = 1000.0 * kilonewton;
+  inline constexpr Force millinewton = newton / 1000.0;
+  inline constexpr Force poundforce = newton * 4.44822271072093;
+
+  inline constexpr Energy joule(1.0);
+  inline constexpr Energy kilojoule = 1000.0 * joule;
+  inline constexpr Energy megajoule = 1000.0 * kilojoule;
+  inline constexpr Energy kilocalorie = 4184.0 * joule;
+  inline constexpr Energy btu = 1055.06 * joule;
+
+  // SI units of the remaining base dimensions.
+  inline constexpr Temperature kelvin(1.0);
+  inline constexpr Amount mole(1.0);
+  inline constexpr Current ampere(1.0);
+  inline constexpr LuminousIntensity candela(1.0);
+}
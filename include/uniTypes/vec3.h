@@ -0,0 +1,362 @@
+#pragma once
+#include <uniTypes.h>
+#include <uniTypes/parallel.h>
+#include <uniTypes/quantityVector.h>
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+// Three-dimensional vectors and 3x3 matrices of quantities.
+//
+// Vec3<Force> and Mat3<Q> check dimensions at compile time like the scalar quantities do: the dot
+// product of a Vec3<Force> and a Vec3<Length> is an Energy, and cross and matrix-vector products
+// have the product dimension of their operands. A Vec3 is three bare reps, so an array of them has
+// the layout of an array of raw double triples. For bulk work, Vec3Array<Q> stores the x, y and z
+// components in three aligned QuantityVectors (structure of arrays), and the kernels at the end of
+// this file run over those as plain vectorizable loops.
+namespace uniTypes {
+  template<typename Q>
+  class Vec3 {
+  public:
+    using quantity_type = Q;
+    using rep = typename Q::rep;
+
+    constexpr Vec3() : values_{} {}
+    constexpr Vec3(Q x, Q y, Q z) : values_{x.getValue(), y.getValue(), z.getValue()} {}
+
+    constexpr Q x() const { return Q(values_[0]); }
+    constexpr Q y() const { return Q(values_[1]); }
+    constexpr Q z() const { return Q(values_[2]); }
+
+    constexpr Q operator[](std::size_t i) const { return Q(values_[i]); }
+
+    // Raw components, in SI units.
+    constexpr const rep* data() const { return values_; }
+
+    constexpr Vec3& operator+=(const Vec3& rhs) {
+      for (std::size_t i = 0; i < 3; ++i) {
+        values_[i] += rhs.values_[i];
+      }
+      return *this;
+    }
+
+    constexpr Vec3& operator-=(const Vec3& rhs) {
+      for (std::size_t i = 0; i < 3; ++i) {
+        values_[i] -= rhs.values_[i];
+      }
+      return *this;
+    }
+
+  private:
+    rep values_[3];
+  };
+
+  static_assert(sizeof(Vec3<Length>) == 3 * sizeof(double),
+                "Vec3 must be laid out as three bare reps");
+
+  template<typename Q>
+  constexpr Vec3<Q> operator+(Vec3<Q> lhs, const Vec3<Q>& rhs) {
+    return lhs += rhs;
+  }
+
+  template<typename Q>
+  constexpr Vec3<Q> operator-(Vec3<Q> lhs, const Vec3<Q>& rhs) {
+    return lhs -= rhs;
+  }
+
+  template<typename Q>
+  constexpr Vec3<Q> operator-(const Vec3<Q>& v) {
+    return Vec3<Q>(-1 * v.x(), -1 * v.y(), -1 * v.z());
+  }
+
+  template<typename Q>
+  constexpr bool operator==(const Vec3<Q>& lhs, const Vec3<Q>& rhs) {
+    return lhs.x() == rhs.x() && lhs.y() == rhs.y() && lhs.z() == rhs.z();
+  }
+
+  template<typename Q>
+  constexpr bool operator!=(const Vec3<Q>& lhs, const Vec3<Q>& rhs) {
+    return !(lhs == rhs);
+  }
+
+  // Scaling by a plain number keeps the dimension; scaling by a quantity multiplies it in.
+  template<typename S, typename Q, typename = std::enable_if_t<std::is_arithmetic<S>::value>>
+  constexpr Vec3<Q> operator*(S s, const Vec3<Q>& v) {
+    return Vec3<Q>(Q(s * v.x()), Q(s * v.y()), Q(s * v.z()));
+  }
+
+  template<typename Q, typename S, typename = std::enable_if_t<std::is_arithmetic<S>::value>>
+  constexpr Vec3<Q> operator*(const Vec3<Q>& v, S s) {
+    return s * v;
+  }
+
+  template<typename Q, typename S, typename = std::enable_if_t<std::is_arithmetic<S>::value>>
+  constexpr Vec3<Q> operator/(const Vec3<Q>& v, S s) {
+    return Vec3<Q>(Q(v.x() / s), Q(v.y() / s), Q(v.z() / s));
+  }
+
+  template<typename D, typename R, typename Q>
+  constexpr Vec3<quantity_product_t<RatioQuantity<D, R>, Q>>
+    operator*(RatioQuantity<D, R> s, const Vec3<Q>& v)
+  {
+    return Vec3<quantity_product_t<RatioQuantity<D, R>, Q>>(s * v.x(), s * v.y(), s * v.z());
+  }
+
+  template<typename Q, typename D, typename R>
+  constexpr Vec3<quantity_product_t<Q, RatioQuantity<D, R>>>
+    operator*(const Vec3<Q>& v, RatioQuantity<D, R> s)
+  {
+    return Vec3<quantity_product_t<Q, RatioQuantity<D, R>>>(v.x() * s, v.y() * s, v.z() * s);
+  }
+
+  // ------------------------------------------
+  // dot
+  // ------------------------------------------
+  // Dot product, in the product dimension: dot(Vec3<Force>, Vec3<Length>) is an Energy.
+  template<typename A, typename B>
+  constexpr quantity_product_t<A, B> dot(const Vec3<A>& a, const Vec3<B>& b) {
+    return a.x() * b.x() + a.y() * b.y() + a.z() * b.z();
+  }
+
+  // ------------------------------------------
+  // cross
+  // ------------------------------------------
+  // Cross product, in the product dimension: cross(Vec3<Length>, Vec3<Force>) is a torque.
+  template<typename A, typename B>
+  constexpr Vec3<quantity_product_t<A, B>> cross(const Vec3<A>& a, const Vec3<B>& b) {
+    return Vec3<quantity_product_t<A, B>>(a.y() * b.z() - a.z() * b.y(),
+                                          a.z() * b.x() - a.x() * b.z(),
+                                          a.x() * b.y() - a.y() * b.x());
+  }
+
+  // ------------------------------------------
+  // norm
+  // ------------------------------------------
+  // Euclidean length, in the dimension of the components.
+  template<typename Q>
+  Q norm(const Vec3<Q>& v) {
+    return Q(static_cast<typename Q::rep>(std::sqrt(static_cast<double>(dot(v, v).getValue()))));
+  }
+
+  // 3x3 matrix of quantities of one type, stored row-major. Mat3<Number> (the default) holds
+  // rotations and other dimensionless transforms.
+  template<typename Q = Number>
+  class Mat3 {
+  public:
+    using quantity_type = Q;
+    using rep = typename Q::rep;
+
+    constexpr Mat3() : values_{} {}
+
+    // Matrix with rows r0, r1 and r2.
+    constexpr Mat3(const Vec3<Q>& r0, const Vec3<Q>& r1, const Vec3<Q>& r2) : values_{} {
+      const Vec3<Q>* rows[3] = {&r0, &r1, &r2};
+      for (std::size_t r = 0; r < 3; ++r) {
+        for (std::size_t c = 0; c < 3; ++c) {
+          values_[r * 3 + c] = (*rows[r])[c].getValue();
+        }
+      }
+    }
+
+    // Diagonal matrix with value on the diagonal, e.g. Mat3<>::diagonal(1.0) is the identity.
+    static constexpr Mat3 diagonal(Q value) {
+      Mat3 result;
+      for (std::size_t i = 0; i < 3; ++i) {
+        result.values_[i * 4] = value.getValue();
+      }
+      return result;
+    }
+
+    constexpr Q operator()(std::size_t row, std::size_t col) const {
+      return Q(values_[row * 3 + col]);
+    }
+
+    constexpr Vec3<Q> row(std::size_t r) const {
+      return Vec3<Q>((*this)(r, 0), (*this)(r, 1), (*this)(r, 2));
+    }
+
+    constexpr Mat3 transposed() const {
+      Mat3 result;
+      for (std::size_t r = 0; r < 3; ++r) {
+        for (std::size_t c = 0; c < 3; ++c) {
+          result.values_[c * 3 + r] = values_[r * 3 + c];
+        }
+      }
+      return result;
+    }
+
+    // Raw entries in SI units, row-major.
+    constexpr const rep* data() const { return values_; }
+
+  private:
+    rep values_[9];
+  };
+
+  // Matrix-vector product: Mat3<Number> * Vec3<Length> is a Vec3<Length>, and an inertia tensor
+  // times an angular velocity is an angular momentum.
+  template<typename M, typename Q>
+  constexpr Vec3<quantity_product_t<M, Q>> operator*(const Mat3<M>& m, const Vec3<Q>& v) {
+    return Vec3<quantity_product_t<M, Q>>(dot(m.row(0), v), dot(m.row(1), v), dot(m.row(2), v));
+  }
+
+  template<typename A, typename B>
+  constexpr Mat3<quantity_product_t<A, B>> operator*(const Mat3<A>& a, const Mat3<B>& b) {
+    const Mat3<B> bt = b.transposed();
+    return Mat3<quantity_product_t<A, B>>(a * bt.row(0), a * bt.row(1), a * bt.row(2))
+      .transposed();
+  }
+
+  // Components of many vectors, stored as three aligned columns.
+  template<typename Q>
+  class Vec3Array {
+  public:
+    using quantity_type = Q;
+    using rep = typename Q::rep;
+
+    Vec3Array() = default;
+    explicit Vec3Array(std::size_t size) : x_(size), y_(size), z_(size) {}
+
+    std::size_t size() const { return x_.size(); }
+    bool empty() const { return x_.empty(); }
+
+    void resize(std::size_t n) {
+      x_.resize(n);
+      y_.resize(n);
+      z_.resize(n);
+    }
+
+    void push_back(const Vec3<Q>& v) {
+      x_.push_back(v.x());
+      y_.push_back(v.y());
+      z_.push_back(v.z());
+    }
+
+    Vec3<Q> operator[](std::size_t i) const { return Vec3<Q>(x_[i], y_[i], z_[i]); }
+
+    void set(std::size_t i, const Vec3<Q>& v) {
+      x_[i] = v.x();
+      y_[i] = v.y();
+      z_[i] = v.z();
+    }
+
+    QuantityVector<Q>& x() { return x_; }
+    QuantityVector<Q>& y() { return y_; }
+    QuantityVector<Q>& z() { return z_; }
+    const QuantityVector<Q>& x() const { return x_; }
+    const QuantityVector<Q>& y() const { return y_; }
+    const QuantityVector<Q>& z() const { return z_; }
+
+  private:
+    QuantityVector<Q> x_;
+    QuantityVector<Q> y_;
+    QuantityVector<Q> z_;
+  };
+
+  // Elements handled per task when a Vec3Array kernel is split across threads.
+  constexpr std::size_t kVec3Grain = std::size_t(1) << 14;
+
+  namespace detail {
+    // Runs kernel(begin, end) over [0, n), split across threads for large inputs.
+    template<typename Kernel>
+    void runVec3Kernel(std::size_t n, unsigned threads, Kernel kernel) {
+      if (threads == 1 || n <= kVec3Grain) {
+        kernel(std::size_t(0), n);
+        return;
+      }
+      parallelFor(n, kVec3Grain, threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+        kernel(begin, end);
+      });
+    }
+  }
+
+  // ------------------------------------------
+  // Vec3Array kernels
+  // ------------------------------------------
+  // Each kernel writes into out, which must already have the size of the inputs. Every element
+  // only reads element i of the inputs before writing element i of out, so out may be an input.
+  // unsigned threads = 1, Number of threads to split large inputs across. 0 means all cores.
+
+  // out[i] = dot(a[i], b[i])
+  template<typename A, typename B, typename Out>
+  void dot(const Vec3Array<A>& a, const Vec3Array<B>& b, Out&& out, unsigned threads = 1) {
+    static_assert(std::is_same<quantity_product_t<A, B>, range_quantity_t<Out>>::value,
+                  "Output range must have the product dimension of the inputs");
+    detail::checkSizes(a.size(), b.size());
+    auto o = mutableSpan(out);
+    detail::checkSizes(a.size(), o.size());
+    const auto *ax = a.x().data(), *ay = a.y().data(), *az = a.z().data();
+    const auto *bx = b.x().data(), *by = b.y().data(), *bz = b.z().data();
+    auto* od = o.data();
+    detail::runVec3Kernel(o.size(), threads, [&](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i) {
+        od[i] = ax[i] * bx[i] + ay[i] * by[i] + az[i] * bz[i];
+      }
+    });
+  }
+
+  // out[i] = cross(a[i], b[i])
+  template<typename A, typename B, typename C>
+  void cross(const Vec3Array<A>& a, const Vec3Array<B>& b, Vec3Array<C>& out,
+             unsigned threads = 1)
+  {
+    static_assert(std::is_same<quantity_product_t<A, B>, C>::value,
+                  "Output array must have the product dimension of the inputs");
+    detail::checkSizes(a.size(), b.size());
+    detail::checkSizes(a.size(), out.size());
+    const auto *ax = a.x().data(), *ay = a.y().data(), *az = a.z().data();
+    const auto *bx = b.x().data(), *by = b.y().data(), *bz = b.z().data();
+    auto *ox = out.x().data(), *oy = out.y().data(), *oz = out.z().data();
+    detail::runVec3Kernel(out.size(), threads, [&](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i) {
+        const auto x = ay[i] * bz[i] - az[i] * by[i];
+        const auto y = az[i] * bx[i] - ax[i] * bz[i];
+        const auto z = ax[i] * by[i] - ay[i] * bx[i];
+        ox[i] = x;
+        oy[i] = y;
+        oz[i] = z;
+      }
+    });
+  }
+
+  // out[i] = m * in[i]
+  template<typename M, typename Q, typename P>
+  void transform(const Mat3<M>& m, const Vec3Array<Q>& in, Vec3Array<P>& out,
+                 unsigned threads = 1)
+  {
+    static_assert(std::is_same<quantity_product_t<M, Q>, P>::value,
+                  "Output array must have the product dimension of the matrix and the vectors");
+    detail::checkSizes(in.size(), out.size());
+    using Rep = typename P::rep;
+    Rep k[9];
+    for (std::size_t i = 0; i < 9; ++i) {
+      k[i] = static_cast<Rep>(m.data()[i]);
+    }
+    const auto *ix = in.x().data(), *iy = in.y().data(), *iz = in.z().data();
+    auto *ox = out.x().data(), *oy = out.y().data(), *oz = out.z().data();
+    detail::runVec3Kernel(out.size(), threads, [&](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i) {
+        const Rep x = ix[i], y = iy[i], z = iz[i];
+        ox[i] = k[0] * x + k[1] * y + k[2] * z;
+        oy[i] = k[3] * x + k[4] * y + k[5] * z;
+        oz[i] = k[6] * x + k[7] * y + k[8] * z;
+      }
+    });
+  }
+
+  // out[i] = norm(in[i])
+  template<typename Q, typename Out>
+  void norm(const Vec3Array<Q>& in, Out&& out, unsigned threads = 1) {
+    static_assert(std::is_same<Q, range_quantity_t<Out>>::value,
+                  "Output range must have the dimension of the vectors");
+    auto o = mutableSpan(out);
+    detail::checkSizes(in.size(), o.size());
+    const auto *ix = in.x().data(), *iy = in.y().data(), *iz = in.z().data();
+    auto* od = o.data();
+    detail::runVec3Kernel(o.size(), threads, [&](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i) {
+        od[i] = std::sqrt(ix[i] * ix[i] + iy[i] * iy[i] + iz[i] * iz[i]);
+      }
+    });
+  }
+}
@@ -0,0 +1,373 @@
+#pragma once
+#include <uniTypes.h>
+#include <uniTypes/convert.h>
+#include <uniTypes/dimension.h>
+#include <uniTypes/dynQuantity.h>
+#include <uniTypes/mappedFile.h>
+#include <uniTypes/quantityVector.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+// Compact binary format for batches of quantities.
+//
+// A batch is a 64-byte header followed by the packed values, all little-endian:
+//
+//   offset  size  field
+//        0     4  magic "UTQB"
+//        4     2  format version (kWireVersion)
+//        6     1  rep code (WireRep)
+//        7     1  exponent scale (Dimension::kExponentScale)
+//        8     8  dimension exponents, one signed byte each, in multiples of 1 / exponent scale,
+//                 in the order of BaseDimension
+//       16     8  unit scale: SI value of one stored unit, as an IEEE-754 double
+//       24     8  number of values
+//       32    32  reserved, zero
+//       64         values
+//
+// Values start 64 bytes into the batch, so a batch at the start of a file or of any 64-byte
+// aligned buffer can be viewed in place. A QuantityFile maps such a file and checks its dimension
+// once when it is viewed as a QuantitySpan, rather than per element.
+//
+// Version 2 gave IU a base dimension of its own in the last exponent slot. Version 1 batches have
+// the same layout and are still read, but UOBA values were dimensionless then: a version 1 batch
+// of UOBA values decodes as Number, and its exponents must be set to those of UOBA to read it back
+// as UOBA.
+namespace uniTypes {
+  constexpr std::uint16_t kWireVersion = 2;
+  // Oldest version decodeWireHeader accepts.
+  constexpr std::uint16_t kOldestWireVersion = 1;
+  constexpr std::size_t kWireHeaderSize = 64;
+  constexpr std::size_t kWireDimensions = 8;
+
+  static_assert(kNumBaseDimensions <= kWireDimensions, "Every base dimension needs a wire slot");
+
+  // Type of the stored values.
+  enum class WireRep : std::uint8_t { Float32 = 1, Float64 = 2, Int32 = 3, Int64 = 4 };
+
+  namespace detail {
+    constexpr char kWireMagic[4] = {'U', 'T', 'Q', 'B'};
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    constexpr bool kLittleEndianHost = false;
+#else
+    constexpr bool kLittleEndianHost = true;
+#endif
+
+    template<typename Rep>
+    struct wire_rep;
+    template<>
+    struct wire_rep<float> : std::integral_constant<WireRep, WireRep::Float32> {};
+    template<>
+    struct wire_rep<double> : std::integral_constant<WireRep, WireRep::Float64> {};
+    template<>
+    struct wire_rep<std::int32_t> : std::integral_constant<WireRep, WireRep::Int32> {};
+    template<>
+    struct wire_rep<std::int64_t> : std::integral_constant<WireRep, WireRep::Int64> {};
+
+    inline std::size_t wireRepSize(WireRep rep) {
+      switch (rep) {
+        case WireRep::Float32: return 4;
+        case WireRep::Float64: return 8;
+        case WireRep::Int32: return 4;
+        case WireRep::Int64: return 8;
+      }
+      throw std::invalid_argument("uniTypes: unknown wire rep code");
+    }
+
+    // Reverses the bytes of value if the host is big-endian.
+    template<typename T>
+    T littleEndian(T value) {
+      if (kLittleEndianHost) {
+        return value;
+      }
+      unsigned char bytes[sizeof(T)];
+      std::memcpy(bytes, &value, sizeof(T));
+      std::reverse(bytes, bytes + sizeof(T));
+      std::memcpy(&value, bytes, sizeof(T));
+      return value;
+    }
+
+    template<typename T>
+    void storeLittle(char* out, T value) {
+      value = littleEndian(value);
+      std::memcpy(out, &value, sizeof(T));
+    }
+
+    template<typename T>
+    T loadLittle(const char* in) {
+      T value;
+      std::memcpy(&value, in, sizeof(T));
+      return littleEndian(value);
+    }
+
+    // value as Rep. Batches come from outside the program, so for an integer Rep a value that is
+    // not finite or out of range throws std::invalid_argument instead of being cast, which would
+    // be undefined.
+    template<typename Rep>
+    Rep wireValueAs(double value) {
+      if constexpr (std::is_integral<Rep>::value) {
+        // Both bounds are exact doubles: 0 or -2^(N-1), and 2^N or 2^(N-1).
+        constexpr double lower = static_cast<double>(std::numeric_limits<Rep>::min());
+        constexpr double upper =
+          2.0 * static_cast<double>(std::numeric_limits<Rep>::max() / 2 + 1);
+        if (!(value >= lower && value < upper)) {
+          throw std::invalid_argument("uniTypes: batch value " + std::to_string(value) +
+                                      " does not fit the integer rep");
+        }
+      }
+      return static_cast<Rep>(value);
+    }
+  }
+
+  // Decoded batch header.
+  struct WireHeader {
+    std::uint16_t version = kWireVersion;
+    WireRep rep = WireRep::Float64;
+    std::array<std::int8_t, kWireDimensions> exponents{};
+    double scale = 1.0;
+    std::uint64_t count = 0;
+
+    // Dimension of the stored values. Throws DimensionMismatch if they have a base dimension
+    // this build does not know about.
+    Dimension dimension() const {
+      Dimension result;
+      for (std::size_t i = 0; i < kWireDimensions; ++i) {
+        if (i < kNumBaseDimensions) {
+          result.exponents[i] = exponents[i];
+        } else if (exponents[i] != 0) {
+          throw DimensionMismatch("uniTypes: batch has an unknown base dimension");
+        }
+      }
+      return result;
+    }
+
+    std::size_t valueBytes() const {
+      return static_cast<std::size_t>(count) * detail::wireRepSize(rep);
+    }
+  };
+
+  // ------------------------------------------
+  // encodeWireHeader
+  // ------------------------------------------
+  // Writes header to out[0, kWireHeaderSize).
+  inline void encodeWireHeader(const WireHeader& header, char* out) {
+    std::memset(out, 0, kWireHeaderSize);
+    std::memcpy(out, detail::kWireMagic, sizeof(detail::kWireMagic));
+    detail::storeLittle(out + 4, header.version);
+    out[6] = static_cast<char>(header.rep);
+    out[7] = static_cast<char>(Dimension::kExponentScale);
+    for (std::size_t i = 0; i < kWireDimensions; ++i) {
+      out[8 + i] = static_cast<char>(header.exponents[i]);
+    }
+    detail::storeLittle(out + 16, header.scale);
+    detail::storeLittle(out + 24, header.count);
+  }
+
+  // ------------------------------------------
+  // decodeWireHeader
+  // ------------------------------------------
+  // Reads the header of the batch in data[0, size). Throws std::invalid_argument if it is not a
+  // batch of a supported version, or if size is too small to hold all of its values.
+  inline WireHeader decodeWireHeader(const char* data, std::size_t size) {
+    if (size < kWireHeaderSize ||
+        std::memcmp(data, detail::kWireMagic, sizeof(detail::kWireMagic)) != 0) {
+      throw std::invalid_argument("uniTypes: not a quantity batch");
+    }
+    WireHeader header;
+    header.version = detail::loadLittle<std::uint16_t>(data + 4);
+    if (header.version < kOldestWireVersion || header.version > kWireVersion) {
+      throw std::invalid_argument("uniTypes: unsupported batch version " +
+                                  std::to_string(header.version));
+    }
+    header.rep = static_cast<WireRep>(data[6]);
+    detail::wireRepSize(header.rep);
+    if (data[7] != Dimension::kExponentScale) {
+      throw std::invalid_argument("uniTypes: unsupported batch exponent scale");
+    }
+    for (std::size_t i = 0; i < kWireDimensions; ++i) {
+      header.exponents[i] = static_cast<std::int8_t>(data[8 + i]);
+    }
+    header.scale = detail::loadLittle<double>(data + 16);
+    header.count = detail::loadLittle<std::uint64_t>(data + 24);
+    const std::size_t capacity = (size - kWireHeaderSize) / detail::wireRepSize(header.rep);
+    if (header.count > capacity) {
+      throw std::invalid_argument("uniTypes: batch is truncated");
+    }
+    return header;
+  }
+
+  // Header for values of quantity type Q stored in multiples of unit.
+  template<typename Q>
+  WireHeader makeWireHeader(std::uint64_t count, double unit = 1.0) {
+    WireHeader header;
+    header.rep = detail::wire_rep<typename Q::rep>::value;
+    const Dimension dimension = dimensionOf<Q>();
+    for (std::size_t i = 0; i < kNumBaseDimensions; ++i) {
+      header.exponents[i] = dimension.exponents[i];
+    }
+    header.scale = unit;
+    header.count = count;
+    return header;
+  }
+
+  // ------------------------------------------
+  // writeQuantities
+  // ------------------------------------------
+  // Writes range, a QuantityVector or QuantitySpan, to out as a batch.
+  // RatioQuantity unit = SI unit, Unit the values are stored in. The values keep the rep of range,
+  // so integer quantities stored in a unit other than their own are truncated.
+  template<typename Range, typename D, typename R>
+  void writeQuantities(std::ostream& out, const Range& range, RatioQuantity<D, R> unit) {
+    using Q = range_quantity_t<Range>;
+    using Rep = typename Q::rep;
+    static_assert(std::is_same<Q, with_rep_t<RatioQuantity<D>, Rep>>::value,
+                  "Can only store quantities in a unit of the same dimension");
+    const auto values = constSpan(range);
+
+    char header[kWireHeaderSize];
+    encodeWireHeader(makeWireHeader<Q>(values.size(), static_cast<double>(unit.getValue())),
+                     header);
+    out.write(header, kWireHeaderSize);
+
+    if (detail::kLittleEndianHost && unit.getValue() == R(1)) {
+      out.write(reinterpret_cast<const char*>(values.data()),
+                static_cast<std::streamsize>(values.size() * sizeof(Rep)));
+      return;
+    }
+    constexpr std::size_t kChunk = 4096;
+    Rep buffer[kChunk];
+    for (std::size_t begin = 0; begin < values.size(); begin += kChunk) {
+      const std::size_t n = std::min(kChunk, values.size() - begin);
+      convertTo(values.subspan(begin, n), unit, buffer);
+      for (std::size_t i = 0; i < n; ++i) {
+        buffer[i] = detail::littleEndian(buffer[i]);
+      }
+      out.write(reinterpret_cast<const char*>(buffer),
+                static_cast<std::streamsize>(n * sizeof(Rep)));
+    }
+  }
+
+  template<typename Range>
+  void writeQuantities(std::ostream& out, const Range& range) {
+    writeQuantities(out, range, range_quantity_t<Range>(1));
+  }
+
+  // Writes range to the file at path, replacing it. Throws std::system_error if the file cannot be
+  // written.
+  template<typename Range, typename... Unit>
+  void writeQuantityFile(const std::string& path, const Range& range, Unit... unit) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (file) {
+      writeQuantities(file, range, unit...);
+      file.flush();
+    }
+    if (!file) {
+      throw std::system_error(std::make_error_code(std::errc::io_error),
+                              "uniTypes: cannot write " + path);
+    }
+  }
+
+  // ------------------------------------------
+  // viewQuantities
+  // ------------------------------------------
+  // Views the batch in data[0, size) as quantities of type Q without copying. The batch must hold
+  // SI values of Q's rep and dimension, and data + kWireHeaderSize must be aligned for that rep.
+  // Throws DimensionMismatch for another dimension and std::invalid_argument if the values cannot
+  // be used in place (use readQuantities for those).
+  template<typename Q>
+  QuantitySpan<const Q> viewQuantities(const char* data, std::size_t size) {
+    using Rep = typename Q::rep;
+    const WireHeader header = decodeWireHeader(data, size);
+    if (header.dimension() != dimensionOf<Q>()) {
+      throw DimensionMismatch("uniTypes: batch does not have the requested dimension");
+    }
+    const char* values = data + kWireHeaderSize;
+    const bool aligned = reinterpret_cast<std::uintptr_t>(values) % alignof(Rep) == 0;
+    if (header.rep != detail::wire_rep<Rep>::value || header.scale != 1.0 ||
+        !detail::kLittleEndianHost || !aligned) {
+      throw std::invalid_argument("uniTypes: batch cannot be viewed in place");
+    }
+    return QuantitySpan<const Q>(reinterpret_cast<const Rep*>(values),
+                                 static_cast<std::size_t>(header.count));
+  }
+
+  // ------------------------------------------
+  // readQuantities
+  // ------------------------------------------
+  // Copies the batch in data[0, size) into a QuantityVector<Q>, converting from any stored rep,
+  // unit and byte order. Throws DimensionMismatch for another dimension, and
+  // std::invalid_argument if Q has an integer rep and a value converted through double is not
+  // finite or does not fit it.
+  template<typename Q>
+  QuantityVector<Q> readQuantities(const char* data, std::size_t size) {
+    using Rep = typename Q::rep;
+    const WireHeader header = decodeWireHeader(data, size);
+    if (header.dimension() != dimensionOf<Q>()) {
+      throw DimensionMismatch("uniTypes: batch does not have the requested dimension");
+    }
+    const std::size_t n = static_cast<std::size_t>(header.count);
+    const char* values = data + kWireHeaderSize;
+    QuantityVector<Q> result(n);
+    Rep* out = result.data();
+    const auto copy = [&](auto tag) {
+      using Stored = decltype(tag);
+      for (std::size_t i = 0; i < n; ++i) {
+        const Stored value = detail::loadLittle<Stored>(values + i * sizeof(Stored));
+        // Integers in SI units are copied exactly rather than through double.
+        if (header.scale == 1.0 &&
+            (std::is_integral<Stored>::value || !std::is_integral<Rep>::value)) {
+          out[i] = static_cast<Rep>(value);
+        } else {
+          out[i] = detail::wireValueAs<Rep>(static_cast<double>(value) * header.scale);
+        }
+      }
+    };
+    switch (header.rep) {
+      case WireRep::Float32: copy(float()); break;
+      case WireRep::Float64: copy(double()); break;
+      case WireRep::Int32: copy(std::int32_t()); break;
+      case WireRep::Int64: copy(std::int64_t()); break;
+    }
+    return result;
+  }
+
+  // Memory-mapped batch file.
+  class QuantityFile {
+  public:
+    // Maps path and reads its header. Throws std::system_error if the file cannot be opened and
+    // std::invalid_argument if it is not a batch.
+    explicit QuantityFile(const std::string& path)
+      : file_(path), header_(decodeWireHeader(file_.data(), file_.size())) {}
+
+    const WireHeader& header() const { return header_; }
+    std::size_t size() const { return static_cast<std::size_t>(header_.count); }
+    Dimension dimension() const { return header_.dimension(); }
+
+    // The values in place, valid while this QuantityFile is alive. See viewQuantities.
+    template<typename Q>
+    QuantitySpan<const Q> as() const {
+      return viewQuantities<Q>(file_.data(), file_.size());
+    }
+
+    // A converted copy of the values. See readQuantities.
+    template<typename Q>
+    QuantityVector<Q> read() const {
+      return readQuantities<Q>(file_.data(), file_.size());
+    }
+
+  private:
+    MappedFile file_;
+    WireHeader header_;
+  };
+}
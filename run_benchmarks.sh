@@ -0,0 +1,47 @@
+#!/bin/bash
+# Builds bench_main and saves its results as JSON in bench_results/<commit>.json, so results can be
+# compared between commits. Pass the JSON file of an earlier run to compare against it, e.g.
+#   ./run_benchmarks.sh bench_results/0a7001b.json
+# Any further arguments are handed to bench_main (e.g. --benchmark_filter=BM_Core).
+
+baseline=""
+if [ -n "$1" ] && [ -f "$1" ]
+then
+  baseline=$(realpath "$1")
+  shift
+fi
+
+if [ -d build ]
+then
+  cd build
+else
+  mkdir build
+  cd build
+fi
+
+cmake -DBUILD_BENCHMARKS=ON ..
+make bench_main
+
+if [ ! -f bench_main ]
+then
+  export RED_FONT_COLOR='\033[0;31m'
+  echo -e "${RED_FONT_COLOR}Build failed!"
+  exit 1
+fi
+
+commit=$(git rev-parse --short HEAD)
+if [ -n "$(git status --porcelain --untracked-files=no)" ]
+then
+  commit="${commit}-dirty"
+fi
+mkdir -p ../bench_results
+result="../bench_results/${commit}.json"
+
+./bench_main --benchmark_out="${result}" --benchmark_out_format=json "$@"
+echo "Saved results to bench_results/${commit}.json"
+
+# Google Benchmark ships a comparison tool with its sources.
+if [ -n "${baseline}" ]
+then
+  python3 googlebenchmark-src/tools/compare.py benchmarks "${baseline}" "${result}"
+fi
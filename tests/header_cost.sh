@@ -0,0 +1,71 @@
+#!/bin/bash
+# Measures what including the uniTypes headers costs a translation unit:
+#   - the time to compile a file that includes each public header, and
+#   - the heap allocations a program makes before main() when it includes uniTypes.h, which must
+#     be zero now that the unit tables are static data.
+# Run from the repository root. CXX defaults to g++.
+
+CXX=${CXX:-g++}
+cd "$(dirname "$0")/.."
+work=$(mktemp -d)
+trap 'rm -rf "${work}"' EXIT
+
+echo "Compile time per header (-std=c++17 -O2, ms):"
+for header in uniTypes.h uniTypes/dims.h uniTypes/quantity.h uniTypes/units.h uniTypes/literals.h \
+              uniTypes/unitMaps.h
+do
+  echo "#include <${header}>" > "${work}/tu.cpp"
+  start=$(date +%s%N)
+  if ! ${CXX} -std=c++17 -O2 -Iinclude -c "${work}/tu.cpp" -o "${work}/tu.o"; then
+    echo "Failed to compile ${header}"
+    exit 1
+  fi
+  end=$(date +%s%N)
+  printf "  %-24s %d\n" "${header}" $(( (end - start) / 1000000 ))
+done
+
+# Two translation units include the headers, which also checks that they link without ODR
+# violations. Replacement operator new counts every allocation made before main().
+cat > "${work}/first.cpp" <<'CPP'
+#include <uniTypes.h>
+#include <uniTypes/dynQuantity.h>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+static int allocations = 0;
+
+void* operator new(std::size_t size) {
+  ++allocations;
+  if (void* p = std::malloc(size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+double secondUnit();
+
+int main() {
+  const int at_startup = allocations;
+  std::printf("Allocations before main: %d\n", at_startup);
+  const double sum = uniTypes::string_to_mass_unit.at("lb").getValue() + secondUnit();
+  return at_startup == 0 && sum > 0.0 ? 0 : 1;
+}
+CPP
+cat > "${work}/second.cpp" <<'CPP'
+#include <uniTypes.h>
+#include <uniTypes/dynQuantity.h>
+
+double secondUnit() {
+  return uniTypes::string_to_volume_unit.at("cup").getValue();
+}
+CPP
+
+if ! ${CXX} -std=c++17 -O2 -Iinclude "${work}/first.cpp" "${work}/second.cpp" -o "${work}/probe"
+then
+  echo "Failed to build the startup probe"
+  exit 1
+fi
+"${work}/probe"
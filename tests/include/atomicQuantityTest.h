@@ -0,0 +1,88 @@
+#include <uniTypes/atomicQuantity.h>
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// For using the string literal operators.
+using namespace uniTypes::string_literals;
+
+namespace {
+  template<typename Atomic, typename Delta, typename = void>
+  struct can_fetch_add : std::false_type {};
+
+  template<typename Atomic, typename Delta>
+  struct can_fetch_add<Atomic, Delta, std::void_t<decltype(std::declval<Atomic&>().fetch_add(
+                                                             std::declval<Delta>()))>>
+    : std::true_type {};
+
+  // Runs fn(thread_index) on threads threads and waits for them.
+  template<typename Fn>
+  void runOnThreads(unsigned threads, Fn fn) {
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; ++t) {
+      pool.emplace_back(fn, t);
+    }
+    for (std::thread& thread : pool) {
+      thread.join();
+    }
+  }
+}
+
+TEST(atomicQuantityTest, AtomicOperationsTest) {
+  static_assert(can_fetch_add<uniTypes::AtomicQuantity<uniTypes::Mass>, uniTypes::Mass>::value);
+  static_assert(!can_fetch_add<uniTypes::AtomicQuantity<uniTypes::Mass>, uniTypes::Length>::value);
+
+  uniTypes::AtomicQuantity<uniTypes::Energy> energy(1.0_kJ);
+  EXPECT_TRUE(energy.is_lock_free());
+  EXPECT_FLOAT_EQ(energy.fetch_add(500.0_J).convertTo(uniTypes::kilojoule), 1.0);
+  EXPECT_FLOAT_EQ((energy += 500.0_J).convertTo(uniTypes::kilojoule), 2.0);
+  EXPECT_FLOAT_EQ((energy -= 1.0_kJ).convertTo(uniTypes::kilojoule), 1.0);
+
+  uniTypes::Energy expected = 2.0_kJ;
+  EXPECT_FALSE(energy.compare_exchange_strong(expected, 5.0_kJ));
+  EXPECT_FLOAT_EQ(expected.convertTo(uniTypes::kilojoule), 1.0);
+  EXPECT_TRUE(energy.compare_exchange_strong(expected, 5.0_kJ));
+  EXPECT_FLOAT_EQ(energy.exchange(0.0_J).convertTo(uniTypes::kilojoule), 5.0);
+  EXPECT_EQ(energy.load().getValue(), 0.0);
+}
+
+TEST(atomicQuantityTest, ConcurrentAddTest) {
+  const unsigned threads = 4;
+  const int adds = 20000;
+
+  uniTypes::AtomicQuantity<uniTypes::Time> busy;
+  using IntSeconds = uniTypes::with_rep_t<uniTypes::Time, std::int64_t>;
+  uniTypes::AtomicQuantity<IntSeconds> ticks;
+  runOnThreads(threads, [&](unsigned) {
+    for (int i = 0; i < adds; ++i) {
+      busy.fetch_add(uniTypes::second);
+      ticks += IntSeconds(3);
+    }
+  });
+  // Whole seconds add exactly in double, so no update may be lost.
+  EXPECT_EQ(busy.load().getValue(), static_cast<double>(threads * adds));
+  EXPECT_EQ(ticks.load().getValue(), 3 * std::int64_t(threads) * adds);
+}
+
+TEST(atomicQuantityTest, ShardedAccumulatorTest) {
+  const unsigned threads = 4;
+  const int adds = 20000;
+
+  uniTypes::ShardedAccumulator<uniTypes::Mass> total(3);
+  EXPECT_EQ(total.shards(), 3u);
+  runOnThreads(threads, [&](unsigned) {
+    for (int i = 0; i < adds; ++i) {
+      total += uniTypes::kilogram;
+    }
+  });
+  EXPECT_EQ(total.total().getValue(), static_cast<double>(threads * adds));
+
+  total.reset();
+  EXPECT_EQ(total.total().getValue(), 0.0);
+  total.add(250.0_g);
+  EXPECT_FLOAT_EQ(total.total().convertTo(uniTypes::gram), 250.0);
+}
@@ -0,0 +1,73 @@
+#include <uniTypes/conversionPlan.h>
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(conversionPlanTest, CompileTest) {
+  const uniTypes::ConversionPlan lb_to_kg = uniTypes::ConversionPlan::compile("lb", "kg");
+  EXPECT_DOUBLE_EQ(lb_to_kg.factor(), 0.45359237);
+  EXPECT_TRUE(lb_to_kg.dimension() == uniTypes::dimensionOf<uniTypes::Mass>());
+  EXPECT_DOUBLE_EQ(lb_to_kg(10.0), (10.0 * uniTypes::pound).convertTo(uniTypes::kilogram));
+
+  const uniTypes::ConversionPlan cup_to_ml = uniTypes::ConversionPlan::compile("cup", "ml");
+  std::vector<double> cups{1.0, 0.5, 2.0};
+  cup_to_ml.apply(cups.data(), cups.size(), cups.data());
+  EXPECT_DOUBLE_EQ(cups[0], uniTypes::cup.convertTo(uniTypes::milliliter));
+  EXPECT_DOUBLE_EQ(cups[2], 2.0 * uniTypes::cup.convertTo(uniTypes::milliliter));
+
+  EXPECT_THROW(uniTypes::ConversionPlan::compile("lb", "ml"), uniTypes::DimensionMismatch);
+  EXPECT_THROW(uniTypes::ConversionPlan::compile("lb", "furlong"), std::out_of_range);
+
+  const uniTypes::ConversionPlan hours(uniTypes::hour, uniTypes::minute);
+  EXPECT_DOUBLE_EQ(hours(1.5), 90.0);
+}
+
+TEST(conversionPlanTest, CacheTest) {
+  uniTypes::ConversionPlanCache cache(4);
+  EXPECT_EQ(cache.capacity(), 4u);
+  EXPECT_DOUBLE_EQ(cache.get("kg", "g").factor(), 1000.0);
+  EXPECT_DOUBLE_EQ(cache.get("kg", "g").factor(), 1000.0);
+  EXPECT_EQ(cache.size(), 1u);
+
+  EXPECT_THROW(cache.get("kg", "s"), uniTypes::DimensionMismatch);
+  EXPECT_EQ(cache.size(), 1u);
+
+  // Pairs beyond the capacity are still converted, just not cached.
+  const char* units[] = {"g", "mg", "lb", "oz", "ton", "st"};
+  for (const char* unit : units) {
+    EXPECT_TRUE(cache.get("kg", unit).dimension() == uniTypes::dimensionOf<uniTypes::Mass>());
+  }
+  EXPECT_EQ(cache.size(), 4u);
+  EXPECT_DOUBLE_EQ(cache.get("kg", "st").factor(), 1.0 / 6.35029318);
+}
+
+TEST(conversionPlanTest, ConcurrentCacheTest) {
+  uniTypes::ConversionPlanCache cache(64);
+  const std::vector<std::string> units{"g", "mg", "lb", "oz", "kg", "ton"};
+  std::vector<std::thread> workers;
+  std::vector<int> mismatches(8, 0);
+  for (std::size_t t = 0; t < mismatches.size(); ++t) {
+    workers.emplace_back([&, t] {
+      for (int round = 0; round < 200; ++round) {
+        for (const std::string& from : units) {
+          for (const std::string& to : units) {
+            const double expected = uniTypes::lookupUnit(from)->factor /
+                                    uniTypes::lookupUnit(to)->factor;
+            mismatches[t] += cache.get(from, to).factor() != expected ? 1 : 0;
+          }
+        }
+      }
+    });
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  for (int count : mismatches) {
+    EXPECT_EQ(count, 0);
+  }
+  EXPECT_EQ(cache.size(), units.size() * units.size());
+}
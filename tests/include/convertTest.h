@@ -0,0 +1,62 @@
+#include <uniTypes/convert.h>
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <vector>
+
+// For using the string literal operators.
+using namespace uniTypes::string_literals;
+
+TEST(convertTest, ConversionFactorTest) {
+  static_assert(uniTypes::conversionFactor(uniTypes::foot, uniTypes::inch) == 12.0 * 1.0);
+  EXPECT_FLOAT_EQ(uniTypes::conversionFactor(uniTypes::pound, uniTypes::kilogram), 0.45359237);
+}
+
+TEST(convertTest, RawConvertTest) {
+  std::vector<double> pounds{1.0, 2.0, 10.0};
+  std::vector<double> kilograms(pounds.size());
+  uniTypes::convert(pounds.data(), pounds.size(), uniTypes::pound, uniTypes::kilogram,
+                    kilograms.data());
+
+  for (std::size_t i = 0; i < pounds.size(); ++i) {
+    EXPECT_FLOAT_EQ(kilograms[i], (pounds[i] * uniTypes::pound).convertTo(uniTypes::kilogram));
+  }
+}
+
+TEST(convertTest, InPlaceConvertTest) {
+  std::vector<double> values{2.0, 4.0};
+  uniTypes::convert(values.data(), values.size(), uniTypes::cup, uniTypes::tablespoon);
+  EXPECT_FLOAT_EQ(values[0], 32.0);
+  EXPECT_FLOAT_EQ(values[1], 64.0);
+}
+
+TEST(convertTest, MultithreadedConvertTest) {
+  const std::size_t n = 3 * uniTypes::kConvertGrain + 17;
+  std::vector<double> values(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    values[i] = static_cast<double>(i);
+  }
+  std::vector<double> serial(n), threaded(n);
+  uniTypes::convert(values.data(), n, uniTypes::mile, uniTypes::kilometer, serial.data(), 1);
+  uniTypes::convert(values.data(), n, uniTypes::mile, uniTypes::kilometer, threaded.data(), 4);
+  EXPECT_EQ(serial, threaded);
+}
+
+TEST(convertTest, TypedConvertTest) {
+  uniTypes::QuantityVector<uniTypes::Energy> energies{1_kcal, 2_kcal};
+  std::vector<double> kilojoules(energies.size());
+  uniTypes::convertTo(energies, uniTypes::kilojoule, kilojoules.data());
+  EXPECT_FLOAT_EQ(kilojoules[1], 8.368);
+
+  uniTypes::QuantityVector<uniTypes::Energy> round_trip(energies.size());
+  uniTypes::convertFrom(kilojoules.data(), uniTypes::kilojoule, round_trip);
+  EXPECT_FLOAT_EQ(round_trip[0].convertTo(uniTypes::kilocalorie), 1.0);
+}
+
+TEST(convertTest, DimensionlessConvertTest) {
+  uniTypes::QuantityVector<uniTypes::UOBA> activity{250_IU, 1000_IU};
+  std::vector<double> thousands_of_iu(activity.size());
+  uniTypes::convertTo(activity, 1000.0 * uniTypes::IU, thousands_of_iu.data());
+  EXPECT_FLOAT_EQ(thousands_of_iu[0], 0.25);
+  EXPECT_FLOAT_EQ(thousands_of_iu[1], 1.0);
+}
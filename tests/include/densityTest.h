@@ -0,0 +1,155 @@
+#include <uniTypes/density.h>
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// For using the string literal operators.
+using namespace uniTypes::string_literals;
+
+namespace {
+  enum Ingredient : std::uint64_t { Flour = 1, Sugar = 2, Butter = 3, Honey = 1000003 };
+
+  uniTypes::DensityTable densityTestTable() {
+    return uniTypes::DensityTable{{Flour, 0.53 * uniTypes::gram_per_milliliter},
+                                  {Sugar, 0.85 * uniTypes::gram_per_milliliter},
+                                  {Butter, 0.911 * uniTypes::gram_per_milliliter},
+                                  {Honey, 1.42 * uniTypes::kilogram_per_liter}};
+  }
+}
+
+TEST(densityTest, TableTest) {
+  static_assert(std::is_same<uniTypes::quantity_product_t<uniTypes::Volume, uniTypes::Density>,
+                             uniTypes::Mass>::value,
+                "Volume times density is a mass");
+  static_assert(std::is_same<uniTypes::quantity_product_t<uniTypes::UOBA, uniTypes::MassPerIU>,
+                             uniTypes::Mass>::value,
+                "IU times mass per IU is a mass");
+
+  uniTypes::DensityTable table = densityTestTable();
+  EXPECT_EQ(table.size(), 4u);
+  EXPECT_TRUE(table.contains(Honey));
+  EXPECT_FALSE(table.contains(4));
+  EXPECT_DOUBLE_EQ(table.at(Flour).getValue(), 530.0);
+  EXPECT_THROW(table.at(4), std::out_of_range);
+  EXPECT_THROW(uniTypes::DensityTable().at(Flour), std::out_of_range);
+
+  table.set(Flour, 0.593 * uniTypes::gram_per_milliliter);
+  EXPECT_EQ(table.size(), 4u);
+  EXPECT_DOUBLE_EQ(table.at(Flour).getValue(), 593.0);
+  EXPECT_THROW(table.set(5, uniTypes::Density()), std::invalid_argument);
+  EXPECT_THROW(table.set(uniTypes::DensityTable::kEmptyKey, uniTypes::gram_per_milliliter),
+               std::invalid_argument);
+
+  // Compact ids set out of order, including below the first one.
+  uniTypes::DensityTable compact;
+  for (std::uint64_t id = 600; id > 0; id -= 3) {
+    compact.set(id + 500, static_cast<double>(id) * uniTypes::gram_per_milliliter);
+  }
+  EXPECT_EQ(compact.size(), 200u);
+  EXPECT_DOUBLE_EQ(compact.at(503).getValue(), 3000.0);
+  EXPECT_DOUBLE_EQ(compact.at(1100).getValue(), 600000.0);
+  EXPECT_FALSE(compact.contains(502));
+  EXPECT_FALSE(compact.contains(499));
+  EXPECT_FALSE(compact.contains(1101));
+  const std::vector<std::uint64_t> compact_ids{503, 1100, 502};
+  const uniTypes::QuantityVector<uniTypes::Volume> liters{1 * uniTypes::liter, 2 * uniTypes::liter,
+                                                         3 * uniTypes::liter};
+  uniTypes::QuantityVector<uniTypes::Mass> compact_masses(2);
+  compact.multiply(compact_ids.data(), liters.span().subspan(0, 2), compact_masses);
+  EXPECT_DOUBLE_EQ(compact_masses[1].getValue(), 1200.0);
+  uniTypes::QuantityVector<uniTypes::Mass> three(3);
+  EXPECT_THROW(compact.multiply(compact_ids.data(), liters, three), std::out_of_range);
+
+  // Spreading out hundreds of compact ids moves them all to the hashed slots.
+  for (std::uint64_t id = 0; id < 300; ++id) {
+    compact.set(id, static_cast<double>(id + 1) * uniTypes::gram_per_milliliter);
+  }
+  compact.set(1000000000, uniTypes::gram_per_milliliter);
+  EXPECT_EQ(compact.size(), 501u);
+  for (std::uint64_t id = 0; id < 300; ++id) {
+    ASSERT_DOUBLE_EQ(compact.at(id).getValue(), static_cast<double>(id + 1) * 1000.0);
+  }
+  EXPECT_DOUBLE_EQ(compact.at(1100).getValue(), 600000.0);
+  EXPECT_DOUBLE_EQ(compact.at(1000000000).getValue(), 1000.0);
+
+  // Growth keeps every entry, and copies are independent.
+  for (std::uint64_t id = 10; id < 5000; id += 7) {
+    table.set(id << 20, static_cast<double>(id) * uniTypes::gram_per_milliliter);
+  }
+  const uniTypes::DensityTable copy = table;
+  table.set(Sugar, uniTypes::gram_per_milliliter);
+  for (std::uint64_t id = 10; id < 5000; id += 7) {
+    EXPECT_DOUBLE_EQ(copy.at(id << 20).getValue(), static_cast<double>(id) * 1000.0);
+  }
+  EXPECT_DOUBLE_EQ(copy.at(Sugar).getValue(), 850.0);
+  EXPECT_EQ(copy.size(), table.size());
+}
+
+TEST(densityTest, ConvertTest) {
+  const uniTypes::DensityTable table = densityTestTable();
+  const std::vector<std::uint64_t> ids{Flour, Flour, Sugar, Butter, Honey};
+  const uniTypes::QuantityVector<uniTypes::Volume> volumes{
+    1.5 * uniTypes::cup, 2 * uniTypes::tablespoon, 1 * uniTypes::cup, 100_ml,
+    1 * uniTypes::teaspoon};
+  uniTypes::QuantityVector<uniTypes::Mass> masses(volumes.size());
+  table.multiply(ids.data(), volumes, masses);
+  for (std::size_t i = 0; i < ids.size(); ++i) {
+    EXPECT_DOUBLE_EQ(masses[i].getValue(), (volumes[i] * table.at(ids[i])).getValue());
+  }
+  EXPECT_NEAR(masses[3].convertTo(uniTypes::gram), 91.1, 1e-9);
+
+  uniTypes::QuantityVector<uniTypes::Volume> back(masses.size());
+  table.divide(ids.data(), masses, back);
+  for (std::size_t i = 0; i < ids.size(); ++i) {
+    EXPECT_NEAR(back[i].getValue(), volumes[i].getValue(), 1e-15);
+  }
+
+  const std::vector<std::uint64_t> unknown{Flour, 4, Sugar};
+  uniTypes::QuantityVector<uniTypes::Mass> three(3);
+  EXPECT_THROW(table.multiply(unknown.data(), volumes.span().subspan(0, 3), three),
+               std::out_of_range);
+  EXPECT_THROW(table.multiply(ids.data(), volumes, three), std::invalid_argument);
+
+  // IU to mass per nutrient works the same way.
+  const uniTypes::IUFactorTable nutrients{{1, 0.000025 * uniTypes::milligram_per_IU},
+                                          {2, 0.0003 * uniTypes::milligram_per_IU}};
+  const std::vector<std::uint64_t> nutrient_ids{1, 2};
+  const uniTypes::QuantityVector<uniTypes::UOBA> activity{400 * uniTypes::IU, 1000 * uniTypes::IU};
+  uniTypes::QuantityVector<uniTypes::Mass> amounts(2);
+  nutrients.multiply(nutrient_ids.data(), activity, amounts);
+  EXPECT_DOUBLE_EQ(amounts[0].convertTo(uniTypes::milligram), 0.01);
+  EXPECT_DOUBLE_EQ(amounts[1].convertTo(uniTypes::milligram), 0.3);
+}
+
+TEST(densityTest, ThreadedConvertTest) {
+  const uniTypes::DensityTable table = densityTestTable();
+  const std::uint64_t choices[] = {Flour, Sugar, Butter, Honey};
+  std::mt19937 generator(21);
+  std::uniform_int_distribution<int> pick(0, 3);
+  std::uniform_real_distribution<double> amount(0.1, 3.0);
+  std::vector<std::uint64_t> ids;
+  uniTypes::QuantityVector<uniTypes::Volume> volumes;
+  for (std::size_t i = 0; i < 300000; ++i) {
+    ids.push_back(choices[pick(generator)]);
+    volumes.push_back(amount(generator) * uniTypes::cup);
+  }
+  uniTypes::QuantityVector<uniTypes::Mass> serial(volumes.size());
+  uniTypes::QuantityVector<uniTypes::Mass> threaded(volumes.size());
+  table.multiply(ids.data(), volumes, serial);
+  table.multiply(ids.data(), volumes, threaded, 4);
+  for (std::size_t i = 0; i < volumes.size(); ++i) {
+    ASSERT_EQ(serial[i].getValue(), threaded[i].getValue());
+    const uniTypes::Mass expected = uniTypes::Volume(volumes[i]) * table.at(ids[i]);
+    ASSERT_EQ(serial[i].getValue(), expected.getValue());
+  }
+
+  // Single-precision columns.
+  uniTypes::QuantityVector<uniTypes::with_rep_t<uniTypes::Mass, float>> narrow(volumes.size());
+  table.multiply(ids.data(), volumes, narrow);
+  EXPECT_FLOAT_EQ(narrow[7].getValue(), static_cast<float>(serial[7].getValue()));
+}
@@ -0,0 +1,54 @@
+#include <uniTypes.h>
+#include <uniTypes/dimension.h>
+#include <uniTypes/format.h>
+#include <uniTypes/unitParser.h>
+#include "gtest/gtest.h"
+
+#include <sstream>
+#include <type_traits>
+
+// For using the string literal operators.
+using namespace uniTypes::string_literals;
+
+TEST(dimsTest, CanonicalDimsTest) {
+  using Speed = uniTypes::quantity_quotient_t<uniTypes::Length, uniTypes::Time>;
+  using Acceleration = uniTypes::quantity_quotient_t<Speed, uniTypes::Time>;
+
+  // Equal dimensions reached in different ways are the same type.
+  static_assert(std::is_same<decltype(1_m * 1_m), uniTypes::Area>::value);
+  static_assert(std::is_same<decltype(uniTypes::liter / 1_m), uniTypes::Area>::value);
+  static_assert(std::is_same<decltype(1_kg * Acceleration(1.0)), uniTypes::Force>::value);
+  static_assert(std::is_same<decltype(1_N * 1_m / 1_s * 1_s), uniTypes::Energy>::value);
+  static_assert(std::is_same<decltype(1_J / 1_m / 1_kg * 1_kg), uniTypes::Force>::value);
+  static_assert(std::is_same<decltype(1_m / uniTypes::liter * uniTypes::meter2),
+                             uniTypes::Number>::value);
+  static_assert(std::is_same<decltype(1.0 / (1.0 / 1_s)), uniTypes::Time>::value);
+  static_assert(std::is_same<uniTypes::dims_pow_t<uniTypes::Area::dims, 3, 2>,
+                             uniTypes::Volume::dims>::value);
+  static_assert(std::is_same<uniTypes::Length::dims, uniTypes::dims_t<0, 1, 0>>::value);
+
+  // International Units have a dimension of their own.
+  static_assert(!std::is_same<uniTypes::UOBA, uniTypes::Number>::value);
+  static_assert(!std::is_convertible<uniTypes::UOBA, uniTypes::Number>::value);
+  EXPECT_FALSE(uniTypes::dimensionOf<uniTypes::UOBA>().isDimensionless());
+  EXPECT_EQ(uniTypes::dimensionOf<uniTypes::UOBA>().exponent(uniTypes::BaseDimension::IU), 1.0);
+}
+
+TEST(dimsTest, SIBaseDimensionsTest) {
+  using MolarMass = uniTypes::quantity_quotient_t<uniTypes::Mass, uniTypes::Amount>;
+  const MolarMass water = 18.015_g / (1.0 * uniTypes::mole);
+  EXPECT_FLOAT_EQ((water * (2.0 * uniTypes::mole)).convertTo(uniTypes::gram), 36.03);
+
+  using Charge = uniTypes::quantity_product_t<uniTypes::Current, uniTypes::Time>;
+  EXPECT_TRUE(uniTypes::dimensionOf<Charge>() == uniTypes::Dimension(0, 0, 1, 0, 0, 1));
+  EXPECT_TRUE(uniTypes::dimensionOf<uniTypes::Temperature>() ==
+              uniTypes::Dimension(0, 0, 0, 1));
+
+  // Base units without a unit in the family are printed as SI base units.
+  std::ostringstream out;
+  out << 300.0 * uniTypes::kelvin << ", " << (1.5 * uniTypes::ampere) * 2_s << ", " << 400_IU;
+  EXPECT_EQ(out.str(), "300 K, 3 s*A, 400 IU");
+
+  EXPECT_TRUE(uniTypes::parseQuantity("2 mol").quantity.is<uniTypes::Amount>());
+  EXPECT_TRUE(uniTypes::parseQuantity("120 cd").quantity.is<uniTypes::LuminousIntensity>());
+}
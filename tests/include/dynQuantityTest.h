@@ -0,0 +1,82 @@
+#include <uniTypes/dynQuantity.h>
+#include "gtest/gtest.h"
+
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// For using the string literal operators.
+using namespace uniTypes::string_literals;
+
+namespace {
+  template<typename L, typename R, typename = void>
+  struct can_add : std::false_type {};
+
+  template<typename L, typename R>
+  struct can_add<L, R, std::void_t<decltype(std::declval<L>() + std::declval<R>())>>
+    : std::true_type {};
+
+  template<typename L, typename R, typename = void>
+  struct can_compare : std::false_type {};
+
+  template<typename L, typename R>
+  struct can_compare<L, R, std::void_t<decltype(std::declval<L>() == std::declval<R>()),
+                                       decltype(std::declval<L>() < std::declval<R>())>>
+    : std::true_type {};
+}
+
+TEST(dynQuantityTest, DimensionOfTest) {
+  static_assert(uniTypes::dimensionOf<uniTypes::Force>() == uniTypes::Dimension(1, 1, -2));
+  static_assert(uniTypes::dimensionOf<uniTypes::Number>().isDimensionless());
+
+  using SqrtLength = uniTypes::RatioQuantity<uniTypes::dims_pow_t<uniTypes::Length::dims, 1, 2>>;
+  constexpr uniTypes::Dimension sqrt_length = uniTypes::dimensionOf<SqrtLength>();
+  EXPECT_FLOAT_EQ(sqrt_length.exponent(uniTypes::BaseDimension::Length), 0.5);
+  EXPECT_TRUE(sqrt_length * sqrt_length == uniTypes::dimensionOf<uniTypes::Length>());
+}
+
+TEST(dynQuantityTest, StaticRoundTripTest) {
+  uniTypes::DynQuantity test_var = 2.5_kg;
+  EXPECT_TRUE(test_var.is<uniTypes::Mass>());
+  EXPECT_FALSE(test_var.is<uniTypes::Length>());
+  EXPECT_TRUE(test_var.as<uniTypes::Mass>() == 2.5_kg);
+  EXPECT_THROW(test_var.as<uniTypes::Time>(), uniTypes::DimensionMismatch);
+}
+
+TEST(dynQuantityTest, ArithmeticTest) {
+  uniTypes::DynQuantity force = 10_N;
+  uniTypes::DynQuantity distance = 3_m;
+  uniTypes::DynQuantity energy = force * distance;
+  EXPECT_FLOAT_EQ(energy.as<uniTypes::Energy>().convertTo(uniTypes::joule), 30.0);
+
+  uniTypes::DynQuantity speed = distance / uniTypes::DynQuantity(1.5_s);
+  EXPECT_TRUE(speed.getDimension() == uniTypes::Dimension(0, 1, -1));
+
+  uniTypes::DynQuantity total = distance + uniTypes::DynQuantity(2_ft);
+  EXPECT_FLOAT_EQ(total.convertTo(uniTypes::meter), 3.6096);
+  EXPECT_THROW(distance + force, uniTypes::DimensionMismatch);
+  EXPECT_THROW(distance + 10_N, uniTypes::DimensionMismatch);
+
+  // Static quantities of different dimensions still do not add or compare.
+  static_assert(can_add<uniTypes::DynQuantity, uniTypes::Mass>::value);
+  static_assert(can_add<uniTypes::Mass, uniTypes::DynQuantity>::value);
+  static_assert(!can_add<uniTypes::Mass, uniTypes::Length>::value);
+  static_assert(can_compare<uniTypes::DynQuantity, uniTypes::Length>::value);
+  static_assert(!can_compare<uniTypes::Mass, uniTypes::Length>::value);
+  EXPECT_THROW(distance.convertTo(uniTypes::second), uniTypes::DimensionMismatch);
+}
+
+TEST(dynQuantityTest, ComparisonTest) {
+  uniTypes::DynQuantity lhs = 1_kg;
+  EXPECT_TRUE(lhs > uniTypes::DynQuantity(1_lb));
+  EXPECT_TRUE(lhs == uniTypes::DynQuantity(1000_g));
+  EXPECT_THROW(lhs < uniTypes::DynQuantity(1_s), uniTypes::DimensionMismatch);
+}
+
+TEST(dynQuantityTest, FactoryKindTest) {
+  std::vector<uniTypes::DynQuantity> test_vars;
+  test_vars.push_back(uniTypes::DynQuantity::createRatio(uniTypes::QuantityKind::Volume, 0.5));
+  test_vars.push_back(uniTypes::DynQuantity::createRatio(uniTypes::QuantityKind::Force, 4.0));
+  EXPECT_TRUE(test_vars[0].is<uniTypes::Volume>());
+  EXPECT_FLOAT_EQ(test_vars[1].convertTo(uniTypes::newton), 4.0);
+}
@@ -0,0 +1,77 @@
+#include <uniTypes/expression.h>
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+#include <type_traits>
+
+// For using the string literal operators.
+using namespace uniTypes::string_literals;
+
+using Density = uniTypes::quantity_quotient_t<uniTypes::Mass, uniTypes::Volume>;
+
+TEST(expressionTest, LazyDimensionTest) {
+  uniTypes::QuantityVector<Density> density{Density(1000.0), Density(500.0)};
+  uniTypes::QuantityVector<uniTypes::Volume> volume{1_liter, 2_liter};
+  uniTypes::QuantityVector<uniTypes::Mass> tare{100_g, 200_g};
+
+  auto expr = density * volume + tare;
+  static_assert(std::is_same<decltype(expr)::quantity_type, uniTypes::Mass>::value);
+  static_assert(!std::is_same<decltype(expr), uniTypes::QuantityVector<uniTypes::Mass>>::value);
+  EXPECT_EQ(expr.size(), 2u);
+
+  uniTypes::QuantityVector<uniTypes::Mass> gross = expr;
+  EXPECT_FLOAT_EQ(gross[0].convertTo(uniTypes::gram), 1100.0);
+  EXPECT_FLOAT_EQ(gross[1].convertTo(uniTypes::gram), 1200.0);
+}
+
+TEST(expressionTest, BroadcastOperandTest) {
+  uniTypes::QuantityVector<uniTypes::Length> lengths{1_m, 2_m, 3_m};
+
+  uniTypes::QuantityVector<uniTypes::Length> padded = lengths + 50_cm;
+  EXPECT_FLOAT_EQ(padded[2].convertTo(uniTypes::centimeter), 350.0);
+
+  uniTypes::QuantityVector<uniTypes::Area> strips = 2.0 * lengths * 10_cm;
+  EXPECT_FLOAT_EQ(strips[1].convertTo(uniTypes::meter2), 0.4);
+
+  uniTypes::QuantityVector<uniTypes::Number> fractions = lengths / 4_m;
+  EXPECT_FLOAT_EQ(fractions[0].getValue(), 0.25);
+
+  uniTypes::QuantityVector<uniTypes::Length> negated = -lengths;
+  EXPECT_FLOAT_EQ(negated[1].convertTo(uniTypes::meter), -2.0);
+}
+
+TEST(expressionTest, EvaluateIntoSpanTest) {
+  uniTypes::QuantityVector<uniTypes::Time> start{1_s, 2_s, 3_s, 4_s};
+  uniTypes::QuantityVector<uniTypes::Time> end{2_s, 4_s, 6_s, 8_s};
+  uniTypes::QuantityVector<uniTypes::Time> out(4);
+
+  uniTypes::evaluate(end.span().subspan(1, 2) - start.span().subspan(1, 2),
+                     out.span().subspan(0, 2));
+  EXPECT_FLOAT_EQ(out[0].convertTo(uniTypes::second), 2.0);
+  EXPECT_FLOAT_EQ(out[1].convertTo(uniTypes::second), 3.0);
+  EXPECT_FLOAT_EQ(out[2].convertTo(uniTypes::second), 0.0);
+
+  EXPECT_THROW(uniTypes::evaluate(end - start, out.span().subspan(0, 3)), std::invalid_argument);
+}
+
+TEST(expressionTest, AliasingTest) {
+  uniTypes::QuantityVector<uniTypes::Mass> masses{1_kg, 2_kg};
+  uniTypes::QuantityVector<uniTypes::Mass> extra{1_kg, 1_kg};
+  const double* storage = masses.data();
+
+  masses = masses * 2.0 + masses;
+  EXPECT_EQ(masses.data(), storage);
+  EXPECT_FLOAT_EQ(masses[1].convertTo(uniTypes::kilogram), 6.0);
+
+  masses += extra * 3.0;
+  EXPECT_FLOAT_EQ(masses[0].convertTo(uniTypes::kilogram), 6.0);
+  masses -= extra / 2.0;
+  EXPECT_FLOAT_EQ(masses[0].convertTo(uniTypes::kilogram), 5.5);
+}
+
+TEST(expressionTest, SizeMismatchTest) {
+  uniTypes::QuantityVector<uniTypes::Mass> lhs(3);
+  uniTypes::QuantityVector<uniTypes::Mass> rhs(4);
+  EXPECT_THROW(lhs + rhs, std::invalid_argument);
+  EXPECT_THROW(lhs * 2.0 - rhs, std::invalid_argument);
+}
@@ -0,0 +1,96 @@
+#include <uniTypes/format.h>
+#include "gtest/gtest.h"
+
+#include <sstream>
+#include <string>
+
+// For using the string literal operators.
+using namespace uniTypes::string_literals;
+
+static std::string formatToString(uniTypes::DynQuantity quantity,
+                                  uniTypes::UnitFamily family = uniTypes::metric_units)
+{
+  char buffer[64];
+  const std::to_chars_result result =
+    uniTypes::formatQuantity(buffer, buffer + sizeof(buffer), quantity, family);
+  EXPECT_EQ(result.ec, std::errc());
+  return std::string(buffer, result.ptr);
+}
+
+TEST(formatTest, FewestSignificantDigitsTest) {
+  EXPECT_EQ(formatToString(1500.0 * uniTypes::gram), "1.5 kg");
+  EXPECT_EQ(formatToString(250.0 * uniTypes::gram), "250 g");
+  EXPECT_EQ(formatToString(2.0 * uniTypes::ton), "2 t");
+  EXPECT_EQ(formatToString(90.0 * uniTypes::second), "90 s");
+  EXPECT_EQ(formatToString(2.0 * uniTypes::hour), "2 h");
+  EXPECT_EQ(formatToString(330.0 * uniTypes::milliliter), "330 ml");
+  EXPECT_EQ(formatToString(-4.2 * uniTypes::kilonewton), "-4.2 kN");
+}
+
+TEST(formatTest, TieBreakByMagnitudeTest) {
+  // 1 kg and 1000 g both need one digit; 1 is in [1, 1000).
+  EXPECT_EQ(formatToString(uniTypes::kilogram), "1 kg");
+  // 1 m and 100 cm are both in range; the larger unit wins.
+  EXPECT_EQ(formatToString(uniTypes::meter), "1 m");
+  // Fewest digits beats a nicer magnitude.
+  EXPECT_EQ(formatToString(12.5 * uniTypes::pound, uniTypes::us_customary_units), "200 oz");
+}
+
+TEST(formatTest, UsCustomaryFamilyTest) {
+  EXPECT_EQ(formatToString(12.3 * uniTypes::pound, uniTypes::us_customary_units), "12.3 lb");
+  EXPECT_EQ(formatToString(3.0 * uniTypes::teaspoon, uniTypes::us_customary_units), "1 tbsp");
+  EXPECT_EQ(formatToString(2.0 * uniTypes::kilocalorie, uniTypes::us_customary_units), "2 kcal");
+  EXPECT_EQ(formatToString(36.0 * uniTypes::inch, uniTypes::us_customary_units), "1 yd");
+}
+
+TEST(formatTest, CustomFamilyTest) {
+  static constexpr uniTypes::FormatUnit kitchen[] = {
+    uniTypes::detail::formatUnit("cups", uniTypes::cup)
+  };
+  EXPECT_EQ(formatToString(2.0 * uniTypes::cup, kitchen), "2 cups");
+}
+
+TEST(formatTest, BaseUnitFallbackTest) {
+  EXPECT_EQ(formatToString(3.0 * uniTypes::newton / uniTypes::second), "3 kg*m*s^-3");
+  EXPECT_EQ(formatToString(2.0 * uniTypes::meter / uniTypes::second), "2 m*s^-1");
+  EXPECT_EQ(formatToString(uniTypes::Number(0.5)), "0.5");
+}
+
+TEST(formatTest, BufferTooSmallTest) {
+  char buffer[4];
+  const std::to_chars_result result =
+    uniTypes::formatQuantity(buffer, buffer + sizeof(buffer), 12.5 * uniTypes::kilogram);
+  EXPECT_EQ(result.ec, std::errc::value_too_large);
+}
+
+TEST(formatTest, StreamOperatorTest) {
+  std::ostringstream os;
+  os << 1500.0 * uniTypes::gram << ", " << uniTypes::DynQuantity(0.25 * uniTypes::liter);
+  EXPECT_EQ(os.str(), "1.5 kg, 250 ml");
+
+  // Fractional exponents of every base unit make a long unit string.
+  const uniTypes::Dimension sixth_roots = uniTypes::Dimension(1, 1, 1, 1, 1, 1, 1, 1).pow(-1, 6);
+  std::ostringstream long_os;
+  long_os << uniTypes::DynQuantity(-1.23456789012e-300, sixth_roots);
+  EXPECT_TRUE(long_os);
+  EXPECT_EQ(long_os.str().substr(0, 36), "-1.23456789012e-300 kg^-0.1666666666");
+  EXPECT_EQ(long_os.str().substr(long_os.str().size() - 24), "*IU^-0.16666666666666666");
+}
+
+TEST(formatTest, FormatColumnTest) {
+  uniTypes::QuantityVector<uniTypes::Mass> masses{0.25, 1.5, 2.0, 0.1};
+  EXPECT_EQ(uniTypes::bestColumnUnit(masses, uniTypes::metric_units)->symbol, "kg");
+  uniTypes::QuantityVector<uniTypes::Mass> small{0.25, 0.5, 0.125};
+  EXPECT_EQ(uniTypes::bestColumnUnit(small, uniTypes::metric_units)->symbol, "g");
+
+  char buffer[128];
+  std::to_chars_result result =
+    uniTypes::formatColumn(buffer, buffer + sizeof(buffer), masses.span(), uniTypes::metric_units,
+                           ';');
+  ASSERT_EQ(result.ec, std::errc());
+  EXPECT_EQ(std::string(buffer, result.ptr), "0.25 kg;1.5 kg;2 kg;0.1 kg;");
+
+  result = uniTypes::formatColumn(buffer, buffer + 12, masses);
+  EXPECT_EQ(result.ec, std::errc::value_too_large);
+  EXPECT_EQ(std::string(buffer, result.ptr), "0.25 kg\n");
+}
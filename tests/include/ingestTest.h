@@ -0,0 +1,111 @@
+#include <uniTypes/ingest.h>
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+// For using the string literal operators.
+using namespace uniTypes::string_literals;
+
+TEST(ingestTest, CellUnitsTest) {
+  const std::string csv =
+    "ingredient,amount,volume\n"
+    "flour,250 g,1.5 cup\n"
+    "sugar,0.5 lb,2 tbsp\n";
+  uniTypes::IngestResult result = uniTypes::ingestText(csv);
+
+  ASSERT_EQ(result.rows, 2u);
+  ASSERT_EQ(result.columns.size(), 2u);
+  EXPECT_FALSE(result.report.columns[0].is_quantity);
+
+  auto amount = result.column("amount").as<uniTypes::Mass>();
+  EXPECT_FLOAT_EQ(amount[0].convertTo(uniTypes::gram), 250.0);
+  EXPECT_FLOAT_EQ(amount[1].convertTo(uniTypes::pound), 0.5);
+
+  auto volume = result.column("volume").as<uniTypes::Volume>();
+  EXPECT_FLOAT_EQ(volume[1].convertTo(uniTypes::tablespoon), 2.0);
+  EXPECT_THROW(result.column("volume").as<uniTypes::Mass>(), uniTypes::DimensionMismatch);
+}
+
+TEST(ingestTest, HeaderUnitTsvTest) {
+  const std::string tsv =
+    "weight (kg)\tduration [min]\r\n"
+    "1.5\t90\r\n"
+    "2000 g\t1 hr\r\n";
+  uniTypes::IngestOptions options;
+  options.delimiter = '\t';
+  uniTypes::IngestResult result = uniTypes::ingestText(tsv, options);
+
+  auto weight = result.column("weight").as<uniTypes::Mass>();
+  auto duration = result.column("duration").as<uniTypes::Time>();
+  EXPECT_FLOAT_EQ(weight[0].convertTo(uniTypes::kilogram), 1.5);
+  EXPECT_FLOAT_EQ(weight[1].convertTo(uniTypes::kilogram), 2.0);
+  EXPECT_FLOAT_EQ(duration[0].convertTo(uniTypes::hour), 1.5);
+  EXPECT_FLOAT_EQ(duration[1].convertTo(uniTypes::minute), 60.0);
+}
+
+TEST(ingestTest, MismatchReportTest) {
+  const std::string csv =
+    "mass,energy\n"
+    "1 kg,100 kcal\n"
+    "2 m,\n"
+    "oops,50 kJ\n"
+    "3 kg,1 J\n";
+  uniTypes::IngestResult result = uniTypes::ingestText(csv);
+
+  ASSERT_EQ(result.rows, 4u);
+  const uniTypes::ColumnReport& mass = result.report.columns[0];
+  EXPECT_EQ(mass.dimension_mismatches, 1u);
+  EXPECT_EQ(mass.parse_errors, 1u);
+  EXPECT_EQ(mass.first_error_row, 1u);
+  EXPECT_EQ(result.report.columns[1].missing, 1u);
+
+  auto values = result.column("mass").as<uniTypes::Mass>();
+  EXPECT_TRUE(std::isnan(values[1].getValue()));
+  EXPECT_FLOAT_EQ(values[3].convertTo(uniTypes::kilogram), 3.0);
+}
+
+TEST(ingestTest, StreamingChunksTest) {
+  std::string csv = "mass (g)\n";
+  for (int i = 0; i < 1000; ++i) {
+    csv += std::to_string(i) + "\n";
+  }
+  uniTypes::IngestOptions options;
+  options.chunk_bytes = 64;
+  options.threads = 4;
+  options.max_chunks_in_flight = 3;
+
+  std::size_t batches = 0;
+  std::size_t next_row = 0;
+  double total_grams = 0.0;
+  uniTypes::IngestReport report = uniTypes::streamText(csv, [&](uniTypes::RecordBatch& batch) {
+    EXPECT_EQ(batch.first_row, next_row);
+    next_row += batch.rows;
+    ++batches;
+    for (std::size_t i = 0; i < batch.rows; ++i) {
+      total_grams += batch.columns[0].as<uniTypes::Mass>()[i].convertTo(uniTypes::gram);
+    }
+  }, options);
+
+  EXPECT_EQ(report.rows, 1000u);
+  EXPECT_GT(batches, 10u);
+  EXPECT_NEAR(total_grams, 999.0 * 1000.0 / 2.0, 1e-6);
+}
+
+TEST(ingestTest, FileTest) {
+  const std::filesystem::path path =
+    std::filesystem::temp_directory_path() / "uniTypes_ingestTest.csv";
+  {
+    std::ofstream file(path);
+    file << "distance,time\n5 km,25 min\n3 mi,20 min\n";
+  }
+  uniTypes::IngestResult result = uniTypes::ingestFile(path.string());
+  std::filesystem::remove(path);
+
+  auto distance = result.column("distance").as<uniTypes::Length>();
+  EXPECT_FLOAT_EQ(distance[1].convertTo(uniTypes::mile), 3.0);
+  EXPECT_THROW(uniTypes::ingestFile(path.string()), std::system_error);
+}
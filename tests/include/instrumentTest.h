@@ -0,0 +1,106 @@
+// The UNITYPES_* macros are only tested with instrumentation turned on.
+#define UNITYPES_INSTRUMENTATION 1
+#include <uniTypes/instrument.h>
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+// For using the string literal operators.
+using namespace uniTypes::string_literals;
+
+TEST(instrumentTest, ChronoInteropTest) {
+  static_assert(uniTypes::fromDuration(std::chrono::milliseconds(1500)).getValue() == 1.5);
+  static_assert(uniTypes::toDuration<std::chrono::milliseconds>(2.5_s).count() == 2500);
+
+  EXPECT_DOUBLE_EQ(uniTypes::fromDuration(std::chrono::hours(2)).convertTo(uniTypes::minute),
+                   120.0);
+  EXPECT_DOUBLE_EQ(uniTypes::toDuration(90.0_s).count(), 90.0);
+  EXPECT_EQ(uniTypes::toDuration<std::chrono::minutes>(1.5 * uniTypes::hour).count(), 90);
+}
+
+TEST(instrumentTest, HistogramTest) {
+  uniTypes::Instrumentation instrumentation;
+  const uniTypes::Metric<uniTypes::Time> latency =
+    instrumentation.metric<uniTypes::Time>("instrumentTest.latency");
+  for (int i = 1; i <= 1000; ++i) {
+    latency.record(i * uniTypes::millisecond);
+  }
+  EXPECT_EQ(instrumentation.drain(), 1000u);
+
+  const uniTypes::MetricSnapshot<uniTypes::Time> snapshot = instrumentation.snapshot(latency);
+  EXPECT_EQ(snapshot.name(), "instrumentTest.latency");
+  EXPECT_EQ(snapshot.count(), 1000u);
+  EXPECT_DOUBLE_EQ(snapshot.min().convertTo(uniTypes::millisecond), 1.0);
+  EXPECT_DOUBLE_EQ(snapshot.max().convertTo(uniTypes::millisecond), 1000.0);
+  EXPECT_NEAR(snapshot.mean().convertTo(uniTypes::millisecond), 500.5, 1e-9);
+  // Buckets are 1/8 of a power of two wide, so quantiles are within 1/16 of the true value.
+  EXPECT_NEAR(snapshot.quantile(0.5).convertTo(uniTypes::millisecond), 500.0, 500.0 / 16);
+  EXPECT_NEAR(snapshot.quantile(0.99).convertTo(uniTypes::millisecond), 990.0, 990.0 / 16);
+
+  // Registering the same name again returns the same metric, but only for the same dimension.
+  EXPECT_EQ(instrumentation.metric<uniTypes::Time>("instrumentTest.latency").id(), latency.id());
+  EXPECT_THROW(instrumentation.metric<uniTypes::Mass>("instrumentTest.latency"),
+               uniTypes::DimensionMismatch);
+}
+
+TEST(instrumentTest, ConcurrentRecordTest) {
+  using MassFlow = uniTypes::quantity_quotient_t<uniTypes::Mass, uniTypes::Time>;
+  const int threads = 4;
+  const int samples = 20000;
+
+  uniTypes::Instrumentation instrumentation;
+  const uniTypes::Metric<MassFlow> throughput =
+    instrumentation.metric<MassFlow>("instrumentTest.throughput");
+  instrumentation.start(std::chrono::milliseconds(1));
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&] {
+      for (int i = 0; i < samples; ++i) {
+        throughput.record(2.0_kg / 1.0_s);
+      }
+    });
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  instrumentation.stop();
+
+  // Rings that filled up between drains drop samples, but every sample is accounted for.
+  const uniTypes::MetricSnapshot<MassFlow> snapshot = instrumentation.snapshot(throughput);
+  EXPECT_EQ(snapshot.count() + instrumentation.dropped(), std::uint64_t(threads) * samples);
+  EXPECT_GT(snapshot.count(), 0u);
+  EXPECT_DOUBLE_EQ(snapshot.max().getValue(), 2.0);
+}
+
+TEST(instrumentTest, ShortLivedInstancesTest) {
+  // A thread that records into many short-lived instances keeps only the rings of live ones.
+  uniTypes::Instrumentation outer;
+  const uniTypes::Metric<uniTypes::Mass> outer_mass = outer.metric<uniTypes::Mass>("outer");
+  for (int i = 0; i < 1000; ++i) {
+    uniTypes::Instrumentation request;
+    const uniTypes::Metric<uniTypes::Mass> mass = request.metric<uniTypes::Mass>("request");
+    mass.record(1.0_kg);
+    outer_mass.record(2.0_kg);
+    request.drain();
+    ASSERT_EQ(request.snapshot(mass).count(), 1u);
+  }
+  outer.drain();
+  EXPECT_EQ(outer.snapshot(outer_mass).count(), 1000u);
+  EXPECT_EQ(outer.dropped(), 0u);
+}
+
+TEST(instrumentTest, MacroTest) {
+  for (int i = 0; i < 3; ++i) {
+    UNITYPES_SCOPED_TIMER("instrumentTest.scope");
+    UNITYPES_RECORD("instrumentTest.mass", 250.0_g * (i + 1));
+  }
+  uniTypes::instrumentation().drain();
+
+  auto scope = uniTypes::instrumentation().metric<uniTypes::Time>("instrumentTest.scope");
+  EXPECT_EQ(uniTypes::instrumentation().snapshot(scope).count(), 3u);
+  auto mass = uniTypes::instrumentation().metric<uniTypes::Mass>("instrumentTest.mass");
+  EXPECT_DOUBLE_EQ(uniTypes::instrumentation().snapshot(mass).sum().convertTo(uniTypes::kilogram),
+                   1.5);
+}
@@ -0,0 +1,140 @@
+#include <uniTypes/quantileSketch.h>
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// For using the string literal operators.
+using namespace uniTypes::string_literals;
+
+namespace {
+  // Log-normal latencies around 2 ms, with a long tail.
+  uniTypes::QuantityVector<uniTypes::Time> sketchTestLatencies(std::size_t n) {
+    std::mt19937 generator(11);
+    std::lognormal_distribution<double> latency(std::log(2e-3), 1.0);
+    uniTypes::QuantityVector<uniTypes::Time> values;
+    for (std::size_t i = 0; i < n; ++i) {
+      values.push_back(uniTypes::Time(latency(generator)));
+    }
+    return values;
+  }
+
+  double exactQuantile(std::vector<double> values, double q) {
+    const std::size_t rank = static_cast<std::size_t>(q * static_cast<double>(values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + rank, values.end());
+    return values[rank];
+  }
+}
+
+TEST(quantileSketchTest, AccuracyTest) {
+  const uniTypes::QuantityVector<uniTypes::Time> latencies = sketchTestLatencies(100000);
+  uniTypes::QuantileSketch<uniTypes::Time> sketch;
+  sketch.add(latencies);
+  EXPECT_EQ(sketch.count(), latencies.size());
+
+  const std::vector<double> raw(latencies.data(), latencies.data() + latencies.size());
+  for (double q : {0.0, 0.01, 0.25, 0.5, 0.9, 0.99, 0.999, 1.0}) {
+    const double exact = exactQuantile(raw, q);
+    const uniTypes::Time estimate = sketch.quantile(q);
+    EXPECT_LE(std::fabs(estimate.getValue() - exact), 0.01 * exact) << "q = " << q;
+  }
+  EXPECT_EQ(sketch.min().getValue(), *std::min_element(raw.begin(), raw.end()));
+  EXPECT_EQ(sketch.max().getValue(), *std::max_element(raw.begin(), raw.end()));
+
+  // Single values are exact at the ends, and within the accuracy in the middle of the range.
+  uniTypes::QuantileSketch<uniTypes::Mass> portions(0.001);
+  portions.add(250_g);
+  EXPECT_DOUBLE_EQ(portions.quantile(0.5).convertTo(uniTypes::gram), 250.0);
+  EXPECT_TRUE(uniTypes::QuantileSketch<uniTypes::Mass>().quantile(0.5) == 0_g);
+  EXPECT_THROW(uniTypes::QuantileSketch<uniTypes::Mass>(0.0), std::invalid_argument);
+  EXPECT_THROW(uniTypes::QuantileSketch<uniTypes::Mass>(1e-6), std::invalid_argument);
+  EXPECT_THROW(uniTypes::QuantileSketch<uniTypes::Mass>(1.5), std::invalid_argument);
+}
+
+TEST(quantileSketchTest, SignedValuesTest) {
+  uniTypes::QuantileSketch<uniTypes::Energy> sketch;
+  std::vector<double> raw;
+  for (int i = -500; i <= 500; ++i) {
+    sketch.add(uniTypes::Energy(i * 3.0));
+    raw.push_back(i * 3.0);
+  }
+  sketch.add(uniTypes::Energy(std::nan("")));
+  EXPECT_EQ(sketch.count(), raw.size());
+  for (double q : {0.0, 0.1, 0.4, 0.5, 0.6, 0.95, 1.0}) {
+    const double exact = exactQuantile(raw, q);
+    EXPECT_LE(std::fabs(sketch.quantile(q).getValue() - exact), 0.01 * std::fabs(exact))
+      << "q = " << q;
+  }
+  EXPECT_DOUBLE_EQ(sketch.sum().getValue(), 0.0);
+}
+
+TEST(quantileSketchTest, MergeTest) {
+  const uniTypes::QuantityVector<uniTypes::Time> latencies = sketchTestLatencies(300000);
+  uniTypes::QuantileSketch<uniTypes::Time> whole;
+  for (std::size_t i = 0; i < latencies.size(); ++i) {
+    whole.add(latencies[i]);
+  }
+
+  // Per-thread sketches merged afterwards, and the threaded batch insert, match one sketch.
+  uniTypes::QuantileSketch<uniTypes::Time> merged;
+  const std::size_t third = latencies.size() / 3;
+  for (std::size_t part = 0; part < 3; ++part) {
+    uniTypes::QuantileSketch<uniTypes::Time> partial;
+    partial.add(latencies.span().subspan(part * third, third));
+    merged.merge(partial);
+  }
+  uniTypes::QuantileSketch<uniTypes::Time> threaded;
+  threaded.add(latencies, 4);
+
+  for (const auto* sketch : {&merged, &threaded}) {
+    EXPECT_EQ(sketch->count(), whole.count());
+    EXPECT_TRUE(sketch->min() == whole.min());
+    EXPECT_TRUE(sketch->max() == whole.max());
+    for (double q : {0.0, 0.5, 0.99, 0.9999, 1.0}) {
+      EXPECT_TRUE(sketch->quantile(q) == whole.quantile(q)) << "q = " << q;
+    }
+  }
+
+  uniTypes::QuantileSketch<uniTypes::Time> coarse(0.05);
+  EXPECT_THROW(whole.merge(coarse), std::invalid_argument);
+}
+
+TEST(quantileSketchTest, SerializeTest) {
+  const uniTypes::QuantityVector<uniTypes::Time> latencies = sketchTestLatencies(10000);
+  uniTypes::QuantileSketch<uniTypes::Time> sketch;
+  sketch.add(latencies);
+  sketch.add(uniTypes::Time(-1.0));
+  sketch.add(0_s);
+
+  const std::string bytes = sketch.serialize();
+  EXPECT_EQ(bytes.size(), sketch.serializedSize());
+  EXPECT_LT(bytes.size(), 8 * latencies.size() / 4);
+  const auto copy = uniTypes::QuantileSketch<uniTypes::Time>::deserialize(bytes);
+  EXPECT_EQ(copy.count(), sketch.count());
+  EXPECT_TRUE(copy.sum() == sketch.sum());
+  for (double q : {0.0, 0.001, 0.5, 0.99, 1.0}) {
+    EXPECT_TRUE(copy.quantile(q) == sketch.quantile(q)) << "q = " << q;
+  }
+
+  // Snapshots from elsewhere merge like in-memory sketches.
+  uniTypes::QuantileSketch<uniTypes::Time> total;
+  total.merge(uniTypes::QuantileSketch<uniTypes::Time>::deserialize(bytes));
+  total.merge(copy);
+  EXPECT_EQ(total.count(), 2 * sketch.count());
+
+  EXPECT_THROW(uniTypes::QuantileSketch<uniTypes::Mass>::deserialize(bytes),
+               uniTypes::DimensionMismatch);
+  EXPECT_THROW(uniTypes::QuantileSketch<uniTypes::Time>::deserialize(bytes.substr(0, 100)),
+               std::invalid_argument);
+  EXPECT_THROW(uniTypes::QuantileSketch<uniTypes::Time>::deserialize("not a sketch"),
+               std::invalid_argument);
+  std::string corrupted = bytes;
+  corrupted[24] ^= 1;
+  EXPECT_THROW(uniTypes::QuantileSketch<uniTypes::Time>::deserialize(corrupted),
+               std::invalid_argument);
+}
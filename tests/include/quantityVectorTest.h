@@ -0,0 +1,76 @@
+#include <uniTypes/quantityVector.h>
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <stdexcept>
+
+// For using the string literal operators.
+using namespace uniTypes::string_literals;
+
+TEST(quantityVectorTest, StorageTest) {
+  uniTypes::QuantityVector<uniTypes::Mass> test_vec(1000, 2_kg);
+  static_assert(sizeof(uniTypes::QuantitySpan<uniTypes::Mass>) == 2 * sizeof(void*));
+
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(test_vec.data()) % uniTypes::kQuantityAlignment, 0u);
+  EXPECT_EQ(test_vec.size(), 1000u);
+  EXPECT_FLOAT_EQ(test_vec[999].convertTo(uniTypes::gram), 2000.0);
+
+  test_vec[3] = 5_lb;
+  test_vec[4] += 500_g;
+  EXPECT_FLOAT_EQ(test_vec[3].convertTo(uniTypes::pound), 5.0);
+  EXPECT_FLOAT_EQ(test_vec[4].convertTo(uniTypes::kilogram), 2.5);
+}
+
+TEST(quantityVectorTest, SpanTest) {
+  uniTypes::QuantityVector<uniTypes::Length> test_vec{1_m, 2_m, 3_m, 4_m};
+  uniTypes::QuantitySpan<uniTypes::Length> test_span = test_vec;
+  uniTypes::QuantitySpan<const uniTypes::Length> const_span = test_span.subspan(1, 2);
+
+  EXPECT_EQ(const_span.size(), 2u);
+  EXPECT_TRUE(const_span[0] == 2_m);
+  EXPECT_TRUE(const_span[1] == 3_m);
+  EXPECT_THROW(test_span.subspan(3, 2), std::out_of_range);
+}
+
+TEST(quantityVectorTest, AddSubtractTest) {
+  uniTypes::QuantityVector<uniTypes::Mass> lhs{1_kg, 2_kg, 3_kg};
+  uniTypes::QuantityVector<uniTypes::Mass> rhs{500_g, 250_g, 125_g};
+
+  uniTypes::QuantityVector<uniTypes::Mass> sum = lhs + rhs;
+  uniTypes::QuantityVector<uniTypes::Mass> difference = lhs - rhs;
+  EXPECT_FLOAT_EQ(sum[1].convertTo(uniTypes::gram), 2250.0);
+  EXPECT_FLOAT_EQ(difference[2].convertTo(uniTypes::gram), 2875.0);
+
+  lhs += rhs;
+  EXPECT_FLOAT_EQ(lhs[0].convertTo(uniTypes::gram), 1500.0);
+}
+
+TEST(quantityVectorTest, ScaleTest) {
+  uniTypes::QuantityVector<uniTypes::Volume> test_vec{1_cup, 2_cup};
+  uniTypes::QuantityVector<uniTypes::Volume> doubled = 2.0 * test_vec;
+  uniTypes::QuantityVector<uniTypes::Volume> halved = test_vec / 2.0;
+
+  EXPECT_FLOAT_EQ(doubled[1].convertTo(uniTypes::cup), 4.0);
+  EXPECT_FLOAT_EQ(halved[0].convertTo(uniTypes::cup), 0.5);
+}
+
+TEST(quantityVectorTest, MultiplyDivideTest) {
+  uniTypes::QuantityVector<uniTypes::Length> width{2_m, 3_m};
+  uniTypes::QuantityVector<uniTypes::Length> height{5_m, 7_m};
+
+  uniTypes::QuantityVector<uniTypes::Area> area = width * height;
+  EXPECT_FLOAT_EQ(area[1].convertTo(uniTypes::meter2), 21.0);
+
+  uniTypes::QuantityVector<uniTypes::Length> recovered(2);
+  uniTypes::divide(area, height, recovered);
+  EXPECT_FLOAT_EQ(recovered[0].convertTo(uniTypes::meter), 2.0);
+
+  uniTypes::QuantityVector<uniTypes::Number> ratio = width / height;
+  EXPECT_FLOAT_EQ(ratio[0].getValue(), 0.4);
+}
+
+TEST(quantityVectorTest, SizeMismatchTest) {
+  uniTypes::QuantityVector<uniTypes::Time> lhs(3);
+  uniTypes::QuantityVector<uniTypes::Time> rhs(4);
+  EXPECT_THROW(uniTypes::add(lhs, rhs, lhs), std::invalid_argument);
+}
@@ -0,0 +1,95 @@
+#include <uniTypes/reduce.h>
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+// For using the string literal operators.
+using namespace uniTypes::string_literals;
+
+TEST(reduceTest, SumMeanTest) {
+  uniTypes::QuantityVector<uniTypes::Energy> intake{500_kcal, 750_kcal, 1000_kcal};
+  static_assert(std::is_same<decltype(uniTypes::sum(intake)), uniTypes::Energy>::value);
+  EXPECT_FLOAT_EQ(uniTypes::sum(intake).convertTo(uniTypes::kilocalorie), 2250.0);
+  EXPECT_FLOAT_EQ(uniTypes::mean(intake.span()).convertTo(uniTypes::kilocalorie), 750.0);
+
+  uniTypes::QuantityVector<uniTypes::Energy> none;
+  EXPECT_EQ(uniTypes::sum(none).getValue(), 0.0);
+  EXPECT_THROW(uniTypes::mean(none), std::invalid_argument);
+}
+
+TEST(reduceTest, CompensatedSumTest) {
+  // 1 followed by many values that each vanish when added to 1 one at a time.
+  const std::size_t n = 1000000;
+  uniTypes::QuantityVector<uniTypes::Mass> masses(n + 1, uniTypes::Mass(1e-16));
+  masses[0] = uniTypes::Mass(1.0);
+
+  double naive = 0.0;
+  for (std::size_t i = 0; i < masses.size(); ++i) {
+    naive += masses[i].getValue();
+  }
+  EXPECT_EQ(naive, 1.0);
+  EXPECT_DOUBLE_EQ(uniTypes::sum(masses).getValue(), 1.0 + 1e-10);
+}
+
+TEST(reduceTest, DeterministicAcrossThreadsTest) {
+  const std::size_t n = 5 * uniTypes::kReduceGrain + 123;
+  uniTypes::QuantityVector<uniTypes::Time> times(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    const double x = static_cast<double>(i);
+    times[i] = uniTypes::Time(std::sin(x) * 1e3 + 1e-3 * x);
+  }
+  const double single = uniTypes::sum(times, 1).getValue();
+  const double variance = uniTypes::variance(times, false, 1).getValue();
+  for (unsigned threads : {2u, 3u, 8u, 0u}) {
+    EXPECT_EQ(uniTypes::sum(times, threads).getValue(), single);
+    EXPECT_EQ(uniTypes::variance(times, false, threads).getValue(), variance);
+  }
+}
+
+TEST(reduceTest, MinMaxTest) {
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  uniTypes::QuantityVector<uniTypes::Time> times{3_s, uniTypes::Time(nan), 1_min, 500_ms, 2_s};
+  EXPECT_FLOAT_EQ(uniTypes::min(times).convertTo(uniTypes::millisecond), 500.0);
+  EXPECT_FLOAT_EQ(uniTypes::max(times).convertTo(uniTypes::second), 60.0);
+
+  auto extremes = uniTypes::minMax(times.span().subspan(0, 1));
+  EXPECT_FLOAT_EQ(extremes.first.convertTo(uniTypes::second), 3.0);
+  EXPECT_FLOAT_EQ(extremes.second.convertTo(uniTypes::second), 3.0);
+
+  uniTypes::QuantityVector<uniTypes::Time> none;
+  EXPECT_THROW(uniTypes::max(none), std::invalid_argument);
+}
+
+TEST(reduceTest, VarianceTest) {
+  uniTypes::QuantityVector<uniTypes::Mass> masses{2_kg, 4_kg, 4_kg, 4_kg, 5_kg, 5_kg, 7_kg, 9_kg};
+  auto population = uniTypes::variance(masses);
+  static_assert(std::is_same<decltype(population),
+                             uniTypes::quantity_product_t<uniTypes::Mass, uniTypes::Mass>>::value);
+  EXPECT_DOUBLE_EQ(population.getValue(), 4.0);
+  EXPECT_DOUBLE_EQ(uniTypes::variance(masses, true).getValue(), 32.0 / 7.0);
+
+  // A large offset does not destroy the result as the textbook E[x^2] - E[x]^2 formula would.
+  uniTypes::QuantityVector<uniTypes::Mass> offset = masses + uniTypes::Mass(1e9);
+  EXPECT_NEAR(uniTypes::variance(offset).getValue(), 4.0, 1e-6);
+
+  EXPECT_THROW(uniTypes::variance(masses.span().subspan(0, 1), true), std::invalid_argument);
+}
+
+TEST(reduceTest, DotProductTest) {
+  uniTypes::QuantityVector<uniTypes::Force> forces{10_N, 20_N, 5_N};
+  uniTypes::QuantityVector<uniTypes::Length> distances{1_m, 50_cm, 2_m};
+
+  auto work = uniTypes::dot(forces, distances);
+  static_assert(std::is_same<decltype(work), uniTypes::Energy>::value);
+  EXPECT_FLOAT_EQ(work.convertTo(uniTypes::joule), 30.0);
+
+  // Reductions also consume expressions directly.
+  EXPECT_FLOAT_EQ(uniTypes::sum(forces * 2.0).convertTo(uniTypes::newton), 70.0);
+
+  uniTypes::QuantityVector<uniTypes::Length> short_distances{1_m};
+  EXPECT_THROW(uniTypes::dot(forces, short_distances), std::invalid_argument);
+}
@@ -0,0 +1,110 @@
+#include <uniTypes.h>
+#include <uniTypes/convert.h>
+#include <uniTypes/expression.h>
+#include <uniTypes/quantityVector.h>
+#include <uniTypes/reduce.h>
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+// For using the string literal operators.
+using namespace uniTypes::string_literals;
+
+using FloatMass = uniTypes::with_rep_t<uniTypes::Mass, float>;
+using FloatLength = uniTypes::with_rep_t<uniTypes::Length, float>;
+using IntMass = uniTypes::with_rep_t<uniTypes::Mass, std::int64_t>;
+using LongLength = uniTypes::with_rep_t<uniTypes::Length, long double>;
+
+TEST(repTest, RepTypeTest) {
+  static_assert(std::is_same<uniTypes::Mass::rep, double>::value);
+  static_assert(std::is_same<FloatMass::rep, float>::value);
+  static_assert(sizeof(FloatMass) == sizeof(float));
+  static_assert(sizeof(IntMass) == sizeof(std::int64_t));
+
+  // Floating-point reps convert implicitly in both directions; integer reps need an explicit cast.
+  static_assert(std::is_convertible<uniTypes::Mass, FloatMass>::value);
+  static_assert(std::is_convertible<FloatMass, uniTypes::Mass>::value);
+  static_assert(std::is_convertible<IntMass, uniTypes::Mass>::value);
+  static_assert(!std::is_convertible<uniTypes::Mass, IntMass>::value);
+  static_assert(std::is_constructible<IntMass, uniTypes::Mass>::value);
+  static_assert(!std::is_convertible<FloatMass, FloatLength>::value);
+
+  constexpr IntMass truncated(uniTypes::Mass(2.75));
+  static_assert(truncated.getValue() == 2);
+}
+
+TEST(repTest, MixedRepArithmeticTest) {
+  const FloatMass a(1.5f);
+  const uniTypes::Mass b(2.25);
+
+  // Mixed reps promote like the underlying arithmetic types.
+  static_assert(std::is_same<decltype(a + a), FloatMass>::value);
+  static_assert(std::is_same<decltype(a + b), uniTypes::Mass>::value);
+  static_assert(std::is_same<decltype(a * 2.0f), FloatMass>::value);
+  static_assert(std::is_same<decltype(a * 2.0), uniTypes::Mass>::value);
+  static_assert(std::is_same<decltype(a / b), double>::value);
+  static_assert(std::is_same<decltype(a * a),
+                             uniTypes::quantity_product_t<FloatMass, FloatMass>>::value);
+  static_assert(std::is_same<decltype(a * a)::rep, float>::value);
+  EXPECT_DOUBLE_EQ((a + b).getValue(), 3.75);
+  EXPECT_TRUE(a < b);
+  EXPECT_TRUE(FloatMass(2.25f) == b);
+
+  const IntMass c(7);
+  static_assert(std::is_same<decltype(c + c), IntMass>::value);
+  static_assert(std::is_same<decltype(c * 0.5), uniTypes::Mass>::value);
+  EXPECT_EQ((c + c).getValue(), 14);
+  EXPECT_EQ((c * 3).getValue(), 21);
+  EXPECT_EQ(c / IntMass(2), 3);
+
+  const LongLength d(1.0L);
+  static_assert(std::is_same<decltype(d + 1.0_m), LongLength>::value);
+  EXPECT_EQ((d + 1.0_m).getValue(), 2.0L);
+}
+
+TEST(repTest, FloatVectorTest) {
+  uniTypes::QuantityVector<FloatMass> masses{1.0_kg, 2.0_kg, 3.0_kg};
+  static_assert(std::is_same<decltype(masses.data()), float*>::value);
+
+  // Plain numbers take the rep of the range, so the expression stays in float.
+  auto doubled = masses * 2.0;
+  static_assert(std::is_same<decltype(doubled)::quantity_type, FloatMass>::value);
+  uniTypes::QuantityVector<FloatMass> result = doubled + masses;
+  EXPECT_FLOAT_EQ(result[2].getValue(), 9.0f);
+
+  // Float expressions may be stored in double ranges, but not the other way round.
+  uniTypes::QuantityVector<uniTypes::Mass> wide = masses - masses;
+  EXPECT_EQ(wide[1].getValue(), 0.0);
+
+  std::vector<float> grams(masses.size());
+  uniTypes::convertTo(masses, uniTypes::gram, grams.data());
+  EXPECT_FLOAT_EQ(grams[1], 2000.0f);
+
+  EXPECT_FLOAT_EQ(uniTypes::sum(masses).getValue(), 6.0f);
+  EXPECT_FLOAT_EQ(uniTypes::max(masses).getValue(), 3.0f);
+  static_assert(std::is_same<decltype(uniTypes::mean(masses)), FloatMass>::value);
+}
+
+TEST(repTest, IntegerVectorTest) {
+  const std::int64_t big = std::int64_t(1) << 53;
+  uniTypes::QuantityVector<IntMass> masses{IntMass(big), IntMass(1), IntMass(1), IntMass(-4)};
+
+  // Integer sums are exact, even where double would round.
+  EXPECT_EQ(uniTypes::sum(masses).getValue(), big - 2);
+  EXPECT_EQ(uniTypes::min(masses).getValue(), -4);
+  EXPECT_EQ(uniTypes::max(masses).getValue(), big);
+
+  // Means are returned in double.
+  uniTypes::QuantityVector<IntMass> small{IntMass(1), IntMass(2)};
+  static_assert(std::is_same<decltype(uniTypes::mean(small)), uniTypes::Mass>::value);
+  EXPECT_DOUBLE_EQ(uniTypes::mean(small).getValue(), 1.5);
+  EXPECT_DOUBLE_EQ(uniTypes::variance(small).getValue(), 0.25);
+
+  // Integer-valued scaling truncates.
+  std::vector<std::int64_t> grams{1500, 2999};
+  uniTypes::convert(grams.data(), grams.size(), uniTypes::gram, uniTypes::kilogram);
+  EXPECT_EQ(grams[0], 1);
+  EXPECT_EQ(grams[1], 2);
+}
@@ -0,0 +1,85 @@
+#include <uniTypes/scaledQuantity.h>
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <ratio>
+#include <type_traits>
+
+// For using the string literal operators.
+using namespace uniTypes::string_literals;
+
+using Pounds = uniTypes::ScaledQuantity<uniTypes::Mass, uniTypes::scales::pound, std::int64_t>;
+using Ounces = uniTypes::ScaledQuantity<uniTypes::Mass, uniTypes::scales::ounce, std::int64_t>;
+using Teaspoons =
+  uniTypes::ScaledQuantity<uniTypes::Volume, uniTypes::scales::teaspoon, std::int64_t>;
+using Cups = uniTypes::ScaledQuantity<uniTypes::Volume, uniTypes::scales::cup, std::int64_t>;
+
+TEST(scaledQuantityTest, ValueTypeTest) {
+  static_assert(sizeof(uniTypes::Milligrams) == sizeof(std::int64_t));
+  static_assert(uniTypes::Grams(1500).count() == 1500);
+  static_assert(std::is_same<uniTypes::Grams::scale, std::milli>::value);
+  // Lossy conversions are not implicit.
+  static_assert(std::is_convertible<uniTypes::Grams, uniTypes::Milligrams>::value);
+  static_assert(!std::is_convertible<uniTypes::Milligrams, uniTypes::Grams>::value);
+  static_assert(!std::is_constructible<uniTypes::Grams, double>::value);
+}
+
+TEST(scaledQuantityTest, ExactConversionTest) {
+  // Whole multiples convert implicitly and exactly at compile time.
+  constexpr uniTypes::Milligrams milligrams = uniTypes::Grams(3);
+  static_assert(milligrams.count() == 3000);
+  constexpr Ounces ounces = Pounds(5);
+  static_assert(ounces.count() == 80);
+  constexpr Teaspoons teaspoons = Cups(2);
+  static_assert(teaspoons.count() == 96);
+
+  // Coarser integer scales need quantityCast, which truncates toward zero.
+  EXPECT_EQ(uniTypes::quantityCast<uniTypes::Grams>(uniTypes::Milligrams(2999)).count(), 2);
+  EXPECT_EQ(uniTypes::quantityCast<uniTypes::Grams>(uniTypes::Milligrams(-2999)).count(), -2);
+  EXPECT_EQ(uniTypes::quantityCast<uniTypes::Seconds>(uniTypes::Milliseconds(90500)).count(), 90);
+}
+
+TEST(scaledQuantityTest, RatioQuantityInteropTest) {
+  const uniTypes::Mass mass = Pounds(2);
+  EXPECT_DOUBLE_EQ(mass.convertTo(uniTypes::pound), 2.0);
+  EXPECT_DOUBLE_EQ(mass.convertTo(uniTypes::kilogram), 0.90718474);
+
+  EXPECT_EQ(uniTypes::quantityCast<uniTypes::Grams>(2.5_kg).count(), 2500);
+  EXPECT_EQ(uniTypes::quantityCast<Teaspoons>(uniTypes::tablespoon).count(), 3);
+
+  using FloatCups = uniTypes::ScaledQuantity<uniTypes::Volume, uniTypes::scales::cup, double>;
+  const FloatCups cups = Teaspoons(24);
+  EXPECT_DOUBLE_EQ(cups.count(), 0.5);
+}
+
+TEST(scaledQuantityTest, MixedScaleArithmeticTest) {
+  // Adding pounds and ounces happens in ounces, exactly.
+  auto total = Pounds(1) + Ounces(3);
+  static_assert(std::is_same<decltype(total), Ounces>::value);
+  EXPECT_EQ(total.count(), 19);
+  EXPECT_TRUE(Pounds(1) == Ounces(16));
+  EXPECT_TRUE(Ounces(15) < Pounds(1));
+  EXPECT_TRUE(uniTypes::Grams(1) >= uniTypes::Milligrams(1000));
+
+  auto grams_and_pounds = uniTypes::Grams(1) + Pounds(1);
+  EXPECT_EQ(uniTypes::quantityCast<uniTypes::Milligrams>(grams_and_pounds).count(), 454592);
+
+  EXPECT_EQ((uniTypes::Grams(10) * 3).count(), 30);
+  EXPECT_EQ((uniTypes::Grams(10) / 4).count(), 2);
+  EXPECT_EQ(Pounds(3) / Ounces(8), 6);
+
+  uniTypes::Milliliters volume(250);
+  volume += uniTypes::Milliliters(750);
+  volume -= uniTypes::Milliliters(100);
+  EXPECT_EQ(volume.count(), 900);
+  EXPECT_EQ((-volume).count(), -900);
+}
+
+TEST(scaledQuantityTest, DimensionArithmeticTest) {
+  using Meters = uniTypes::ScaledQuantity<uniTypes::Length, std::ratio<1>, std::int64_t>;
+  auto area = uniTypes::Millimeters(20) * Meters(3);
+  static_assert(std::is_same<decltype(area)::quantity_type, uniTypes::Area>::value);
+  static_assert(std::is_same<decltype(area)::scale, std::milli>::value);
+  EXPECT_EQ(area.count(), 60);
+  EXPECT_DOUBLE_EQ(static_cast<uniTypes::Area>(area).convertTo(uniTypes::centimeter2), 600.0);
+}
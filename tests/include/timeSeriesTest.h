@@ -0,0 +1,188 @@
+#include <uniTypes/timeSeries.h>
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+// For using the string literal operators.
+using namespace uniTypes::string_literals;
+
+TEST(timeSeriesTest, AppendAndLookupTest) {
+  uniTypes::TimeSeries<uniTypes::Mass> weights;
+  weights.append(0_s, 70_kg);
+  weights.append(60_s, 70.5_kg);
+  weights.append(60_s, 70.25_kg);
+  EXPECT_THROW(weights.append(30_s, 71_kg), std::invalid_argument);
+  EXPECT_EQ(weights.size(), 3u);
+
+  const uniTypes::QuantityVector<uniTypes::Time> times{120_s, 180_s, 240_s};
+  const uniTypes::QuantityVector<uniTypes::Mass> values{71_kg, 71.5_kg, 72_kg};
+  weights.append(times, values);
+  EXPECT_EQ(weights.size(), 6u);
+  EXPECT_TRUE(weights.value(5) == 72_kg);
+
+  // Batches are checked as a whole before anything is appended.
+  const uniTypes::QuantityVector<uniTypes::Time> unordered{300_s, 290_s};
+  const uniTypes::QuantityVector<uniTypes::Mass> two{1_kg, 2_kg};
+  EXPECT_THROW(weights.append(unordered, two), std::invalid_argument);
+  EXPECT_THROW(weights.append(times, two), std::invalid_argument);
+  const uniTypes::QuantityVector<uniTypes::Time> unbounded{
+    400_s, uniTypes::Time(std::numeric_limits<double>::infinity())};
+  EXPECT_THROW(weights.append(unbounded, two), std::invalid_argument);
+  EXPECT_THROW(weights.append(uniTypes::Time(std::nan("")), 1_kg), std::invalid_argument);
+  EXPECT_THROW(weights.append(uniTypes::Time(std::numeric_limits<double>::infinity()), 1_kg),
+               std::invalid_argument);
+  EXPECT_EQ(weights.size(), 6u);
+
+  EXPECT_EQ(weights.lowerBound(60_s), 1u);
+  EXPECT_EQ(weights.upperBound(60_s), 3u);
+  EXPECT_EQ(weights.lowerBound(1000_s), 6u);
+  const uniTypes::TimeSeriesSlice<uniTypes::Mass> minutes = weights.slice(60_s, 180_s);
+  EXPECT_EQ(minutes.offset, 1u);
+  EXPECT_EQ(minutes.size(), 3u);
+  EXPECT_TRUE(minutes.values[2] == 71_kg);
+  EXPECT_TRUE(weights.slice(500_s, 600_s).empty());
+  EXPECT_TRUE(weights.slice(180_s, 60_s).empty());
+}
+
+TEST(timeSeriesTest, InterpolateTest) {
+  uniTypes::TimeSeries<uniTypes::Energy> intake;
+  EXPECT_THROW(intake.interpolate(0_s), std::out_of_range);
+  intake.append(10_s, 100_J);
+  EXPECT_TRUE(intake.interpolate(0_s) == 100_J);
+  intake.append(20_s, 200_J);
+  intake.append(20_s, 500_J);
+  intake.append(40_s, 300_J);
+
+  EXPECT_DOUBLE_EQ(intake.interpolate(15_s).getValue(), 150.0);
+  EXPECT_DOUBLE_EQ(intake.interpolate(30_s).getValue(), 400.0);
+  // Outside the series the end values hold; at a repeated time the later sample wins.
+  EXPECT_DOUBLE_EQ(intake.interpolate(0_s).getValue(), 100.0);
+  EXPECT_DOUBLE_EQ(intake.interpolate(50_s).getValue(), 300.0);
+  EXPECT_DOUBLE_EQ(intake.interpolate(20_s).getValue(), 500.0);
+
+  // Batches in any order match one query at a time.
+  std::mt19937 generator(5);
+  std::uniform_real_distribution<double> when(0.0, 50.0);
+  uniTypes::QuantityVector<uniTypes::Time> queries;
+  for (int i = 0; i < 1000; ++i) {
+    queries.push_back(uniTypes::Time(when(generator)));
+  }
+  uniTypes::QuantityVector<uniTypes::Time> sorted = queries;
+  std::sort(sorted.data(), sorted.data() + sorted.size());
+  for (const auto* batch : {&queries, &sorted}) {
+    uniTypes::QuantityVector<uniTypes::Energy> out(batch->size());
+    intake.interpolate(*batch, out);
+    for (std::size_t i = 0; i < batch->size(); ++i) {
+      EXPECT_DOUBLE_EQ(out[i].getValue(), intake.interpolate((*batch)[i]).getValue());
+    }
+  }
+  // A NaN query does not throw off the queries after it.
+  const uniTypes::QuantityVector<uniTypes::Time> with_nan{15_s, uniTypes::Time(std::nan("")),
+                                                          12_s, 30_s};
+  uniTypes::QuantityVector<uniTypes::Energy> nan_out(with_nan.size());
+  intake.interpolate(with_nan, nan_out);
+  EXPECT_DOUBLE_EQ(nan_out[0].getValue(), 150.0);
+  EXPECT_TRUE(std::isnan(nan_out[1].getValue()));
+  EXPECT_DOUBLE_EQ(nan_out[2].getValue(), 120.0);
+  EXPECT_DOUBLE_EQ(nan_out[3].getValue(), 400.0);
+
+  // Galloping agrees with std::upper_bound from any hint, repeated values included.
+  const std::vector<double> steps{1, 2, 2, 2, 3, 5, 5, 8, 13, 13, 13, 13, 21};
+  for (double value = 0.0; value < 23.0; value += 0.5) {
+    const std::size_t expected = static_cast<std::size_t>(
+      std::upper_bound(steps.begin(), steps.end(), value) - steps.begin());
+    for (std::size_t hint = 0; hint <= expected; ++hint) {
+      EXPECT_EQ(uniTypes::detail::gallopUpperBound(steps.data(), steps.size(), hint, value),
+                expected);
+    }
+  }
+
+  uniTypes::QuantityVector<uniTypes::Energy> short_out(3);
+  EXPECT_THROW(intake.interpolate(queries, short_out), std::invalid_argument);
+}
+
+TEST(timeSeriesTest, ResampleTest) {
+  uniTypes::TimeSeries<uniTypes::Mass> portions;
+  portions.append(0_s, 100_g);
+  portions.append(30_s, 200_g);
+  portions.append(59_s, 300_g);
+  portions.append(60_s, 50_g);
+  portions.append(200_s, 10_g);
+
+  const uniTypes::TimeSeries<uniTypes::Mass> sums =
+    portions.resample(60_s, uniTypes::Aggregation::Sum);
+  ASSERT_EQ(sums.size(), 3u);
+  EXPECT_TRUE(sums.time(0) == 0_s && sums.time(1) == 60_s && sums.time(2) == 180_s);
+  EXPECT_DOUBLE_EQ(sums.value(0).convertTo(uniTypes::gram), 600.0);
+  EXPECT_DOUBLE_EQ(sums.value(1).convertTo(uniTypes::gram), 50.0);
+
+  const auto means = portions.resample(60_s, uniTypes::Aggregation::Mean);
+  EXPECT_DOUBLE_EQ(means.value(0).convertTo(uniTypes::gram), 200.0);
+  const auto lasts = portions.resample(60_s, uniTypes::Aggregation::Last);
+  EXPECT_TRUE(lasts.value(0) == 300_g);
+  EXPECT_TRUE(lasts.value(2) == 10_g);
+
+  // Intervals are aligned to the origin.
+  const auto shifted = portions.resample(60_s, uniTypes::Aggregation::Sum, 30_s);
+  ASSERT_EQ(shifted.size(), 3u);
+  EXPECT_DOUBLE_EQ(shifted.time(0).getValue(), -30.0);
+  EXPECT_DOUBLE_EQ(shifted.value(1).convertTo(uniTypes::gram), 550.0);
+
+  EXPECT_THROW(portions.resample(0_s, uniTypes::Aggregation::Sum), std::invalid_argument);
+  EXPECT_THROW(portions.resample(uniTypes::Time(std::numeric_limits<double>::infinity()),
+                                 uniTypes::Aggregation::Sum),
+               std::invalid_argument);
+
+  // Intervals too fine to tell apart at the sample times are rejected rather than looped over.
+  uniTypes::TimeSeries<uniTypes::Mass> far;
+  far.append(uniTypes::Time(1.6e18), 1_g);
+  EXPECT_THROW(far.resample(1_s, uniTypes::Aggregation::Sum, 0.5_s), std::invalid_argument);
+  EXPECT_EQ(far.resample(1e9_s, uniTypes::Aggregation::Sum).size(), 1u);
+  EXPECT_TRUE(uniTypes::TimeSeries<uniTypes::Mass>().resample(1_s,
+                                                             uniTypes::Aggregation::Mean).empty());
+}
+
+TEST(timeSeriesTest, WindowTest) {
+  uniTypes::TimeSeries<uniTypes::Mass> readings;
+  uniTypes::TimeWindow<uniTypes::Mass> window(readings, 10_s);
+  EXPECT_TRUE(window.empty());
+  EXPECT_THROW(window.mean(), std::invalid_argument);
+  EXPECT_THROW(uniTypes::TimeWindow<uniTypes::Mass>(readings, 0_s), std::invalid_argument);
+
+  std::mt19937 generator(9);
+  std::uniform_real_distribution<double> gap(0.0, 3.0);
+  std::uniform_real_distribution<double> mass(-5.0, 5.0);
+  double now = 0.0;
+  for (int step = 0; step < 500; ++step) {
+    // A few samples at a time, then the window catches up.
+    for (int i = 0; i < 3; ++i) {
+      now += gap(generator);
+      readings.append(uniTypes::Time(now), uniTypes::Mass(mass(generator)));
+    }
+    window.update();
+
+    double sum = 0.0;
+    double lo = 1e300;
+    double hi = -1e300;
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < readings.size(); ++i) {
+      if (readings.time(i).getValue() > now - 10.0) {
+        sum += readings.value(i).getValue();
+        lo = std::min(lo, readings.value(i).getValue());
+        hi = std::max(hi, readings.value(i).getValue());
+        ++count;
+      }
+    }
+    ASSERT_EQ(window.count(), count);
+    EXPECT_NEAR(window.sum().getValue(), sum, 1e-9);
+    EXPECT_NEAR(window.mean().getValue(), sum / count, 1e-9);
+    EXPECT_EQ(window.min().getValue(), lo);
+    EXPECT_EQ(window.max().getValue(), hi);
+  }
+}
@@ -1,9 +1,13 @@
 #include <uniTypes.h>
+#include <uniTypes/dynQuantity.h>
 #include "gtest/gtest.h"
 
 #include <iostream>
 #include <string>
 #include <map>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
 
 // For using the string literal operators.
 using namespace uniTypes::string_literals;
@@ -58,74 +62,105 @@ TEST(uniTypesTest, IUInitTest) {
 }
 
 TEST(uniTypesTest, FactoryNumberInitTest) {
-  uniTypes::RatioBase* test_var = uniTypes::RatioBase::createRatio(1, 12.5);
+  uniTypes::DynQuantity test_var = uniTypes::DynQuantity::createRatio(1, 12.5);
   uniTypes::Number truth_var = 12.5;
-  EXPECT_FLOAT_EQ(test_var->convertTo(uniTypes::kilogram), truth_var.convertTo(uniTypes::kilogram));
+  uniTypes::Number one = 1.0;
+  EXPECT_FLOAT_EQ(test_var.convertTo(one), truth_var.convertTo(one));
 }
 
 TEST(uniTypesTest, FactoryUOBAInitTest) {
-  uniTypes::RatioBase* test_var = uniTypes::RatioBase::createRatio(2, 100.01);
+  uniTypes::DynQuantity test_var = uniTypes::DynQuantity::createRatio(2, 100.01);
   uniTypes::UOBA truth_var = 100.01_IU;
-  EXPECT_FLOAT_EQ(test_var->convertTo(uniTypes::IU), truth_var.convertTo(uniTypes::IU));
+  EXPECT_FLOAT_EQ(test_var.convertTo(uniTypes::IU), truth_var.convertTo(uniTypes::IU));
 }
 
 TEST(uniTypesTest, FactoryMassInitTest) {
-  uniTypes::RatioBase* test_var = uniTypes::RatioBase::createRatio(3, 12.5);
+  uniTypes::DynQuantity test_var = uniTypes::DynQuantity::createRatio(3, 12.5);
   uniTypes::Mass truth_var = 12.5_kg;
-  EXPECT_FLOAT_EQ(test_var->convertTo(uniTypes::kilogram), truth_var.convertTo(uniTypes::kilogram));
+  EXPECT_FLOAT_EQ(test_var.convertTo(uniTypes::kilogram), truth_var.convertTo(uniTypes::kilogram));
 }
 
 TEST(uniTypesTest, FactoryLengthInitTest) {
-  uniTypes::RatioBase* test_var = uniTypes::RatioBase::createRatio(4, 10.0);
+  uniTypes::DynQuantity test_var = uniTypes::DynQuantity::createRatio(4, 10.0);
   uniTypes::Length truth_var = 10.0_m;
-  EXPECT_FLOAT_EQ(test_var->convertTo(uniTypes::meter), truth_var.convertTo(uniTypes::meter));
+  EXPECT_FLOAT_EQ(test_var.convertTo(uniTypes::meter), truth_var.convertTo(uniTypes::meter));
 }
 
 TEST(uniTypesTest, FactoryAreaInitTest) {
-  uniTypes::RatioBase* test_var = uniTypes::RatioBase::createRatio(5, 30.0);
+  uniTypes::DynQuantity test_var = uniTypes::DynQuantity::createRatio(5, 30.0);
   uniTypes::Area truth_var = 30.0 * uniTypes::meter2;
-  EXPECT_FLOAT_EQ(test_var->convertTo(uniTypes::meter2), truth_var.convertTo(uniTypes::meter2));
+  EXPECT_FLOAT_EQ(test_var.convertTo(uniTypes::meter2), truth_var.convertTo(uniTypes::meter2));
 }
 
 TEST(uniTypesTest, FactoryVolumeInitTest) {
-  uniTypes::RatioBase* test_var = uniTypes::RatioBase::createRatio(6, 0.005);
+  uniTypes::DynQuantity test_var = uniTypes::DynQuantity::createRatio(6, 0.005);
   uniTypes::Volume truth_var = 0.005 * uniTypes::meter3;
-  EXPECT_FLOAT_EQ(test_var->convertTo(uniTypes::meter3), truth_var.convertTo(uniTypes::meter3));
+  EXPECT_FLOAT_EQ(test_var.convertTo(uniTypes::meter3), truth_var.convertTo(uniTypes::meter3));
 }
 
 TEST(uniTypesTest, FactoryTimeInitTest) {
-  uniTypes::RatioBase* test_var = uniTypes::RatioBase::createRatio(7, 13.7);
+  uniTypes::DynQuantity test_var = uniTypes::DynQuantity::createRatio(7, 13.7);
   uniTypes::Time truth_var = 13.7_s;
-  EXPECT_FLOAT_EQ(test_var->convertTo(uniTypes::second), truth_var.convertTo(uniTypes::second));
+  EXPECT_FLOAT_EQ(test_var.convertTo(uniTypes::second), truth_var.convertTo(uniTypes::second));
 }
 
 TEST(uniTypesTest, FactoryForceInitTest) {
-  uniTypes::RatioBase* test_var = uniTypes::RatioBase::createRatio(8, 9.81);
+  uniTypes::DynQuantity test_var = uniTypes::DynQuantity::createRatio(8, 9.81);
   uniTypes::Force truth_var = 9.81_N;
-  EXPECT_FLOAT_EQ(test_var->convertTo(uniTypes::newton), truth_var.convertTo(uniTypes::newton));
+  EXPECT_FLOAT_EQ(test_var.convertTo(uniTypes::newton), truth_var.convertTo(uniTypes::newton));
 }
 
 TEST(uniTypesTest, FactoryEnergyInitTest) {
-  uniTypes::RatioBase* test_var = uniTypes::RatioBase::createRatio(9, 4.18);
+  uniTypes::DynQuantity test_var = uniTypes::DynQuantity::createRatio(9, 4.18);
   uniTypes::Energy truth_var = 4.18_J;
-  EXPECT_FLOAT_EQ(test_var->convertTo(uniTypes::joule), truth_var.convertTo(uniTypes::joule));
+  EXPECT_FLOAT_EQ(test_var.convertTo(uniTypes::joule), truth_var.convertTo(uniTypes::joule));
 }
 
 TEST(uniTypesTest, MapStorageTest) {
-  std::map<std::string, uniTypes::RatioBase*> unit_map;
+  std::map<std::string, uniTypes::DynQuantity> unit_map;
   
-  unit_map["mass"] = new uniTypes::Mass(13.5_g);
-  unit_map["time"] = new uniTypes::Time(60.0_s);
+  unit_map["mass"] = 13.5_g;
+  unit_map["time"] = 60.0_s;
   
   uniTypes::Mass mass_truth = 13.5_g;
   uniTypes::Time time_truth = 60.0_s;
   
-  EXPECT_FLOAT_EQ(unit_map.at("mass")->convertTo(uniTypes::kilogram), mass_truth.convertTo(uniTypes::kilogram));
-  EXPECT_FLOAT_EQ(unit_map.at("time")->convertTo(uniTypes::second), time_truth.convertTo(uniTypes::second));
+  EXPECT_FLOAT_EQ(unit_map.at("mass").convertTo(uniTypes::kilogram), mass_truth.convertTo(uniTypes::kilogram));
+  EXPECT_FLOAT_EQ(unit_map.at("time").convertTo(uniTypes::second), time_truth.convertTo(uniTypes::second));
+}
+
+TEST(uniTypesTest, FactoryInvalidChoiceTest) {
+  EXPECT_THROW(uniTypes::DynQuantity::createRatio(0, 1.0), std::invalid_argument);
+  EXPECT_THROW(uniTypes::DynQuantity::createRatio(10, 1.0), std::invalid_argument);
+}
+
+TEST(uniTypesTest, ValueTypeTest) {
+  static_assert(sizeof(uniTypes::Length) == sizeof(double));
+  static_assert(std::is_trivially_copyable_v<uniTypes::Energy>);
+  static_assert(!std::is_polymorphic_v<uniTypes::Mass>);
 
-  for (auto &it : unit_map) {
-    delete it.second;
-  }
+  constexpr uniTypes::Length constexpr_var = uniTypes::Length(2.0) * 3.0 + uniTypes::Length(1.0);
+  static_assert(constexpr_var.getValue() == 7.0);
+  static_assert(constexpr_var > uniTypes::Length(6.0));
+
+  double raw_values[2] = {1.5, 2.5};
+  uniTypes::Mass test_vars[2];
+  std::memcpy(test_vars, raw_values, sizeof(raw_values));
+  EXPECT_FLOAT_EQ(test_vars[1].getValue(), 2.5);
+}
+
+TEST(uniTypesTest, ConstexprUnitAndLiteralTest) {
+  // Every unit constant and literal is a constant expression, so these fold at compile time.
+  static_assert(uniTypes::kilogram.getValue() == 1.0);
+  static_assert((12.5_lb).getValue() == 12.5 * (16 * (0.028349523125 * 1.0)));
+  static_assert(12_in == 1_ft);
+  static_assert(3_ft == 1_yd);
+  static_assert(1_kcal == 4184_J);
+  static_assert((2_hr).convertTo(uniTypes::minute) == 120.0);
+  static_assert(uniTypes::meter2 == uniTypes::meter * uniTypes::meter);
+
+  constexpr uniTypes::Volume folded_var = 3_tbsp;
+  EXPECT_FLOAT_EQ(folded_var.convertTo(uniTypes::teaspoon), 9.0);
 }
 
 TEST(uniTypesTest, AdditionTest) {
@@ -166,6 +201,11 @@ TEST(uniTypesTest, DoubleMultiplicationReflexiveTest) {
   EXPECT_FLOAT_EQ(test_var.convertTo(uniTypes::inch2), truth_var.convertTo(uniTypes::inch2));
 }
 
+TEST(uniTypesTest, WorkIsEnergyTest) {
+  uniTypes::Energy test_var = 10_N * 3_m;
+  EXPECT_FLOAT_EQ(test_var.convertTo(uniTypes::joule), 30.0);
+}
+
 TEST(uniTypesTest, DivisionTest) {
   uniTypes::Volume test_var_1 = 100.0 * uniTypes::meter3;
   uniTypes::Length test_var_2 = 50.0_m;
@@ -217,4 +257,16 @@ TEST(uniTypesTypeMapTest, TypeMapLengthTest) {
   uniTypes::Length test_var = 87.75 * test_unit;
 
   EXPECT_FLOAT_EQ(test_var.convertTo(uniTypes::foot), truth_var.convertTo(uniTypes::foot));
-}
\ No newline at end of file
+}
+
+TEST(uniTypesTypeMapTest, TypeMapStaticDataTest) {
+  // The tables are constant-initialized, so they cost no allocation or code at startup.
+  static_assert(uniTypes::string_to_mass_unit.at("lb") == uniTypes::pound);
+  static_assert(uniTypes::string_to_volume_unit.count("fl") == 1);
+  static_assert(uniTypes::string_to_length_unit.size() == 18);
+
+  const std::string key = "tbsp";
+  EXPECT_TRUE(uniTypes::string_to_volume_unit.at(key) == uniTypes::tablespoon);
+  EXPECT_TRUE(uniTypes::string_to_mass_unit.find("stone") == uniTypes::string_to_mass_unit.end());
+  EXPECT_THROW(uniTypes::string_to_length_unit.at("furlong"), std::out_of_range);
+}
@@ -0,0 +1,156 @@
+#include <uniTypes/unitExpression.h>
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(unitExpressionTest, CompileTest) {
+  using Speed = uniTypes::quantity_quotient_t<uniTypes::Length, uniTypes::Time>;
+  using Density = uniTypes::quantity_quotient_t<uniTypes::Mass, uniTypes::Volume>;
+
+  const uniTypes::DynQuantity newton = uniTypes::compileUnit("kg*m/s^2");
+  EXPECT_TRUE(newton.is<uniTypes::Force>());
+  EXPECT_DOUBLE_EQ(newton.getValue(), 1.0);
+
+  const uniTypes::DynQuantity kcal_per_day = uniTypes::compileUnit("kcal/day");
+  EXPECT_TRUE(kcal_per_day.getDimension() == uniTypes::Dimension(1, 2, -3));
+  EXPECT_DOUBLE_EQ(kcal_per_day.getValue(), 4184.0 / 86400.0);
+
+  EXPECT_TRUE(uniTypes::compileUnit("mg/ml").is<Density>());
+  EXPECT_DOUBLE_EQ(uniTypes::compileUnit("mg/ml").getValue(), 1.0);
+  EXPECT_DOUBLE_EQ(uniTypes::compileUnit("km / h").getValue(), 1000.0 / 3600.0);
+  EXPECT_TRUE(uniTypes::compileUnit("km / h").is<Speed>());
+
+  // Left to right, with parentheses and the alternative product signs.
+  EXPECT_TRUE(uniTypes::compileUnit("J/kg*K").getDimension() == uniTypes::Dimension(0, 2, -2, 1));
+  EXPECT_TRUE(uniTypes::compileUnit("J/(kg*K)").getDimension() ==
+              uniTypes::Dimension(0, 2, -2, -1));
+  EXPECT_TRUE(uniTypes::compileUnit("N.m").is<uniTypes::Energy>());
+  EXPECT_TRUE(uniTypes::compileUnit("N\xC2\xB7m").is<uniTypes::Energy>());
+  EXPECT_TRUE(uniTypes::compileUnit("1/s").getDimension() == uniTypes::Dimension(0, 0, -1));
+  EXPECT_DOUBLE_EQ(uniTypes::compileUnit("1000*g").getValue(), 1.0);
+
+  // Single table names, including ones with spaces and hyphens.
+  EXPECT_DOUBLE_EQ(uniTypes::compileUnit(" fl oz ").getValue(), uniTypes::floz.getValue());
+  EXPECT_DOUBLE_EQ(uniTypes::compileUnit("pound-force/in2").getValue(),
+                   uniTypes::poundforce.getValue() / uniTypes::inch2.getValue());
+}
+
+TEST(unitExpressionTest, PrefixAndPowerTest) {
+  EXPECT_DOUBLE_EQ(uniTypes::compileUnit("mmol/L").getValue(), 1.0);
+  EXPECT_DOUBLE_EQ(uniTypes::compileUnit("mg/dL").getValue(), 1e-6 / 1e-4);
+  EXPECT_DOUBLE_EQ(uniTypes::compileUnit("ug").getValue(), 1e-9);
+  EXPECT_DOUBLE_EQ(uniTypes::compileUnit("\xC2\xB5g").getValue(), 1e-9);
+  EXPECT_DOUBLE_EQ(uniTypes::compileUnit("mcg").getValue(), 1e-9);
+  EXPECT_DOUBLE_EQ(uniTypes::compileUnit("dam").getValue(), 10.0);
+  EXPECT_DOUBLE_EQ(uniTypes::compileUnit("mIU/mL").getValue(), 1e-3 / 1e-6);
+  EXPECT_TRUE(uniTypes::compileUnit("mIU/mL").getDimension() ==
+              uniTypes::Dimension(0, -3, 0, 0, 0, 0, 0, 1));
+  // Prefixes only apply to SI symbols, and table names win over prefixed ones.
+  EXPECT_THROW(uniTypes::compileUnit("kin"), std::out_of_range);
+  EXPECT_DOUBLE_EQ(uniTypes::compileUnit("min").getValue(), 60.0);
+  EXPECT_DOUBLE_EQ(uniTypes::compileUnit("mi").getValue(), uniTypes::mile.getValue());
+
+  EXPECT_TRUE(uniTypes::compileUnit("m/s2").getDimension() == uniTypes::Dimension(0, 1, -2));
+  EXPECT_TRUE(uniTypes::compileUnit("s^-1").getDimension() == uniTypes::Dimension(0, 0, -1));
+  EXPECT_DOUBLE_EQ(uniTypes::compileUnit("cm^3").getValue(), 1e-6);
+  EXPECT_DOUBLE_EQ(uniTypes::compileUnit("(km/h)^2").getValue(),
+                   (1000.0 / 3600.0) * (1000.0 / 3600.0));
+
+  const uniTypes::DynQuantity root_hz = uniTypes::compileUnit("s^(-1/2)");
+  EXPECT_DOUBLE_EQ(root_hz.getDimension().exponent(uniTypes::BaseDimension::Time), -0.5);
+  using LengthToThreeHalves = uniTypes::dims_pow_t<uniTypes::Length::dims, 3, 2>;
+  EXPECT_TRUE(uniTypes::compileUnit("m^(3/2)").getDimension() ==
+              uniTypes::Dimension::fromDims<LengthToThreeHalves>());
+  EXPECT_DOUBLE_EQ(uniTypes::compileUnit("(cm^4)^(1/2)").getValue(), 1e-4);
+}
+
+TEST(unitExpressionTest, ErrorTest) {
+  EXPECT_THROW(uniTypes::compileUnit(""), std::invalid_argument);
+  EXPECT_THROW(uniTypes::compileUnit("kg*"), std::invalid_argument);
+  EXPECT_THROW(uniTypes::compileUnit("kg m"), std::invalid_argument);
+  EXPECT_THROW(uniTypes::compileUnit("(kg/m"), std::invalid_argument);
+  EXPECT_THROW(uniTypes::compileUnit("m^"), std::invalid_argument);
+  EXPECT_THROW(uniTypes::compileUnit("m^(1/0)"), std::invalid_argument);
+  // Exponents are stored in sixths.
+  EXPECT_THROW(uniTypes::compileUnit("m^(1/4)"), std::invalid_argument);
+  // Exponents take at most one sign, and denominators none.
+  EXPECT_THROW(uniTypes::compileUnit("m^--1"), std::invalid_argument);
+  EXPECT_THROW(uniTypes::compileUnit("m^-+1"), std::invalid_argument);
+  EXPECT_THROW(uniTypes::compileUnit("m^(2/-1)"), std::invalid_argument);
+  // Units must have a positive finite value.
+  EXPECT_THROW(uniTypes::compileUnit("m/0"), std::invalid_argument);
+  EXPECT_THROW(uniTypes::compileUnit("0*kg"), std::invalid_argument);
+  EXPECT_THROW(uniTypes::compileUnit("1e300*1e300*m"), std::invalid_argument);
+  EXPECT_THROW(uniTypes::parseUnit<uniTypes::Length>("m/0"), std::invalid_argument);
+  EXPECT_THROW(uniTypes::compileUnit("furlong/fortnight"), std::out_of_range);
+  EXPECT_THROW(uniTypes::compileUnit(std::string(100, '(') + "m" + std::string(100, ')')),
+               std::invalid_argument);
+
+  EXPECT_THROW(uniTypes::Dimension(0, 1, 0).pow(1, 4), std::invalid_argument);
+  EXPECT_TRUE(uniTypes::Dimension(1, 2, -2).pow(-2) == uniTypes::Dimension(-2, -4, 4));
+
+  // Huge exponents overflow the exponent range instead of wrapping around.
+  EXPECT_THROW(uniTypes::compileUnit("m^999999999"), std::overflow_error);
+  EXPECT_THROW(uniTypes::compileUnit("s^-2147483647"), std::overflow_error);
+  EXPECT_THROW(uniTypes::compileUnit("(m^2)^2147483647"), std::overflow_error);
+  EXPECT_TRUE(uniTypes::compileUnit("m^(999999999/999999999)").getDimension() ==
+              uniTypes::Dimension(0, 1, 0));
+}
+
+TEST(unitExpressionTest, StaticCheckTest) {
+  const uniTypes::Force force = 3.0 * uniTypes::parseUnit<uniTypes::Force>("kg*m/s^2");
+  EXPECT_DOUBLE_EQ(force.convertTo(uniTypes::newton), 3.0);
+  EXPECT_DOUBLE_EQ((2.0 * uniTypes::kilocalorie).convertTo(
+                     uniTypes::parseUnit<uniTypes::Energy>("kJ")), 8.368);
+  EXPECT_THROW(uniTypes::parseUnit<uniTypes::Mass>("kcal/day"), uniTypes::DimensionMismatch);
+}
+
+TEST(unitExpressionTest, CacheTest) {
+  uniTypes::UnitExpressionCache cache(4);
+  EXPECT_EQ(cache.capacity(), 4u);
+  EXPECT_DOUBLE_EQ(cache.get("g/L").getValue(), 1.0);
+  EXPECT_DOUBLE_EQ(cache.get("g/L").getValue(), 1.0);
+  EXPECT_EQ(cache.size(), 1u);
+
+  EXPECT_THROW(cache.get("g/furlong"), std::out_of_range);
+  EXPECT_EQ(cache.size(), 1u);
+
+  // Expressions beyond the capacity are still compiled, just not cached.
+  const char* expressions[] = {"kg/m3", "mg/dL", "lb/ft3", "g/cm3", "mg/ml"};
+  for (const char* expression : expressions) {
+    EXPECT_DOUBLE_EQ(cache.get(expression).getValue(),
+                     uniTypes::compileUnit(expression).getValue());
+  }
+  EXPECT_EQ(cache.size(), 4u);
+}
+
+TEST(unitExpressionTest, ConcurrentCacheTest) {
+  uniTypes::UnitExpressionCache cache(64);
+  const std::vector<std::string> expressions{"kg*m/s^2", "kcal/day", "mg/ml", "mmol/L",
+                                             "km/h",     "J/(kg*K)", "mIU/mL", "lb/in2"};
+  std::vector<int> mismatches(8, 0);
+  std::vector<std::thread> workers;
+  for (std::size_t t = 0; t < mismatches.size(); ++t) {
+    workers.emplace_back([&, t] {
+      for (int round = 0; round < 200; ++round) {
+        for (const std::string& expression : expressions) {
+          const uniTypes::DynQuantity unit = cache.get(expression);
+          const uniTypes::DynQuantity expected = uniTypes::compileUnit(expression);
+          mismatches[t] += unit.getValue() != expected.getValue() ||
+                           unit.getDimension() != expected.getDimension() ? 1 : 0;
+        }
+      }
+    });
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  for (int count : mismatches) {
+    EXPECT_EQ(count, 0);
+  }
+  EXPECT_EQ(cache.size(), expressions.size());
+}
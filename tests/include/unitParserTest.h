@@ -0,0 +1,59 @@
+#include <uniTypes/unitParser.h>
+#include "gtest/gtest.h"
+
+#include <cstddef>
+
+// For using the string literal operators.
+using namespace uniTypes::string_literals;
+
+TEST(unitParserTest, LookupEveryUnitTest) {
+  for (std::size_t i = 0; i < uniTypes::kNumBuiltinUnits; ++i) {
+    const uniTypes::UnitEntry* entry = uniTypes::lookupUnit(uniTypes::builtin_units[i].name);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry, &uniTypes::builtin_units[i]);
+  }
+  EXPECT_EQ(uniTypes::lookupUnit("furlong"), nullptr);
+  EXPECT_EQ(uniTypes::lookupUnit(""), nullptr);
+}
+
+TEST(unitParserTest, CompileTimeLookupTest) {
+  static_assert(uniTypes::lookupUnit("tbsp")->factor == uniTypes::tablespoon.getValue());
+  static_assert(uniTypes::lookupUnit("kcal")->dimension ==
+                uniTypes::dimensionOf<uniTypes::Energy>());
+  static_assert(uniTypes::lookupUnit("MN")->factor != uniTypes::lookupUnit("mN")->factor);
+}
+
+TEST(unitParserTest, ParseQuantityTest) {
+  uniTypes::ParseResult result = uniTypes::parseQuantity("12.5 lb");
+  ASSERT_TRUE(result);
+  EXPECT_FLOAT_EQ(result.quantity.as<uniTypes::Mass>().convertTo(uniTypes::pound), 12.5);
+
+  result = uniTypes::parseQuantity("  3tbsp ");
+  ASSERT_TRUE(result);
+  EXPECT_FLOAT_EQ(result.quantity.convertTo(uniTypes::teaspoon), 9.0);
+
+  result = uniTypes::parseQuantity("1.5 fluid ounces");
+  ASSERT_TRUE(result);
+  EXPECT_FLOAT_EQ(result.quantity.convertTo(uniTypes::floz), 1.5);
+
+  result = uniTypes::parseQuantity("-2e3 kJ");
+  ASSERT_TRUE(result);
+  EXPECT_FLOAT_EQ(result.quantity.convertTo(uniTypes::joule), -2e6);
+}
+
+TEST(unitParserTest, ParseAllDimensionsTest) {
+  EXPECT_TRUE(uniTypes::parseQuantity("400 IU").quantity.is<uniTypes::UOBA>());
+  EXPECT_TRUE(uniTypes::parseQuantity("2 ft2").quantity.is<uniTypes::Area>());
+  EXPECT_TRUE(uniTypes::parseQuantity("90 min").quantity.is<uniTypes::Time>());
+  EXPECT_TRUE(uniTypes::parseQuantity("5 lbf").quantity.is<uniTypes::Force>());
+  EXPECT_TRUE(uniTypes::parseQuantity("100 BTU").quantity.is<uniTypes::Energy>());
+}
+
+TEST(unitParserTest, ParseErrorTest) {
+  EXPECT_EQ(uniTypes::parseQuantity("").error, uniTypes::ParseError::EmptyInput);
+  EXPECT_EQ(uniTypes::parseQuantity("lb").error, uniTypes::ParseError::InvalidNumber);
+  EXPECT_EQ(uniTypes::parseQuantity("12.5").error, uniTypes::ParseError::MissingUnit);
+  EXPECT_EQ(uniTypes::parseQuantity("12.5 parsecs").error, uniTypes::ParseError::UnknownUnit);
+  EXPECT_EQ(uniTypes::parseQuantity("12.5 lb", uniTypes::dimensionOf<uniTypes::Volume>()).error,
+            uniTypes::ParseError::WrongDimension);
+}
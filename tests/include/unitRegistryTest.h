@@ -0,0 +1,142 @@
+#include <uniTypes/conversionPlan.h>
+#include <uniTypes/unitExpression.h>
+#include <uniTypes/unitParser.h>
+#include <uniTypes/unitRegistry.h>
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// For using the string literal operators.
+using namespace uniTypes::string_literals;
+
+namespace {
+  // Distinct unit names made of letters only, "zza", "zzb", ..., "zzba", ...
+  std::string registryTestName(std::size_t i) {
+    std::string name;
+    do {
+      name.insert(name.begin(), static_cast<char>('a' + i % 26));
+      i /= 26;
+    } while (i != 0);
+    return "zz" + name;
+  }
+}
+
+TEST(unitRegistryTest, DefineTest) {
+  uniTypes::UnitRegistry registry;
+  EXPECT_EQ(registry.find("scoop"), nullptr);
+  const uniTypes::UnitEntry& scoop = registry.define("scoop", 30_g);
+  EXPECT_EQ(scoop.name, "scoop");
+  EXPECT_DOUBLE_EQ(scoop.factor, 0.03);
+  EXPECT_TRUE(scoop.dimension == uniTypes::dimensionOf<uniTypes::Mass>());
+  EXPECT_EQ(registry.find("scoop"), &scoop);
+  EXPECT_EQ(registry.size(), 1u);
+
+  // Built-in units come from the static table.
+  EXPECT_EQ(registry.find("tbsp"), uniTypes::lookupUnit("tbsp"));
+  EXPECT_THROW(registry.define("tbsp", 15_g), std::invalid_argument);
+  // So are the SI-prefixed forms that unit expressions already read, whatever the dimension.
+  for (const char* prefixed : {"dN", "dam", "nmol", "cJ", "Ts", "cs", "mIU"}) {
+    EXPECT_THROW(registry.define(prefixed, 5_g), std::invalid_argument) << prefixed;
+  }
+  registry.define("dash", 0.6_ml);
+
+  // Defining the same unit again is allowed; changing it is not.
+  EXPECT_EQ(&registry.define("scoop", 30_g), &scoop);
+  EXPECT_THROW(registry.define("scoop", 31_g), std::invalid_argument);
+  EXPECT_THROW(registry.define("scoop", 30_ml), std::invalid_argument);
+
+  EXPECT_THROW(registry.define("", 1_g), std::invalid_argument);
+  EXPECT_THROW(registry.define("2pack", 1_g), std::invalid_argument);
+  EXPECT_THROW(registry.define("pack/box", 1_g), std::invalid_argument);
+  EXPECT_THROW(registry.define("-pack", 1_g), std::invalid_argument);
+  EXPECT_THROW(registry.define("pack", 0_g), std::invalid_argument);
+  EXPECT_THROW(registry.define("pack", uniTypes::DynQuantity(-1.0, uniTypes::Dimension())),
+               std::invalid_argument);
+  registry.define("six-pack", 6 * 330_ml);
+  registry.define("serving", uniTypes::compileUnit("kcal") * 250.0);
+  EXPECT_EQ(registry.size(), 4u);
+
+  // The table grows past its first size and keeps every entry.
+  for (std::size_t i = 0; i < 1000; ++i) {
+    registry.define(registryTestName(i), uniTypes::DynQuantity(i + 1.0, uniTypes::Dimension()));
+  }
+  EXPECT_EQ(registry.size(), 1004u);
+  for (std::size_t i = 0; i < 1000; ++i) {
+    const uniTypes::UnitEntry* entry = registry.find(registryTestName(i));
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->factor, i + 1.0);
+  }
+  EXPECT_EQ(registry.find("scoop"), &scoop);
+}
+
+TEST(unitRegistryTest, SharedRegistryTest) {
+  uniTypes::sharedUnitRegistry().define("testscoop", 30_g);
+  uniTypes::sharedUnitRegistry().define("testpack", 6 * 330_ml);
+
+  const uniTypes::ParseResult parsed = uniTypes::parseQuantity("2 testscoop");
+  ASSERT_TRUE(parsed);
+  EXPECT_DOUBLE_EQ(parsed.quantity.getValue(), 0.06);
+  EXPECT_EQ(uniTypes::parseQuantity("2 testscoops").error, uniTypes::ParseError::UnknownUnit);
+
+  EXPECT_DOUBLE_EQ(uniTypes::compileUnit("testscoop/day").getValue(), 0.03 / 86400.0);
+  EXPECT_DOUBLE_EQ(uniTypes::parseUnit<uniTypes::Volume>("testpack").convertTo(uniTypes::liter),
+                   1.98);
+  EXPECT_DOUBLE_EQ(uniTypes::ConversionPlan::compile("testscoop", "g")(2.0), 60.0);
+  EXPECT_THROW(uniTypes::ConversionPlan::compile("testscoop", "testpack"),
+               uniTypes::DimensionMismatch);
+}
+
+TEST(unitRegistryTest, ConcurrentStressTest) {
+  uniTypes::UnitRegistry registry;
+  constexpr std::size_t kWriters = 2;
+  constexpr std::size_t kPerWriter = 2000;
+  std::atomic<std::size_t> writers_done(0);
+  std::vector<int> errors(kWriters + 4, 0);
+  std::vector<std::thread> threads;
+
+  // Writers define disjoint names, and both redefine a shared set the same way.
+  for (std::size_t w = 0; w < kWriters; ++w) {
+    threads.emplace_back([&, w] {
+      for (std::size_t i = 0; i < kPerWriter; ++i) {
+        const std::size_t id = w * kPerWriter + i;
+        registry.define(registryTestName(id),
+                        uniTypes::DynQuantity(id + 1.0, uniTypes::Dimension(1, 0, 0)));
+        const uniTypes::UnitEntry& shared = registry.define(
+          registryTestName(kWriters * kPerWriter + i % 50), uniTypes::DynQuantity(0.5, {}));
+        errors[w] += shared.factor != 0.5 ? 1 : 0;
+      }
+      writers_done.fetch_add(1);
+    });
+  }
+  // Readers check that whatever they find is complete and correct, until the writers finish.
+  for (std::size_t r = 0; r < 4; ++r) {
+    threads.emplace_back([&, r] {
+      std::size_t i = r;
+      while (writers_done.load() < kWriters) {
+        const std::size_t id = i++ % (kWriters * kPerWriter);
+        const uniTypes::UnitEntry* entry = registry.find(registryTestName(id));
+        if (entry != nullptr && (entry->factor != id + 1.0 ||
+                                 entry->dimension != uniTypes::Dimension(1, 0, 0) ||
+                                 entry->name != registryTestName(id))) {
+          ++errors[kWriters + r];
+        }
+        errors[kWriters + r] += registry.find("kg") == nullptr ? 1 : 0;
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  for (int count : errors) {
+    EXPECT_EQ(count, 0);
+  }
+  EXPECT_EQ(registry.size(), kWriters * kPerWriter + 50);
+  for (std::size_t id = 0; id < kWriters * kPerWriter; ++id) {
+    ASSERT_NE(registry.find(registryTestName(id)), nullptr);
+  }
+}
@@ -0,0 +1,98 @@
+#include <uniTypes/vec3.h>
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <type_traits>
+
+// For using the string literal operators.
+using namespace uniTypes::string_literals;
+
+TEST(vec3Test, VectorAlgebraTest) {
+  using Torque = uniTypes::quantity_product_t<uniTypes::Length, uniTypes::Force>;
+
+  constexpr uniTypes::Vec3<uniTypes::Force> force(3_N, 0_N, 4_N);
+  constexpr uniTypes::Vec3<uniTypes::Length> displacement(2_m, 5_m, 0.5_m);
+
+  constexpr uniTypes::Energy work = uniTypes::dot(force, displacement);
+  static_assert(work.getValue() == 8.0);
+  static_assert(std::is_same<decltype(uniTypes::cross(displacement, force)),
+                             uniTypes::Vec3<Torque>>::value);
+
+  const uniTypes::Vec3<Torque> torque = uniTypes::cross(displacement, force);
+  EXPECT_DOUBLE_EQ(torque.x().getValue(), 20.0);
+  EXPECT_DOUBLE_EQ(torque.y().getValue(), -6.5);
+  EXPECT_DOUBLE_EQ(torque.z().getValue(), -15.0);
+  // The torque is perpendicular to both arms.
+  EXPECT_DOUBLE_EQ(uniTypes::dot(torque, force).getValue(), 0.0);
+
+  EXPECT_DOUBLE_EQ(uniTypes::norm(force).convertTo(uniTypes::newton), 5.0);
+  EXPECT_TRUE(2 * force - force == force);
+  EXPECT_TRUE(-force + force == uniTypes::Vec3<uniTypes::Force>());
+  const uniTypes::Vec3<uniTypes::Energy> scaled = 2_m * force;
+  EXPECT_DOUBLE_EQ(scaled.z().convertTo(uniTypes::joule), 8.0);
+  EXPECT_DOUBLE_EQ((displacement / 2.0).y().getValue(), 2.5);
+}
+
+TEST(vec3Test, MatrixTest) {
+  using Inertia = uniTypes::quantity_product_t<uniTypes::Mass, uniTypes::Area>;
+  using AngularVelocity = uniTypes::quantity_quotient_t<uniTypes::Number, uniTypes::Time>;
+
+  // Quarter turn about z.
+  constexpr uniTypes::Mat3<> rotation(uniTypes::Vec3<uniTypes::Number>(0.0, -1.0, 0.0),
+                                      uniTypes::Vec3<uniTypes::Number>(1.0, 0.0, 0.0),
+                                      uniTypes::Vec3<uniTypes::Number>(0.0, 0.0, 1.0));
+  const uniTypes::Vec3<uniTypes::Length> rotated =
+    rotation * uniTypes::Vec3<uniTypes::Length>(1_m, 2_m, 3_m);
+  EXPECT_TRUE(rotated == uniTypes::Vec3<uniTypes::Length>(-2.0 * 1_m, 1_m, 3_m));
+
+  const uniTypes::Mat3<> half_turn = rotation * rotation;
+  EXPECT_DOUBLE_EQ(half_turn(0, 0).getValue(), -1.0);
+  EXPECT_DOUBLE_EQ(half_turn(1, 1).getValue(), -1.0);
+  EXPECT_DOUBLE_EQ(half_turn(2, 2).getValue(), 1.0);
+  EXPECT_DOUBLE_EQ((rotation * rotation.transposed())(0, 1).getValue(), 0.0);
+
+  // Inertia tensor times angular velocity is angular momentum, in kg*m^2/s.
+  const auto inertia = uniTypes::Mat3<Inertia>::diagonal(Inertia(2.0));
+  const auto momentum = inertia * uniTypes::Vec3<AngularVelocity>(AngularVelocity(1.0),
+                                                                  AngularVelocity(0.0),
+                                                                  AngularVelocity(3.0));
+  static_assert(std::is_same<decltype(momentum)::quantity_type,
+                             uniTypes::quantity_quotient_t<Inertia, uniTypes::Time>>::value);
+  EXPECT_DOUBLE_EQ(momentum.z().getValue(), 6.0);
+}
+
+TEST(vec3Test, ArrayKernelTest) {
+  const std::size_t n = 3 * uniTypes::kVec3Grain + 5;
+  uniTypes::Vec3Array<uniTypes::Force> forces(n);
+  uniTypes::Vec3Array<uniTypes::Length> arms(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    const double t = static_cast<double>(i);
+    forces.set(i, uniTypes::Vec3<uniTypes::Force>(t * 1_N, 1_N, -t * 1_N));
+    arms.set(i, uniTypes::Vec3<uniTypes::Length>(1_m, t * 1_m, 2_m));
+  }
+
+  uniTypes::QuantityVector<uniTypes::Energy> work(n);
+  uniTypes::dot(forces, arms, work, 0);
+  uniTypes::Vec3Array<uniTypes::quantity_product_t<uniTypes::Length, uniTypes::Force>> torques(n);
+  uniTypes::cross(arms, forces, torques, 0);
+  uniTypes::QuantityVector<uniTypes::Force> magnitudes(n);
+  uniTypes::norm(forces, magnitudes);
+
+  const uniTypes::Mat3<> swap_xy(uniTypes::Vec3<uniTypes::Number>(0.0, 1.0, 0.0),
+                                 uniTypes::Vec3<uniTypes::Number>(1.0, 0.0, 0.0),
+                                 uniTypes::Vec3<uniTypes::Number>(0.0, 0.0, 1.0));
+  uniTypes::transform(swap_xy, arms, arms, 0);
+
+  for (std::size_t i : {std::size_t(0), std::size_t(7), n - 1}) {
+    const double t = static_cast<double>(i);
+    const uniTypes::Vec3<uniTypes::Length> arm(1_m, t * 1_m, 2_m);
+    EXPECT_DOUBLE_EQ(work[i].getValue(), uniTypes::dot(forces[i], arm).getValue());
+    EXPECT_TRUE(torques[i] == uniTypes::cross(arm, forces[i]));
+    EXPECT_DOUBLE_EQ(magnitudes[i].getValue(), uniTypes::norm(forces[i]).getValue());
+    // Transformed in place.
+    EXPECT_TRUE(arms[i] == swap_xy * arm);
+  }
+
+  uniTypes::QuantityVector<uniTypes::Energy> short_out(n - 1);
+  EXPECT_THROW(uniTypes::dot(forces, arms, short_out), std::invalid_argument);
+}
@@ -0,0 +1,145 @@
+#include <uniTypes/wireFormat.h>
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+// For using the string literal operators.
+using namespace uniTypes::string_literals;
+
+using FloatMass = uniTypes::with_rep_t<uniTypes::Mass, float>;
+
+namespace {
+  std::string wireTestPath(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+  }
+}
+
+TEST(wireFormatTest, HeaderLayoutTest) {
+  uniTypes::QuantityVector<uniTypes::Energy> energy{1.0_kJ, 2.0_kJ};
+  std::ostringstream out;
+  uniTypes::writeQuantities(out, energy);
+  const std::string batch = out.str();
+
+  ASSERT_EQ(batch.size(), uniTypes::kWireHeaderSize + 2 * sizeof(double));
+  EXPECT_EQ(batch.substr(0, 4), "UTQB");
+  EXPECT_EQ(batch[4], 2);
+  EXPECT_EQ(batch[6], static_cast<char>(uniTypes::WireRep::Float64));
+  // kg * m^2 * s^-2, in sixths.
+  EXPECT_EQ(batch[8], 6);
+  EXPECT_EQ(batch[9], 12);
+  EXPECT_EQ(batch[10], -12);
+
+  const uniTypes::WireHeader header = uniTypes::decodeWireHeader(batch.data(), batch.size());
+  EXPECT_EQ(header.count, 2u);
+  EXPECT_EQ(header.scale, 1.0);
+  EXPECT_TRUE(header.dimension() == uniTypes::dimensionOf<uniTypes::Energy>());
+
+  EXPECT_THROW(uniTypes::decodeWireHeader(batch.data(), batch.size() - 1), std::invalid_argument);
+  std::string corrupt = batch;
+  corrupt[0] = 'X';
+  EXPECT_THROW(uniTypes::decodeWireHeader(corrupt.data(), corrupt.size()), std::invalid_argument);
+  corrupt = batch;
+  corrupt[7] = 3;
+  EXPECT_THROW(uniTypes::decodeWireHeader(corrupt.data(), corrupt.size()), std::invalid_argument);
+
+  // The last exponent slot holds International Units.
+  std::ostringstream activity_out;
+  uniTypes::writeQuantities(activity_out, uniTypes::QuantityVector<uniTypes::UOBA>{400_IU});
+  const std::string activity = activity_out.str();
+  EXPECT_EQ(activity[15], 6);
+  EXPECT_TRUE(uniTypes::decodeWireHeader(activity.data(), activity.size()).dimension() ==
+              uniTypes::dimensionOf<uniTypes::UOBA>());
+
+  // Version 1 batches are still read; versions from the future are not.
+  corrupt = batch;
+  corrupt[4] = 1;
+  EXPECT_EQ(uniTypes::decodeWireHeader(corrupt.data(), corrupt.size()).version, 1u);
+  corrupt[4] = 3;
+  EXPECT_THROW(uniTypes::decodeWireHeader(corrupt.data(), corrupt.size()), std::invalid_argument);
+}
+
+TEST(wireFormatTest, FileRoundTripTest) {
+  const std::string path = wireTestPath("uniTypes_wireFormatTest.utqb");
+  uniTypes::QuantityVector<uniTypes::Mass> masses;
+  for (int i = 0; i < 10000; ++i) {
+    masses.push_back(uniTypes::Mass(0.001 * i));
+  }
+  uniTypes::writeQuantityFile(path, masses);
+
+  {
+    uniTypes::QuantityFile file(path);
+    EXPECT_EQ(file.size(), masses.size());
+    EXPECT_TRUE(file.dimension() == uniTypes::dimensionOf<uniTypes::Mass>());
+
+    // Viewed in place: every bit of every value survives.
+    auto view = file.as<uniTypes::Mass>();
+    ASSERT_EQ(view.size(), masses.size());
+    for (std::size_t i = 0; i < view.size(); ++i) {
+      ASSERT_EQ(view[i].getValue(), masses[i].getValue());
+    }
+    EXPECT_THROW(file.as<uniTypes::Length>(), uniTypes::DimensionMismatch);
+    EXPECT_THROW(file.read<uniTypes::Length>(), uniTypes::DimensionMismatch);
+    EXPECT_THROW(file.as<FloatMass>(), std::invalid_argument);
+
+    auto floats = file.read<FloatMass>();
+    EXPECT_FLOAT_EQ(floats[1234].getValue(), 1.234f);
+  }
+  std::filesystem::remove(path);
+
+  EXPECT_THROW(uniTypes::QuantityFile(wireTestPath("uniTypes_wireFormatTest.missing")),
+               std::system_error);
+}
+
+TEST(wireFormatTest, StoredUnitTest) {
+  using WholeKilograms = uniTypes::with_rep_t<uniTypes::Mass, std::int64_t>;
+  const std::string path = wireTestPath("uniTypes_wireFormatUnitTest.utqb");
+  uniTypes::QuantityVector<FloatMass> masses{1.5_kg, 250.0_g};
+  uniTypes::writeQuantityFile(path, masses, uniTypes::gram);
+
+  {
+    uniTypes::QuantityFile file(path);
+    EXPECT_EQ(file.header().rep, uniTypes::WireRep::Float32);
+    EXPECT_DOUBLE_EQ(file.header().scale, 0.001);
+    // Values in grams are not SI values, so they cannot be viewed as Mass in place.
+    EXPECT_THROW(file.as<FloatMass>(), std::invalid_argument);
+
+    auto read = file.read<uniTypes::Mass>();
+    EXPECT_FLOAT_EQ(read[0].convertTo(uniTypes::kilogram), 1.5);
+    EXPECT_FLOAT_EQ(read[1].convertTo(uniTypes::gram), 250.0);
+  }
+  std::filesystem::remove(path);
+
+  // Integer values in SI units are read back exactly.
+  const std::int64_t big = std::int64_t(1) << 60;
+  uniTypes::QuantityVector<WholeKilograms> exact{WholeKilograms(big), WholeKilograms(-3)};
+  std::ostringstream out;
+  uniTypes::writeQuantities(out, exact);
+  const std::string batch = out.str();
+  auto back = uniTypes::readQuantities<WholeKilograms>(batch.data(), batch.size());
+  EXPECT_EQ(back[0].getValue(), big);
+  EXPECT_EQ(back[1].getValue(), -3);
+
+  // Floating-point values must be finite and in range to be read as integers.
+  const std::int64_t top = std::numeric_limits<std::int64_t>::max();
+  for (const double stored : {std::nan(""), std::numeric_limits<double>::infinity(), 1e19,
+                              static_cast<double>(top)}) {
+    std::ostringstream float_out;
+    uniTypes::writeQuantities(float_out, uniTypes::QuantityVector<uniTypes::Mass>{2.0, stored});
+    const std::string floats = float_out.str();
+    EXPECT_THROW(uniTypes::readQuantities<WholeKilograms>(floats.data(), floats.size()),
+                 std::invalid_argument) << stored;
+  }
+  std::ostringstream fit_out;
+  uniTypes::writeQuantities(fit_out, uniTypes::QuantityVector<uniTypes::Mass>{-9.2e18, 2.9});
+  const std::string fits = fit_out.str();
+  auto truncated = uniTypes::readQuantities<WholeKilograms>(fits.data(), fits.size());
+  EXPECT_EQ(truncated[0].getValue(), std::int64_t(-9200000000000000000));
+  EXPECT_EQ(truncated[1].getValue(), 2);
+}
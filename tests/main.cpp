@@ -1,6 +1,27 @@
 #include "gtest/gtest.h"
 
 #include <uniTypesTest.h>
+#include <quantityVectorTest.h>
+#include <convertTest.h>
+#include <dynQuantityTest.h>
+#include <unitParserTest.h>
+#include <ingestTest.h>
+#include <formatTest.h>
+#include <expressionTest.h>
+#include <reduceTest.h>
+#include <scaledQuantityTest.h>
+#include <repTest.h>
+#include <wireFormatTest.h>
+#include <conversionPlanTest.h>
+#include <atomicQuantityTest.h>
+#include <dimsTest.h>
+#include <instrumentTest.h>
+#include <vec3Test.h>
+#include <unitExpressionTest.h>
+#include <quantileSketchTest.h>
+#include <timeSeriesTest.h>
+#include <unitRegistryTest.h>
+#include <densityTest.h>
 
 // Include all of the test files we want to run.
 